@@ -0,0 +1,158 @@
+#include "AxialMarching.h"
+#include <cmath>
+#include <stdexcept>
+/*!
+ * \brief constructor
+ * \param data input data of the whole pipe, the mean temperature of liquid is the inlet temperature
+ * \param liquid properties of liquid, they have to outlive the object
+ * \param air properties of air, they have to outlive the object
+ * \throw std::invalid_argument if the velocity of liquid or the length of pipe is not positive
+ */
+AxialMarching::AxialMarching(const InputData &data, const ThermalProperties &liquid, const ThermalProperties &air):
+	segmentData{getDataPerMeter(data)},liquid{&liquid},inletTemperature{data.meanTemperatureOfLiquid},
+	lengthOfPipe{data.lengthOfPipe},solver{segmentData, liquid, air}
+{
+	if (!(data.meanVelocityOfLiquid > 0) || !(data.lengthOfPipe > 0)) {
+		throw std::invalid_argument("Velocity of liquid and length of pipe have to be positive.");
+	}
+}
+/*!
+ * \brief copies the input data and sets the length of one meter
+ * \param data input data of the whole pipe
+ * \return input data of one meter of pipe
+ */
+InputData AxialMarching::getDataPerMeter(const InputData &data)
+{
+	InputData dataPerMeter{data};
+	dataPerMeter.lengthOfPipe = 1;
+	return dataPerMeter;
+}
+/*!
+ * \brief marches along the pipe
+ * \param quantityOfSegments quantity of segments of pipe
+ * \param tolerance value of tolerance used by solver
+ * \return temperatures along the pipe and the total heat flow
+ */
+AxialProfile AxialMarching::march(const size_t &quantityOfSegments, const double &tolerance)
+{
+	AxialProfile profile;
+	march(quantityOfSegments, profile, tolerance);
+	return profile;
+}
+/*!
+ * \brief marches along the pipe
+ * \param quantityOfSegments quantity of segments of pipe
+ * \param profile temperatures along the pipe and the total heat flow, the vectors are reused
+ * \param tolerance value of tolerance used by solver
+ * \throw std::invalid_argument if quantity of segments is 0
+ */
+void AxialMarching::march(const size_t &quantityOfSegments, AxialProfile &profile, const double &tolerance)
+{
+	if (quantityOfSegments == 0) {
+		throw std::invalid_argument("Quantity of segments has to be positive.");
+	}
+	profile.temperatureOfLiquid.resize(quantityOfSegments + 1);
+	profile.temperatureOnIsolator.resize(quantityOfSegments);
+	const double lengthOfSegment = lengthOfPipe / quantityOfSegments;
+	double temperatureOfLiquid = inletTemperature;
+	double temperatureOnIsolator = 0.5*(inletTemperature + segmentData.temperatureOfEnvironment);
+	profile.totalHeatFlow = 0;
+	for (size_t i = 0; i < quantityOfSegments; ++i) {
+		profile.temperatureOfLiquid[i] = temperatureOfLiquid;
+		profile.totalHeatFlow += marchSegment(temperatureOfLiquid, temperatureOnIsolator, lengthOfSegment, tolerance);
+		profile.temperatureOnIsolator[i] = temperatureOnIsolator;
+	}
+	profile.temperatureOfLiquid[quantityOfSegments] = temperatureOfLiquid;
+	profile.outletTemperatureOfLiquid = temperatureOfLiquid;
+}
+/*!
+ * \brief marches along the pipe without storing the profile
+ * \param inletTemperature temperature of liquid at the inlet of pipe
+ * \param quantityOfSegments quantity of segments of pipe
+ * \param tolerance value of tolerance used by solver
+ * \throw std::invalid_argument if quantity of segments is 0
+ * \return temperature of liquid at the outlet of pipe
+ */
+double AxialMarching::getOutletTemperature(const double &inletTemperature, const size_t &quantityOfSegments,
+	const double &tolerance)
+{
+	double totalHeatFlow = 0;
+	return getOutletTemperature(inletTemperature, quantityOfSegments, totalHeatFlow, tolerance);
+}
+/*!
+ * \brief marches along the pipe without storing the profile
+ * \param inletTemperature temperature of liquid at the inlet of pipe
+ * \param quantityOfSegments quantity of segments of pipe
+ * \param totalHeatFlow it is set to the heat flow lost by the whole pipe [W]
+ * \param tolerance value of tolerance used by solver
+ * \throw std::invalid_argument if quantity of segments is 0
+ * \return temperature of liquid at the outlet of pipe
+ */
+double AxialMarching::getOutletTemperature(const double &inletTemperature, const size_t &quantityOfSegments,
+	double &totalHeatFlow, const double &tolerance)
+{
+	if (quantityOfSegments == 0) {
+		throw std::invalid_argument("Quantity of segments has to be positive.");
+	}
+	const double lengthOfSegment = lengthOfPipe / quantityOfSegments;
+	double temperatureOfLiquid = inletTemperature;
+	double temperatureOnIsolator = 0.5*(inletTemperature + segmentData.temperatureOfEnvironment);
+	totalHeatFlow = 0;
+	for (size_t i = 0; i < quantityOfSegments; ++i) {
+		totalHeatFlow += marchSegment(temperatureOfLiquid, temperatureOnIsolator, lengthOfSegment, tolerance);
+	}
+	return temperatureOfLiquid;
+}
+/*!
+ * \brief
+ * marches through one segment, in the segment the heat loss coefficient is constant,
+ * so the temperature of liquid decreases exponentially to the temperature of environment
+ * \param temperatureOfLiquid temperature at the begin of segment, it is set to the temperature at the end
+ * \param temperatureOnIsolator initial value of temperature on isolator, it is set to the solution
+ * \param lengthOfSegment length of segment
+ * \param tolerance value of tolerance used by solver
+ * \return heat flow lost by the segment [W]
+ */
+double AxialMarching::marchSegment(double &temperatureOfLiquid, double &temperatureOnIsolator,
+	const double &lengthOfSegment, const double &tolerance)
+{
+	double difference = temperatureOfLiquid - segmentData.temperatureOfEnvironment;
+	double heatFlow = getHeatFlowPerMeter(temperatureOfLiquid, temperatureOnIsolator, tolerance);
+	if (difference == 0) {
+		return 0;
+	}
+	double heatCapacityFlow = getHeatCapacityFlow(temperatureOfLiquid);
+	double exponent = -(heatFlow / difference) * lengthOfSegment / heatCapacityFlow;
+	double newDifference = difference * exp(exponent);
+	temperatureOfLiquid = segmentData.temperatureOfEnvironment + newDifference;
+	return heatCapacityFlow * (difference - newDifference);
+}
+/*!
+ * \brief calculates the heat capacity flow of liquid (mass flow multiplied by specific heat)
+ * \param temperatureOfLiquid temperature of liquid
+ * \return value of heat capacity flow [W/K]
+ */
+double AxialMarching::getHeatCapacityFlow(const double &temperatureOfLiquid) const
+{
+	double conductivity = liquid->valueAt(temperatureOfLiquid, PropertyType::conductivity);
+	double viscosity = liquid->valueAt(temperatureOfLiquid, PropertyType::viscosity);
+	double prandtl = liquid->valueAt(temperatureOfLiquid, PropertyType::prandtl);
+	double heatCapacityPerVolume = prandtl * conductivity / viscosity;
+	double areaOfFlow = 0.25*segmentData.PI*segmentData.innerDiameterOfPipe*segmentData.innerDiameterOfPipe;
+	return heatCapacityPerVolume * segmentData.meanVelocityOfLiquid*areaOfFlow;
+}
+/*!
+ * \brief solves the heat transfer problem of one meter of pipe
+ * \param temperatureOfLiquid local temperature of liquid
+ * \param temperatureOnIsolator initial value of temperature on isolator, it is set to the solution
+ * \param tolerance value of tolerance used by solver
+ * \return heat flow lost by one meter of pipe [W/m]
+ */
+double AxialMarching::getHeatFlowPerMeter(const double &temperatureOfLiquid, double &temperatureOnIsolator,
+	const double &tolerance)
+{
+	segmentData.meanTemperatureOfLiquid = temperatureOfLiquid;
+	solver.calculateInitialValues();
+	temperatureOnIsolator = solver.findTemperatureOnIsolator(temperatureOnIsolator, tolerance);
+	return solver.getHeatFlow1(temperatureOnIsolator);
+}
@@ -0,0 +1,78 @@
+#pragma once
+#include "InputData.h"
+#include "ThermalProperties.h"
+#include "HeatTransferSolver.h"
+#include <vector>
+/*!
+ * \brief The AxialProfile class
+ * stores the results of axial marching along the pipe
+ */
+class AxialProfile
+{
+public:
+    /*!
+     * \brief temperature of liquid at the begin of every segment and at the outlet [K]
+     */
+	std::vector<double> temperatureOfLiquid;
+    /*!
+     * \brief temperature on isolator of every segment [K]
+     */
+	std::vector<double> temperatureOnIsolator;
+    /*!
+     * \brief temperature of liquid at the outlet of pipe [K]
+     */
+	double outletTemperatureOfLiquid{ 0 };
+    /*!
+     * \brief heat flow lost by the whole pipe [W]
+     */
+	double totalHeatFlow{ 0 };
+};
+/*!
+ * \brief The AxialMarching class
+ * solves the long pipe in which the liquid cools along the flow,
+ * the pipe is split into segments, in every segment the heat transfer problem is solved
+ * for the local temperature of liquid (per meter of pipe) and the energy balance
+ * of liquid gives the temperature at the begin of next segment,
+ * the temperature on isolator of segment is the initial value for the next one.
+ * The heat capacity of liquid is taken from the properties table: rho*cp = Pr*lambda/nu
+ * \author Łukasz Dyraga
+ * \version 1.0
+ */
+class AxialMarching
+{
+public:
+	AxialMarching(const InputData &data, const ThermalProperties &liquid, const ThermalProperties &air);
+	AxialProfile march(const size_t &quantityOfSegments, const double &tolerance = 0.001);
+	void march(const size_t &quantityOfSegments, AxialProfile &profile, const double &tolerance = 0.001);
+	double getOutletTemperature(const double &inletTemperature, const size_t &quantityOfSegments,
+		const double &tolerance = 0.001);
+	double getOutletTemperature(const double &inletTemperature, const size_t &quantityOfSegments,
+		double &totalHeatFlow, const double &tolerance = 0.001);
+	double getHeatCapacityFlow(const double &temperatureOfLiquid) const;
+	double getHeatFlowPerMeter(const double &temperatureOfLiquid, double &temperatureOnIsolator,
+		const double &tolerance = 0.001);
+private:
+	double marchSegment(double &temperatureOfLiquid, double &temperatureOnIsolator,
+		const double &lengthOfSegment, const double &tolerance);
+	static InputData getDataPerMeter(const InputData &data);
+    /*!
+     * \brief input data of one meter of pipe, the temperature of liquid is changed for every segment
+     */
+	InputData segmentData;
+    /*!
+     * \brief properties of liquid which flows through pipe
+     */
+	const ThermalProperties *liquid;
+    /*!
+     * \brief temperature of liquid at the inlet of pipe
+     */
+	double inletTemperature;
+    /*!
+     * \brief length of the whole pipe
+     */
+	double lengthOfPipe;
+    /*!
+     * \brief solver used for every segment
+     */
+	HeatTransferSolver solver;
+};
@@ -0,0 +1,246 @@
+#include "BatchPipeline.h"
+#include "ScratchArena.h"
+#include "TraceRecorder.h"
+#include <algorithm>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+/*!
+ * \brief adds the chunk at the end of queue
+ * \param chunk chunk
+ */
+void ChunkQueue::push(BatchChunk *chunk)
+{
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		chunks.push_back(chunk);
+	}
+	isChanged.notify_one();
+}
+/*!
+ * \brief takes the first chunk of queue, waits if the queue is empty
+ * \param chunk taken chunk
+ * \return false if the queue is closed and empty
+ */
+bool ChunkQueue::pop(BatchChunk *&chunk)
+{
+	std::unique_lock<std::mutex> guard(lock);
+	isChanged.wait(guard, [this]() { return !chunks.empty() || isClosed; });
+	if (chunks.empty()) {
+		return false;
+	}
+	chunk = chunks.front();
+	chunks.pop_front();
+	return true;
+}
+/*!
+ * \brief closes the queue, the waiting threads take the remaining chunks and finish
+ */
+void ChunkQueue::close()
+{
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		isClosed = true;
+	}
+	isChanged.notify_all();
+}
+/*!
+ * \brief constructor
+ * \param runner runner which parses and solves the cases, its quantity of threads is used
+ */
+BatchPipeline::BatchPipeline(const BatchRunner &runner):
+	runner{&runner}
+{
+}
+/*!
+ * \brief
+ * reads the cases, solves them and writes their results (see BatchRunner::saveResultsAsCsv and saveResultsAsBinary),
+ * after the error of input the results of previous chunks are already written
+ * \param input stream with cases, one case in line (see BatchRunner::loadCases)
+ * \param output stream for results, it has to be seekable for binary format because the quantity of cases
+ * in header is written at the end
+ * \param isBinaryFormat true if results are saved in binary format otherwise as csv
+ * \param statistics if not null the counters and timers of all solves are set (HEAT_INSTRUMENTATION only)
+ * \throw std::invalid_argument if line is corrupted, the message contains the number of line,
+ * or the output of binary format is not seekable, the errors of solving and writing threads are rethrown
+ * \return summary of status of results
+ */
+BatchStatusSummary BatchPipeline::run(std::istream &input, std::ostream &output, const bool &isBinaryFormat,
+	SolverStatistics *statistics)
+{
+	HEAT_TRACE_SCOPE("pipeline", "batch");
+	const std::streampos beginning = output.tellp();
+	if (isBinaryFormat && beginning == std::streampos(-1)) {
+		throw std::invalid_argument("binary results need the output which can be rewound");
+	}
+	const size_t quantityOfThreads = std::max(runner->getOptions().quantityOfThreads, 1u);
+	const size_t quantityOfChunks = maximumQuantityOfChunks > 0 ? maximumQuantityOfChunks : 2 * quantityOfThreads + 2;
+	const size_t sizeOfChunk = std::max<size_t>(quantityOfCasesInChunk, 1);
+	std::vector<std::unique_ptr<BatchChunk>> chunks;
+	ChunkQueue freeChunks;
+	ChunkQueue parsedChunks;
+	ChunkQueue solvedChunks;
+	for (size_t i = 0; i < quantityOfChunks; ++i) {
+		chunks.emplace_back(new BatchChunk{});
+		freeChunks.push(chunks.back().get());
+	}
+	if (isBinaryFormat) {
+		BatchRunner::writeBinaryHeader(output, 0);
+	}
+	else {
+		BatchRunner::writeCsvHeader(output);
+	}
+	BatchStatusSummary summary{};
+	std::vector<SolverStatistics> statisticsOfThreads(quantityOfThreads);
+	std::vector<std::exception_ptr> errorsOfThreads(quantityOfThreads + 1);//the last one is the error of writer
+	std::thread writer{ &BatchPipeline::writeChunks, this, std::ref(solvedChunks), std::ref(freeChunks), quantityOfChunks,
+		std::ref(output), isBinaryFormat, std::ref(summary), std::ref(errorsOfThreads.back()) };
+	std::vector<std::thread> solvers;
+	for (size_t i = 0; i < quantityOfThreads; ++i) {
+		solvers.emplace_back(&BatchPipeline::solveChunks, this, std::ref(parsedChunks), std::ref(solvedChunks),
+			std::ref(statisticsOfThreads[i]), std::ref(errorsOfThreads[i]));
+	}
+	std::exception_ptr error{};
+	size_t quantityOfCases = 0;
+	try {
+		std::string lineText{};
+		size_t numberOfLine = 0;
+		BatchChunk *chunk = nullptr;
+		while (std::getline(input, lineText)) {
+			++numberOfLine;
+			if (!BatchRunner::isCaseInLine(lineText)) {
+				continue;
+			}
+			if (chunk == nullptr) {
+				if (!freeChunks.pop(chunk)) {
+					break;//the writing stage finished after the error of other stage
+				}
+				ScratchArena::local().reset();
+				chunk->index = quantityOfCases / sizeOfChunk;
+				chunk->firstCase = quantityOfCases;
+				chunk->cases.clear();
+			}
+			try {
+				chunk->cases.push_back(runner->parseCase(lineText));
+			}
+			catch (std::invalid_argument &lineError) {
+				throw std::invalid_argument("line " + std::to_string(numberOfLine) + ": " + lineError.what());
+			}
+			++quantityOfCases;
+			if (chunk->cases.size() == sizeOfChunk) {
+				parsedChunks.push(chunk);
+				chunk = nullptr;
+			}
+		}
+		if (chunk != nullptr) {
+			parsedChunks.push(chunk);
+		}
+	}
+	catch (...) {
+		error = std::current_exception();
+	}
+	parsedChunks.close();
+	for (auto &solver : solvers) {
+		solver.join();
+	}
+	solvedChunks.close();
+	writer.join();
+	if (error) {
+		std::rethrow_exception(error);
+	}
+	for (const auto &errorOfThread : errorsOfThreads) {
+		if (errorOfThread) {
+			std::rethrow_exception(errorOfThread);
+		}
+	}
+	if (isBinaryFormat) {
+		const std::streampos end = output.tellp();
+		output.seekp(beginning);
+		BatchRunner::writeBinaryHeader(output, quantityOfCases);
+		output.seekp(end);
+	}
+	output.flush();
+	if (statistics != nullptr) {
+		*statistics = SolverStatistics{};
+		for (const auto &statisticsOfThread : statisticsOfThreads) {
+			*statistics += statisticsOfThread;
+		}
+	}
+	return summary;
+}
+/*!
+ * \brief
+ * solves the parsed chunks until the queue is closed (solving stage),
+ * after the error both queues are closed, so the other solving threads and the writing stage finish
+ * \param parsedChunks chunks to solve
+ * \param solvedChunks chunks to write
+ * \param statistics counters and timers of solves of this thread (HEAT_INSTRUMENTATION only)
+ * \param error error of solving, it is rethrown by run
+ */
+void BatchPipeline::solveChunks(ChunkQueue &parsedChunks, ChunkQueue &solvedChunks, SolverStatistics &statistics,
+	std::exception_ptr &error) const
+{
+	try {
+		BatchChunk *chunk = nullptr;
+		SolverStatistics statisticsOfChunk{};
+		while (parsedChunks.pop(chunk)) {
+			chunk->results.resize(chunk->cases.size());
+			runner->solveCases(chunk->cases.data(), chunk->results.data(), chunk->cases.size(), &statisticsOfChunk);
+			statistics += statisticsOfChunk;
+			solvedChunks.push(chunk);
+		}
+	}
+	catch (...) {
+		error = std::current_exception();
+		parsedChunks.close();
+		solvedChunks.close();
+	}
+}
+/*!
+ * \brief
+ * writes the solved chunks in the order of input and returns them for parsing (writing stage),
+ * at the end (also after the error) both queues are closed, so the reading stage does not wait for free chunks
+ * \param solvedChunks chunks to write
+ * \param freeChunks written chunks
+ * \param quantityOfChunks quantity of all chunks
+ * \param output stream for results
+ * \param isBinaryFormat true if results are saved in binary format otherwise as csv
+ * \param summary summary of status of written results
+ * \param error error of writing, it is rethrown by run
+ */
+void BatchPipeline::writeChunks(ChunkQueue &solvedChunks, ChunkQueue &freeChunks, const size_t &quantityOfChunks,
+	std::ostream &output, const bool &isBinaryFormat, BatchStatusSummary &summary, std::exception_ptr &error) const
+{
+	try {
+		std::vector<BatchChunk*> waitingChunks(quantityOfChunks, nullptr);//the chunks solved before the previous ones
+		size_t nextIndex = 0;
+		BatchChunk *chunk = nullptr;
+		while (solvedChunks.pop(chunk)) {
+			waitingChunks[chunk->index % quantityOfChunks] = chunk;
+			while ((chunk = waitingChunks[nextIndex % quantityOfChunks]) != nullptr) {
+				HEAT_TRACE_SCOPE("write chunk", "io");
+				waitingChunks[nextIndex % quantityOfChunks] = nullptr;
+				if (isBinaryFormat) {
+					BatchRunner::writeBinaryRecords(output, chunk->results.data(), chunk->results.size());
+				}
+				else {
+					BatchRunner::writeCsvRows(output, chunk->results.data(), chunk->results.size(), chunk->firstCase);
+				}
+				for (const auto &result : chunk->results) {
+					summary.add(result.status);
+				}
+				freeChunks.push(chunk);
+				++nextIndex;
+			}
+		}
+	}
+	catch (...) {
+		error = std::current_exception();
+	}
+	solvedChunks.close();
+	freeChunks.close();
+}
@@ -0,0 +1,77 @@
+#pragma once
+#include "BatchRunner.h"
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <istream>
+#include <mutex>
+#include <ostream>
+#include <vector>
+/*!
+ * \brief The BatchChunk class
+ * fixed-size part of batch which goes through the stages of BatchPipeline,
+ * the chunks are reused, so their vectors keep the memory after the first chunks
+ */
+class BatchChunk
+{
+public:
+    /*!
+     * \brief index of chunk in input, the chunks are written in this order
+     */
+	size_t index{ 0 };
+    /*!
+     * \brief index of the first case of chunk
+     */
+	size_t firstCase{ 0 };
+	std::vector<BatchCase> cases;
+	std::vector<OutputData> results;
+};
+/*!
+ * \brief The ChunkQueue class
+ * queue of chunks between the stages of pipeline, pop waits for the chunk until the queue is closed,
+ * the queue does not need the limit because the quantity of chunks is limited
+ */
+class ChunkQueue
+{
+public:
+	void push(BatchChunk *chunk);
+	bool pop(BatchChunk *&chunk);
+	void close();
+private:
+	std::mutex lock;
+	std::condition_variable isChanged;
+	std::deque<BatchChunk*> chunks;
+	bool isClosed{ false };
+};
+/*!
+ * \brief The BatchPipeline class
+ * solves the batch in three concurrent stages on chunks of quantityOfCasesInChunk cases:
+ * the calling thread reads and parses the lines, the threads of runner solve the chunks
+ * and the writing thread saves the results in the order of input.
+ * The reading time is hidden behind solving and the memory does not depend on the quantity of cases:
+ * only maximumQuantityOfChunks chunks exist, the parsing waits until the written chunk is returned.
+ * The stage which fails closes its queues, so the other stages finish, and run rethrows its error
+ * \author Łukasz Dyraga
+ * \version 1.0
+ */
+class BatchPipeline
+{
+public:
+	explicit BatchPipeline(const BatchRunner &runner);
+	BatchStatusSummary run(std::istream &input, std::ostream &output, const bool &isBinaryFormat,
+		SolverStatistics *statistics = nullptr);
+    /*!
+     * \brief quantity of cases in one chunk
+     */
+	size_t quantityOfCasesInChunk{ 1024 };
+    /*!
+     * \brief quantity of chunks which exist at once, 0 means two for each solving thread and two for other stages
+     */
+	size_t maximumQuantityOfChunks{ 0 };
+private:
+	void solveChunks(ChunkQueue &parsedChunks, ChunkQueue &solvedChunks, SolverStatistics &statistics,
+		std::exception_ptr &error) const;
+	void writeChunks(ChunkQueue &solvedChunks, ChunkQueue &freeChunks, const size_t &quantityOfChunks,
+		std::ostream &output, const bool &isBinaryFormat, BatchStatusSummary &summary, std::exception_ptr &error) const;
+	const BatchRunner *runner;
+};
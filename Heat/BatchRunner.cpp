@@ -0,0 +1,441 @@
+#include "BatchRunner.h"
+#include "HeatTransferSolver.h"
+#include "MixedPrecisionSolver.h"
+#include "ScratchArena.h"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <exception>
+#include <string>
+#include <thread>
+#include <stdexcept>
+#include <limits>
+
+const int BatchRunner::quantityOfInputValues;
+const char *const BatchRunner::inputNames[BatchRunner::quantityOfInputValues]{
+	"innerDiameterOfPipe",
+	"thicknessOfPipe",
+	"meanVelocityOfLiquid",
+	"meanTemperatureOfLiquid",
+	"typeOfLiquid",
+	"typeOfForcedConvection",
+	"thermalConductivityOfIsolator",
+	"thicknessOfIsolator",
+	"temperatureOfEnvironment",
+	"typeOfEmissivity",
+	"lengthOfPipe"
+};
+
+namespace {
+/*!
+ * \brief converts the value of type to integer before it is checked, the value which is not finite or out of range of int is -1 (unknown)
+ * \param value value of type from input
+ * \return type
+ */
+int getType(const double &value)
+{
+	return std::isfinite(value) && value > -1 && value < std::numeric_limits<int>::max() ? static_cast<int>(value) : -1;
+}
+}
+/*!
+ * \brief constructor
+ * \param fluids properties of all liquids and air, they have to outlive the runner
+ * \param options options of the batch run
+ */
+BatchRunner::BatchRunner(const FluidLibrary &fluids, const BatchOptions &options):
+	fluids{&fluids},options{options}
+{
+}
+/*!
+ * \brief reads all cases, the scratch memory of every line is released by parseCase
+ * \param input stream with cases, one case in line
+ * \throw std::invalid_argument if line is corrupted, the message contains the number of line
+ * \return loaded cases
+ */
+std::vector<BatchCase> BatchRunner::loadCases(std::istream &input) const
+{
+	HEAT_TRACE_SCOPE("load cases", "io");
+	std::vector<BatchCase> cases;
+	std::string lineText{};
+	size_t numberOfLine = 0;
+	while (std::getline(input, lineText)) {
+		++numberOfLine;
+		if (!isCaseInLine(lineText)) {
+			continue;
+		}
+		try {
+			cases.push_back(parseCase(lineText));
+		}
+		catch (std::invalid_argument &error) {
+			throw std::invalid_argument("line " + std::to_string(numberOfLine) + ": " + error.what());
+		}
+	}
+	return cases;
+}
+/*!
+ * \brief
+ * reads one case from line of text, after the quantityOfInputValues values
+ * the pairs of thickness and thermal conductivity of layers can be given (pipe wall first),
+ * the copy of line is kept in scratch arena of thread, so the correct line is read without heap allocations
+ * \param lineText line with values, the decimal separator can be '.' or ','
+ * \throw std::invalid_argument if value is not a number, the quantity of values is wrong,
+ * the layer is wrong or the type of liquid, forced convection or emissivity is unknown (see makeCase)
+ * \return loaded case
+ */
+BatchCase BatchRunner::parseCase(const std::string &lineText) const
+{
+	const int maximumQuantityOfValues = quantityOfInputValues + 2 * LayerStack::maximumQuantityOfLayers;
+	ScratchArena::Scope scope{ ScratchArena::local() };
+	char *text = ScratchArena::local().allocateArray<char>(lineText.size() + 1);
+	std::replace_copy(lineText.begin(), lineText.end(), text, ',', '.');
+	text[lineText.size()] = '\0';
+	double value[maximumQuantityOfValues]{};
+	int quantityOfValues = 0;
+	char *word = text;
+	while (true) {
+		while (*word != '\0' && std::isspace(static_cast<unsigned char>(*word))) {
+			++word;
+		}
+		if (*word == '\0') {
+			break;
+		}
+		char *endOfWord = word;
+		while (*endOfWord != '\0' && !std::isspace(static_cast<unsigned char>(*endOfWord))) {
+			++endOfWord;
+		}
+		if (quantityOfValues == maximumQuantityOfValues) {
+			throw std::invalid_argument("too many values, expected at most " + std::to_string(maximumQuantityOfValues));
+		}
+		char *endOfNumber = nullptr;
+		errno = 0;
+		value[quantityOfValues] = std::strtod(word, &endOfNumber);
+		if (endOfNumber == word || endOfNumber != endOfWord || errno == ERANGE) {
+			throw std::invalid_argument("value '" + std::string(word, endOfWord) + "' is not a number");
+		}
+		++quantityOfValues;
+		word = endOfWord;
+	}
+	if (quantityOfValues < quantityOfInputValues || (quantityOfValues - quantityOfInputValues) % 2 != 0) {
+		throw std::invalid_argument("expected " + std::to_string(quantityOfInputValues) +
+			" values and pairs of layer values, found " + std::to_string(quantityOfValues));
+	}
+	BatchCase batchCase = makeCase(value);
+	for (int i = quantityOfInputValues; i < quantityOfValues; i += 2) {
+		batchCase.data.layers.addLayer(value[i], value[i + 1]);
+	}
+	return batchCase;
+}
+/*!
+ * \brief checks if the line of input contains the case, the empty lines and lines started with '#' are skipped
+ * \param lineText line of input
+ * \return true if the line contains the case
+ */
+bool BatchRunner::isCaseInLine(const std::string &lineText)
+{
+	size_t firstSign = lineText.find_first_not_of(" \t\r");
+	return firstSign != std::string::npos && lineText[firstSign] != '#';
+}
+/*!
+ * \brief creates the case from values
+ * \param value array of quantityOfInputValues values in the same order as in line of input
+ * \throw std::invalid_argument if the type of liquid, forced convection or emissivity is unknown
+ * \return created case
+ */
+BatchCase BatchRunner::makeCase(const double *value) const
+{
+	BatchCase batchCase{};
+	batchCase.data.innerDiameterOfPipe = value[0];
+	batchCase.data.thicknessOfPipe = value[1];
+	batchCase.data.meanVelocityOfLiquid = value[2];
+	batchCase.data.meanTemperatureOfLiquid = value[3];
+	batchCase.typeOfLiquid = getType(value[4]);
+	batchCase.typeOfForcedConvection = getType(value[5]);
+	batchCase.data.thermalConductivityOfIsolator = value[6];
+	batchCase.data.thicknessOfIsolator = value[7];
+	batchCase.data.temperatureOfEnvironment = value[8];
+	batchCase.typeOfEmissivity = getType(value[9]);
+	batchCase.data.lengthOfPipe = value[10];
+	if (options.typeOfLiquid >= 0) {
+		batchCase.typeOfLiquid = options.typeOfLiquid;
+	}
+	if (options.typeOfForcedConvection >= 0) {
+		batchCase.typeOfForcedConvection = options.typeOfForcedConvection;
+	}
+	if (batchCase.typeOfLiquid < 0 || batchCase.typeOfLiquid >= FluidLibrary::quantityOfLiquids) {
+		throw std::invalid_argument("unknown type of liquid");
+	}
+	if (batchCase.typeOfForcedConvection < 0
+		|| batchCase.typeOfForcedConvection >= InputData::quantityOfForcedConvectionTypes) {
+		throw std::invalid_argument("unknown type of forced convection");
+	}
+	if (batchCase.typeOfEmissivity < 0 || batchCase.typeOfEmissivity > 2) {
+		throw std::invalid_argument("unknown type of emissivity of isolator");
+	}
+	if (options.typeOfNaturalConvection < 0
+		|| options.typeOfNaturalConvection >= InputData::quantityOfNaturalConvectionTypes) {
+		throw std::invalid_argument("unknown type of natural convection");
+	}
+	batchCase.data.setForcedConvectionConstValues(batchCase.typeOfForcedConvection);
+	batchCase.data.typeOfNaturalConvection = options.typeOfNaturalConvection;
+	batchCase.data.setEmissivityOfIsolator(batchCase.typeOfEmissivity);
+	return batchCase;
+}
+/*!
+ * \brief solves all cases, the cases are divided into equal parts for each thread
+ * \param cases cases to solve, the remaining data of input are calculated by solver
+ * \param statistics if not null the counters and timers of all solves are set (HEAT_INSTRUMENTATION only)
+ * \throw the exception of solving (e.g. std::bad_alloc) is rethrown after all threads are joined
+ * \return results in the same order as cases
+ */
+std::vector<OutputData> BatchRunner::solve(std::vector<BatchCase> &cases, SolverStatistics *statistics) const
+{
+	HEAT_TRACE_SCOPE("solve batch", "batch");
+	std::vector<OutputData> results(cases.size());
+	size_t quantityOfThreads = options.quantityOfThreads > 0 ? options.quantityOfThreads : 1;
+	if (quantityOfThreads > cases.size()) {
+		quantityOfThreads = cases.size() > 0 ? cases.size() : 1;
+	}
+	if (quantityOfThreads == 1) {
+		solveCases(cases.data(), results.data(), cases.size(), statistics);
+		return results;
+	}
+	std::vector<SolverStatistics> statisticsOfThreads(quantityOfThreads);
+	std::vector<std::exception_ptr> errorsOfThreads(quantityOfThreads);
+	std::vector<std::thread> threads;
+	size_t partSize = cases.size() / quantityOfThreads;
+	size_t remainder = cases.size() % quantityOfThreads;
+	for (size_t i = 0, begin = 0; i < quantityOfThreads; ++i) {
+		size_t size = partSize + (i < remainder ? 1 : 0);
+		threads.emplace_back([this, &cases, &results, &statisticsOfThreads, &errorsOfThreads, i, begin, size]() {
+			try {
+				solveCases(cases.data() + begin, results.data() + begin, size, &statisticsOfThreads[i]);
+			}
+			catch (...) {
+				errorsOfThreads[i] = std::current_exception();
+			}
+		});
+		begin += size;
+	}
+	for (auto &thread : threads) {
+		thread.join();
+	}
+	for (const auto &error : errorsOfThreads) {
+		if (error) {
+			std::rethrow_exception(error);
+		}
+	}
+	if (statistics != nullptr) {
+		*statistics = SolverStatistics{};
+		for (const auto &statisticsOfThread : statisticsOfThreads) {
+			*statistics += statisticsOfThread;
+		}
+	}
+	return results;
+}
+/*!
+ * \brief solves the cases one after another
+ * \param cases first case to solve
+ * \param results place for the first result
+ * \param quantityOfCases quantity of cases to solve
+ * \param statistics if not null the counters and timers of these solves are set (HEAT_INSTRUMENTATION only)
+ */
+void BatchRunner::solveCases(BatchCase *cases, OutputData *results, const size_t &quantityOfCases,
+	SolverStatistics *statistics) const
+{
+	HEAT_TRACE_SCOPE("solve cases", "batch");
+#ifdef HEAT_INSTRUMENTATION
+	SolverStatistics before = SolverStatistics::local();
+	std::uint64_t maximumRootIterations = 0;
+	for (size_t i = 0; i < quantityOfCases; ++i) {
+		std::uint64_t rootIterations = SolverStatistics::local().rootIterations;
+		solveCase(cases[i], results[i]);
+		maximumRootIterations = std::max(maximumRootIterations, SolverStatistics::local().rootIterations - rootIterations);
+	}
+	if (statistics != nullptr) {
+		*statistics = SolverStatistics::local() - before;
+		statistics->maximumRootIterations = maximumRootIterations;
+	}
+#else
+	(void)statistics;
+	for (size_t i = 0; i < quantityOfCases; ++i) {
+		solveCase(cases[i], results[i]);
+	}
+#endif
+}
+/*!
+ * \brief solves one case
+ * \param batchCase case to solve
+ * \param result results of case
+ */
+void BatchRunner::solveCase(BatchCase &batchCase, OutputData &result) const
+{
+	if (options.isMixedPrecision && batchCase.data.layers.size() == 0) {
+		MixedPrecisionSolver solver{ batchCase.data, fluids->liquid(batchCase.typeOfLiquid), fluids->air() };
+		solver.runTheSolver(options.tolerance);
+		result = *solver.getResults();
+		return;
+	}
+	HeatTransferSolver solver{ batchCase.data, fluids->liquid(batchCase.typeOfLiquid), fluids->air() };
+	solver.runTheSolver(options.tolerance);
+	result = *solver.getResults();
+}
+/*!
+ * \brief returns the options of batch run
+ * \return options
+ */
+const BatchOptions& BatchRunner::getOptions() const
+{
+	return options;
+}
+/*!
+ * \brief saves the results as comma separated values, the first row contains the names of values,
+ * the last column contains the status flags of case (see OutputData::StatusFlag)
+ * \param output stream for results
+ * \param results results of cases
+ */
+void BatchRunner::saveResultsAsCsv(std::ostream &output, const std::vector<OutputData> &results)
+{
+	HEAT_TRACE_SCOPE("export csv", "io");
+	writeCsvHeader(output);
+	writeCsvRows(output, results.data(), results.size(), 0);
+}
+/*!
+ * \brief saves the results in binary format: BinaryResultsHeader and the values of each case
+ * \param output stream for results, it should be opened in binary mode
+ * \param results results of cases
+ */
+void BatchRunner::saveResultsAsBinary(std::ostream &output, const std::vector<OutputData> &results)
+{
+	HEAT_TRACE_SCOPE("export binary", "io");
+	writeBinaryHeader(output, results.size());
+	writeBinaryRecords(output, results.data(), results.size());
+}
+/*!
+ * \brief writes the first row of csv results (names of values) and sets the precision of stream
+ * \param output stream for results
+ */
+void BatchRunner::writeCsvHeader(std::ostream &output)
+{
+	output << "case";
+	for (int i = 0; i < OutputData::quantityOfFields; ++i) {
+		output << ',' << OutputData::fieldNames[i];
+	}
+	output << ",status\n";
+	output.precision(std::numeric_limits<double>::max_digits10);
+}
+/*!
+ * \brief writes the rows of csv results, see saveResultsAsCsv
+ * \param output stream for results
+ * \param results results of the first case
+ * \param quantityOfCases quantity of cases
+ * \param firstCase index of the first case
+ */
+void BatchRunner::writeCsvRows(std::ostream &output, const OutputData *results, const size_t &quantityOfCases,
+	const size_t &firstCase)
+{
+	double value[OutputData::quantityOfFields];
+	for (size_t i = 0; i < quantityOfCases; ++i) {
+		results[i].copyValuesTo(value);
+		output << firstCase + i;
+		for (int j = 0; j < OutputData::quantityOfFields; ++j) {
+			output << ',' << value[j];
+		}
+		output << ',' << results[i].status << '\n';
+	}
+}
+/*!
+ * \brief writes the header of binary results
+ * \param output stream for results
+ * \param quantityOfCases quantity of cases
+ */
+void BatchRunner::writeBinaryHeader(std::ostream &output, const size_t &quantityOfCases)
+{
+	BinaryResultsHeader header{};
+	header.quantityOfCases = quantityOfCases;
+	output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+}
+/*!
+ * \brief writes the records of binary results, see saveResultsAsBinary
+ * \param output stream for results
+ * \param results results of the first case
+ * \param quantityOfCases quantity of cases
+ */
+void BatchRunner::writeBinaryRecords(std::ostream &output, const OutputData *results, const size_t &quantityOfCases)
+{
+	double value[OutputData::quantityOfFields];
+	for (size_t i = 0; i < quantityOfCases; ++i) {
+		results[i].copyValuesTo(value);
+		output.write(reinterpret_cast<const char*>(value), sizeof(value));
+	}
+}
+/*!
+ * \brief counts the cases by status flags of results
+ * \param results results of cases
+ * \return summary of status
+ */
+BatchStatusSummary BatchRunner::getStatusSummary(const std::vector<OutputData> &results)
+{
+	BatchStatusSummary summary{};
+	for (const auto &result : results) {
+		summary.add(result.status);
+	}
+	return summary;
+}
+/*!
+ * \brief adds the case to summary
+ * \param status status flags of case
+ */
+void BatchStatusSummary::add(const unsigned int &status)
+{
+	++quantityOfCases;
+	if ((status & ~static_cast<unsigned int>(OutputData::statusExtrapolation)) != 0) {
+		++quantityOfSuspectCases;
+	}
+	for (int i = 0; i < OutputData::quantityOfStatusFlags; ++i) {
+		if (status & (1u << i)) {
+			++quantityOfCasesWithFlag[i];
+		}
+	}
+}
+/*!
+ * \brief describes the suspect cases, e.g. "2 of 10 cases may be incorrect: division by zero 1, not converged 1"
+ * \return text of summary
+ */
+std::string BatchStatusSummary::toText() const
+{
+	std::string text = std::to_string(quantityOfSuspectCases) + " of " + std::to_string(quantityOfCases)
+		+ " cases may be incorrect";
+	const char *separator = ": ";
+	for (int i = 0; i < OutputData::quantityOfStatusFlags; ++i) {
+		if ((1u << i) != OutputData::statusExtrapolation && quantityOfCasesWithFlag[i] > 0) {
+			text += separator + std::string(OutputData::statusNames[i]) + " " + std::to_string(quantityOfCasesWithFlag[i]);
+			separator = ", ";
+		}
+	}
+	return text;
+}
+/*!
+ * \brief describes the extrapolated cases, e.g. "properties of fluids were extrapolated in 2 of 10 cases"
+ * \return text of note
+ */
+std::string BatchStatusSummary::toNoteText() const
+{
+	return "properties of fluids were extrapolated outside of their tables in "
+		+ std::to_string(getQuantityOfExtrapolatedCases()) + " of " + std::to_string(quantityOfCases) + " cases";
+}
+/*!
+ * \brief returns the quantity of cases with extrapolated properties of fluids
+ * \return quantity of cases
+ */
+size_t BatchStatusSummary::getQuantityOfExtrapolatedCases() const
+{
+	size_t quantity = 0;
+	for (int i = 0; i < OutputData::quantityOfStatusFlags; ++i) {
+		if ((1u << i) == OutputData::statusExtrapolation) {
+			quantity = quantityOfCasesWithFlag[i];
+		}
+	}
+	return quantity;
+}
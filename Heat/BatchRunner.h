@@ -0,0 +1,163 @@
+#pragma once
+#include "InputData.h"
+#include "OutputData.h"
+#include "FluidLibrary.h"
+#include "SolverStatistics.h"
+#include <istream>
+#include <ostream>
+#include <vector>
+#include <cstdint>
+#include <string>
+/*!
+ * \brief The BatchCase class
+ * stores one case of the batch run
+ * \author Łukasz Dyraga
+ * \version 1.0
+ */
+class BatchCase
+{
+public:
+    /*!
+     * \brief stores the input data of the case
+     */
+	InputData data;
+    /*!
+     * \brief index of liquid, see FluidLibrary
+     */
+	int typeOfLiquid;
+    /*!
+     * \brief 0-low viscosity, 1-high viscosity, 2-perpendicular flow, 3-cooled liquid of low viscosity
+     */
+	int typeOfForcedConvection;
+    /*!
+     * \brief 0-low (0.3), 1-medium (0.6), 2-high (0.9)
+     */
+	int typeOfEmissivity;
+};
+/*!
+ * \brief The BatchOptions class
+ * stores the options of the batch run,
+ * negative type of liquid or forced convection means the value from the case is used
+ */
+class BatchOptions
+{
+public:
+    /*!
+     * \brief index of liquid used for all cases
+     */
+	int typeOfLiquid{ -1 };
+    /*!
+     * \brief type of forced convection used for all cases
+     */
+	int typeOfForcedConvection{ -1 };
+    /*!
+     * \brief type of natural convection used for all cases, see InputData::typeOfNaturalConvection
+     */
+	int typeOfNaturalConvection{ 0 };
+    /*!
+     * \brief value of tolerance used by solver
+     */
+	double tolerance{ 0.001 };
+    /*!
+     * \brief quantity of threads which solve the cases
+     */
+	unsigned int quantityOfThreads{ 1 };
+    /*!
+     * \brief memory limit of result cache used by daemon [bytes], 0 means no cache
+     */
+	size_t cacheMemoryLimit{ 0 };
+    /*!
+     * \brief true if the cases are solved by MixedPrecisionSolver (cases with layers are solved in double precision)
+     */
+	bool isMixedPrecision{ false };
+};
+/*!
+ * \brief The BinaryResultsHeader class
+ * header of the binary results file, after the header
+ * quantityOfCases records of OutputData::quantityOfFields doubles are stored
+ */
+class BinaryResultsHeader
+{
+public:
+	char magic[4]{ 'H','T','R','B' };
+	std::uint32_t version{ 1 };
+	std::uint32_t quantityOfFields{ OutputData::quantityOfFields };
+	std::uint32_t reserved{ 0 };
+	std::uint64_t quantityOfCases{ 0 };
+};
+/*!
+ * \brief The BatchStatusSummary class
+ * counts the cases of batch run by status flags of results,
+ * the extrapolation of properties is only noted, it does not make the case suspect
+ */
+class BatchStatusSummary
+{
+public:
+	void add(const unsigned int &status);
+	std::string toText() const;
+	std::string toNoteText() const;
+	size_t getQuantityOfExtrapolatedCases() const;
+    /*!
+     * \brief quantity of all cases
+     */
+	size_t quantityOfCases{ 0 };
+    /*!
+     * \brief quantity of cases with any status flag set except extrapolation
+     */
+	size_t quantityOfSuspectCases{ 0 };
+    /*!
+     * \brief quantity of cases with each flag set, the i-th element belongs to flag 1 << i
+     */
+	size_t quantityOfCasesWithFlag[OutputData::quantityOfStatusFlags]{};
+};
+/*!
+ * \brief The BatchRunner class
+ * reads the cases, solves them (optionally using many threads) and saves the results,
+ * each line of input contains one case, the values are in the same order as in the test data file:
+ * inner diameter of pipe, thickness of pipe, mean velocity of liquid, mean temperature of liquid,
+ * type of liquid, type of forced convection, thermal conductivity of isolator, thickness of isolator,
+ * temperature of environment, type of emissivity of isolator, length of pipe;
+ * optionally followed by pairs of thickness and thermal conductivity of layers (pipe wall first);
+ * empty lines and lines started with '#' are skipped
+ * \author Łukasz Dyraga
+ * \version 1.0
+ */
+class BatchRunner
+{
+public:
+	BatchRunner(const FluidLibrary &fluids, const BatchOptions &options);
+	std::vector<BatchCase> loadCases(std::istream &input) const;
+	BatchCase parseCase(const std::string &lineText) const;
+	static bool isCaseInLine(const std::string &lineText);
+	BatchCase makeCase(const double *value) const;
+	std::vector<OutputData> solve(std::vector<BatchCase> &cases, SolverStatistics *statistics = nullptr) const;
+	void solveCases(BatchCase *cases, OutputData *results, const size_t &quantityOfCases,
+		SolverStatistics *statistics = nullptr) const;
+	void solveCase(BatchCase &batchCase, OutputData &result) const;
+	static void saveResultsAsCsv(std::ostream &output, const std::vector<OutputData> &results);
+	static void saveResultsAsBinary(std::ostream &output, const std::vector<OutputData> &results);
+	static void writeCsvHeader(std::ostream &output);
+	static void writeCsvRows(std::ostream &output, const OutputData *results, const size_t &quantityOfCases,
+		const size_t &firstCase);
+	static void writeBinaryHeader(std::ostream &output, const size_t &quantityOfCases);
+	static void writeBinaryRecords(std::ostream &output, const OutputData *results, const size_t &quantityOfCases);
+	static BatchStatusSummary getStatusSummary(const std::vector<OutputData> &results);
+	const BatchOptions& getOptions() const;
+	/*!
+	 * \brief quantity of values in one line of input
+	 */
+	static const int quantityOfInputValues{ 11 };
+	/*!
+	 * \brief names of values in one line of input, in the same order as in line
+	 */
+	static const char *const inputNames[quantityOfInputValues];
+private:
+    /*!
+     * \brief properties of all liquids and air
+     */
+	const FluidLibrary *fluids;
+    /*!
+     * \brief options of the batch run
+     */
+	BatchOptions options;
+};
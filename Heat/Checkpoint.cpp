@@ -0,0 +1,423 @@
+#include "Checkpoint.h"
+#include "ResultCache.h"
+#include "ResultRing.h"
+#include "TraceRecorder.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <cerrno>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+const size_t CheckpointFile::sizeOfHeader;
+static_assert(sizeof(CheckpointHeader) <= CheckpointFile::sizeOfHeader, "header has to fit in its page");
+
+namespace {
+/*!
+ * \brief version of checkpoint file
+ */
+const std::uint32_t versionOfCheckpoint = 1;
+/*!
+ * \brief adds the value to FNV-1a hash
+ */
+void addToHash(std::uint64_t &hash, const std::uint64_t &value)
+{
+	for (int byte = 0; byte < 8; ++byte) {
+		hash ^= (value >> (8 * byte)) & 0xFF;
+		hash *= 1099511628211ULL;
+	}
+}
+/*!
+ * \brief creates the text of error with the description of errno
+ */
+std::string getErrorText(const std::string &text, const std::string &path)
+{
+	return text + " " + path + ": " + std::strerror(errno);
+}
+}
+
+/*!
+ * \brief copies the results of case into record
+ * \param result results of case
+ */
+void ResultRecord::setFrom(const OutputData &result)
+{
+	result.copyValuesTo(value);
+	status = result.status;
+	reserved = 0;
+}
+/*!
+ * \brief copies the record into results of case
+ * \param result results of case
+ */
+void ResultRecord::copyTo(OutputData &result) const
+{
+	result.setValuesFrom(value);
+	result.status = status;
+}
+/*!
+ * \brief constructor, creates the new checkpoint file or opens the file of stopped run
+ * \param path path of file, if empty the anonymous shared memory is used
+ * \param quantityOfCases quantity of cases of run
+ * \param fingerprint fingerprint of cases and options, see getFingerprint
+ * \param isResumed true if the existing file is continued, otherwise the file is created (overwritten)
+ * \throw std::runtime_error if the file can not be opened or mapped,
+ * or the resumed file belongs to other cases or options
+ * \throw std::invalid_argument if the run without path is resumed
+ */
+CheckpointFile::CheckpointFile(const std::string &path, const std::uint64_t &quantityOfCases,
+	const std::uint64_t &fingerprint, const bool &isResumed):
+	path{path},file{-1},memory{nullptr},sizeOfMemory{sizeOfHeader + quantityOfCases * sizeof(ResultRecord)},
+	header{nullptr},records{nullptr}
+{
+	if (path.empty()) {
+		if (isResumed) {
+			throw std::invalid_argument("the run without checkpoint file can not be resumed");
+		}
+		void *address = mmap(nullptr, sizeOfMemory, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+		if (address == MAP_FAILED) {
+			throw std::runtime_error(getErrorText("couldn't map memory for", "results"));
+		}
+		memory = static_cast<char*>(address);
+		header = reinterpret_cast<CheckpointHeader*>(memory);
+		records = reinterpret_cast<ResultRecord*>(memory + sizeOfHeader);
+		*header = CheckpointHeader{ {'H','T','R','C'}, versionOfCheckpoint,
+			static_cast<std::uint32_t>(OutputData::quantityOfFields), static_cast<std::uint32_t>(sizeof(ResultRecord)),
+			quantityOfCases, fingerprint, {} };
+		header->commitRecord[0].checksum = getChecksum(header->commitRecord[0], fingerprint);
+		return;
+	}
+	file = isResumed ? open(path.c_str(), O_RDWR) : open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if (file < 0) {
+		throw std::runtime_error(getErrorText("couldn't open checkpoint", path));
+	}
+	struct stat status {};
+	if (isResumed && (fstat(file, &status) != 0 || static_cast<size_t>(status.st_size) != sizeOfMemory)) {
+		close(file);
+		throw std::runtime_error("checkpoint " + path + " does not match the quantity of cases");
+	}
+	if (!isResumed && ftruncate(file, static_cast<off_t>(sizeOfMemory)) != 0) {
+		std::string text = getErrorText("couldn't resize checkpoint", path);
+		close(file);
+		throw std::runtime_error(text);
+	}
+	void *address = mmap(nullptr, sizeOfMemory, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+	if (address == MAP_FAILED) {
+		std::string text = getErrorText("couldn't map checkpoint", path);
+		close(file);
+		throw std::runtime_error(text);
+	}
+	memory = static_cast<char*>(address);
+	header = reinterpret_cast<CheckpointHeader*>(memory);
+	records = reinterpret_cast<ResultRecord*>(memory + sizeOfHeader);
+	if (!isResumed) {
+		CheckpointHeader created{ {'H','T','R','C'}, versionOfCheckpoint,
+			static_cast<std::uint32_t>(OutputData::quantityOfFields), static_cast<std::uint32_t>(sizeof(ResultRecord)),
+			quantityOfCases, fingerprint, {} };
+		created.commitRecord[0].checksum = getChecksum(created.commitRecord[0], fingerprint);
+		*header = created;
+		synchronize(0, sizeOfHeader);
+		return;
+	}
+	if (std::memcmp(header->magic, "HTRC", 4) != 0 || header->version != versionOfCheckpoint
+		|| header->quantityOfFields != OutputData::quantityOfFields || header->sizeOfRecord != sizeof(ResultRecord)
+		|| header->quantityOfCases != quantityOfCases || findCommitRecord() == nullptr) {
+		munmap(memory, sizeOfMemory);
+		close(file);
+		throw std::runtime_error(path + " is not a checkpoint of this run");
+	}
+	if (header->fingerprint != fingerprint) {
+		munmap(memory, sizeOfMemory);
+		close(file);
+		throw std::runtime_error("checkpoint " + path + " was made for other cases or options");
+	}
+}
+/*!
+ * \brief destructor, unmaps and closes the file
+ */
+CheckpointFile::~CheckpointFile()
+{
+	munmap(memory, sizeOfMemory);
+	if (file >= 0) {
+		close(file);
+	}
+}
+/*!
+ * \brief
+ * solves the cases which are not committed yet, every thread takes the next chunk of cases
+ * and writes its results into file, the results are committed when the chunks are completed without gaps
+ * and at least intervalOfCommits passed since the last commit
+ * \param runner runner which solves the chunks, its quantity of threads is used
+ * \param cases all cases of run, the same as used for fingerprint
+ * \param statistics if not null the counters and timers of solves are set (HEAT_INSTRUMENTATION only)
+ * \throw std::invalid_argument if the quantity of cases is different from the file
+ * \throw std::runtime_error if the results can not be committed
+ * \return results of all cases, also the ones solved before the resume
+ */
+std::vector<OutputData> CheckpointFile::solve(const BatchRunner &runner, std::vector<BatchCase> &cases,
+	SolverStatistics *statistics)
+{
+	HEAT_TRACE_SCOPE("solve with checkpoint", "batch");
+	if (cases.size() != header->quantityOfCases) {
+		throw std::invalid_argument("different quantity of cases than in checkpoint");
+	}
+	ChunkProgress progress{ *this };
+	const std::uint64_t quantityOfChunks = progress.getQuantityOfChunks();
+	size_t quantityOfThreads = std::max(runner.getOptions().quantityOfThreads, 1u);
+	quantityOfThreads = std::max<size_t>(std::min<size_t>(quantityOfThreads, quantityOfChunks), 1);
+	std::atomic<std::uint64_t> nextChunk{ 0 };
+	std::mutex commitLock;
+	std::vector<SolverStatistics> statisticsOfThreads(quantityOfThreads);
+	std::exception_ptr error{};
+	auto solveChunksOfThread = [&](const size_t &indexOfThread) {
+		std::vector<OutputData> results(std::max<std::uint64_t>(quantityOfCasesInChunk, 1));
+		SolverStatistics statisticsOfChunk{};
+		for (std::uint64_t chunk = nextChunk++; chunk < quantityOfChunks; chunk = nextChunk++) {
+			std::uint64_t begin = progress.getBeginOf(chunk);
+			std::uint64_t end = progress.getEndOf(chunk);
+			runner.solveCases(cases.data() + begin, results.data(), end - begin, &statisticsOfChunk);
+			statisticsOfThreads[indexOfThread] += statisticsOfChunk;
+			for (std::uint64_t i = begin; i < end; ++i) {
+				setResult(i, results[i - begin]);
+			}
+			std::lock_guard<std::mutex> lock(commitLock);
+			progress.complete(chunk);
+		}
+	};
+	auto solveChunks = [&](const size_t &indexOfThread) {
+		try {
+			solveChunksOfThread(indexOfThread);
+		}
+		catch (...) {
+			std::lock_guard<std::mutex> lock(commitLock);
+			error = std::current_exception();
+			nextChunk = quantityOfChunks;
+		}
+	};
+	std::vector<std::thread> threads;
+	for (size_t i = 1; i < quantityOfThreads; ++i) {
+		threads.emplace_back(solveChunks, i);
+	}
+	solveChunks(0);
+	for (auto &thread : threads) {
+		thread.join();
+	}
+	if (error) {
+		std::rethrow_exception(error);
+	}
+	if (statistics != nullptr) {
+		*statistics = SolverStatistics{};
+		for (const auto &statisticsOfThread : statisticsOfThreads) {
+			*statistics += statisticsOfThread;
+		}
+	}
+	return getResults();
+}
+/*!
+ * \brief writes the results of case into file, they are durable after the next commit
+ * \param index index of case
+ * \param result results of case
+ */
+void CheckpointFile::setResult(const std::uint64_t &index, const OutputData &result)
+{
+	records[index].setFrom(result);
+}
+/*!
+ * \brief reads the results of case from file
+ * \param index index of case
+ * \return results of case
+ */
+OutputData CheckpointFile::getResult(const std::uint64_t &index) const
+{
+	OutputData result{};
+	records[index].copyTo(result);
+	return result;
+}
+/*!
+ * \brief reads the results of all cases from file
+ * \return results in the same order as cases
+ */
+std::vector<OutputData> CheckpointFile::getResults() const
+{
+	std::vector<OutputData> results(header->quantityOfCases);
+	for (size_t i = 0; i < results.size(); ++i) {
+		records[i].copyTo(results[i]);
+	}
+	return results;
+}
+/*!
+ * \brief
+ * makes the results of first cases durable: the records written since the last commit are synchronized with disk,
+ * next the commit record is written in place of the older one and synchronized
+ * \param quantityOfCommittedCases quantity of cases from the beginning which results are written
+ * \throw std::runtime_error if the file can not be synchronized
+ */
+void CheckpointFile::commit(const std::uint64_t &quantityOfCommittedCases)
+{
+	HEAT_TRACE_SCOPE("commit checkpoint", "io");
+	const CommitRecord *current = findCommitRecord();
+	std::uint64_t firstCase = current->quantityOfCommittedCases;
+	if (quantityOfCommittedCases > firstCase) {
+		synchronize(sizeOfHeader + firstCase * sizeof(ResultRecord),
+			(quantityOfCommittedCases - firstCase) * sizeof(ResultRecord));
+	}
+	CommitRecord record{ current->sequence + 1, quantityOfCommittedCases, 0 };
+	record.checksum = getChecksum(record, header->fingerprint);
+	header->commitRecord[record.sequence % 2] = record;
+	synchronize(0, sizeOfHeader);
+}
+/*!
+ * \brief returns the quantity of committed cases, the run is continued from this case
+ * \return quantity of committed cases
+ */
+std::uint64_t CheckpointFile::getQuantityOfCommittedCases() const
+{
+	return findCommitRecord()->quantityOfCommittedCases;
+}
+/*!
+ * \brief returns the quantity of all cases of run
+ * \return quantity of cases
+ */
+std::uint64_t CheckpointFile::getQuantityOfCases() const
+{
+	return header->quantityOfCases;
+}
+/*!
+ * \brief
+ * calculates the fingerprint of run: the canonical values of all cases (see ResultCache::makeKey)
+ * and the options which change the results
+ * \param cases cases of run
+ * \param options options of run
+ * \return fingerprint
+ */
+std::uint64_t CheckpointFile::getFingerprint(const std::vector<BatchCase> &cases, const BatchOptions &options)
+{
+	std::uint64_t hash = 14695981039346656037ULL;
+	std::uint64_t tolerance;
+	std::memcpy(&tolerance, &options.tolerance, sizeof(tolerance));
+	addToHash(hash, versionOfCheckpoint);
+	addToHash(hash, tolerance);
+	addToHash(hash, static_cast<std::uint64_t>(options.typeOfNaturalConvection));
+	addToHash(hash, options.isMixedPrecision ? 1 : 0);
+	addToHash(hash, cases.size());
+	for (const auto &batchCase : cases) {
+		addToHash(hash, ResultCache::makeKey(batchCase).hash);
+	}
+	return hash;
+}
+/*!
+ * \brief finds the current commit record
+ * \return valid commit record with greater sequence, nullptr if both are corrupted
+ */
+const CommitRecord* CheckpointFile::findCommitRecord() const
+{
+	const CommitRecord *found = nullptr;
+	for (const auto &record : header->commitRecord) {
+		if (record.checksum == getChecksum(record, header->fingerprint)
+			&& record.quantityOfCommittedCases <= header->quantityOfCases
+			&& (found == nullptr || record.sequence > found->sequence)) {
+			found = &record;
+		}
+	}
+	return found;
+}
+/*!
+ * \brief writes the part of mapped memory to disk and waits for the end of writing
+ * \param offset offset of part [bytes]
+ * \param size size of part [bytes]
+ * \throw std::runtime_error if the memory can not be synchronized
+ */
+void CheckpointFile::synchronize(const size_t &offset, const size_t &size)
+{
+	if (file < 0) {
+		return;
+	}
+	const size_t sizeOfPage = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+	size_t begin = offset / sizeOfPage * sizeOfPage;
+	if (msync(memory + begin, offset + size - begin, MS_SYNC) != 0) {
+		throw std::runtime_error(getErrorText("couldn't synchronize checkpoint", path));
+	}
+}
+/*!
+ * \brief calculates the checksum of commit record
+ * \param record commit record, its checksum is not used
+ * \param fingerprint fingerprint of run
+ * \return checksum
+ */
+std::uint64_t CheckpointFile::getChecksum(const CommitRecord &record, const std::uint64_t &fingerprint)
+{
+	std::uint64_t hash = 14695981039346656037ULL;
+	addToHash(hash, fingerprint);
+	addToHash(hash, record.sequence);
+	addToHash(hash, record.quantityOfCommittedCases);
+	return hash;
+}
+/*!
+ * \brief constructor, divides the cases which are not committed into chunks
+ * \param checkpoint checkpoint file which is committed, it has to outlive the object
+ */
+ChunkProgress::ChunkProgress(CheckpointFile &checkpoint):
+	checkpoint{&checkpoint},firstCase{checkpoint.getQuantityOfCommittedCases()},
+	sizeOfChunk{std::max<std::uint64_t>(checkpoint.quantityOfCasesInChunk, 1)},
+	quantityOfChunks{(checkpoint.getQuantityOfCases() - firstCase + sizeOfChunk - 1) / sizeOfChunk},
+	completedChunks{0},isChunkCompleted(quantityOfChunks, 0),timeOfCommit{std::chrono::steady_clock::now()}
+{
+}
+/*!
+ * \brief returns the quantity of chunks
+ * \return quantity of chunks
+ */
+std::uint64_t ChunkProgress::getQuantityOfChunks() const
+{
+	return quantityOfChunks;
+}
+/*!
+ * \brief returns the index of first case of chunk
+ * \param chunk index of chunk
+ * \return index of case
+ */
+std::uint64_t ChunkProgress::getBeginOf(const std::uint64_t &chunk) const
+{
+	return firstCase + chunk * sizeOfChunk;
+}
+/*!
+ * \brief returns the index after the last case of chunk
+ * \param chunk index of chunk
+ * \return index of case
+ */
+std::uint64_t ChunkProgress::getEndOf(const std::uint64_t &chunk) const
+{
+	return std::min<std::uint64_t>(getBeginOf(chunk) + sizeOfChunk, checkpoint->getQuantityOfCases());
+}
+/*!
+ * \brief marks the chunk as completed and publishes its results, they have to be written
+ * \param chunk index of chunk
+ * \throw std::runtime_error if the results can not be committed
+ */
+void ChunkProgress::complete(const std::uint64_t &chunk)
+{
+	if (checkpoint->stream != nullptr) {
+		for (std::uint64_t i = getBeginOf(chunk); i < getEndOf(chunk); ++i) {
+			checkpoint->stream->publish(i, checkpoint->getResult(i));
+		}
+	}
+	isChunkCompleted[chunk] = 1;
+	std::uint64_t previous = completedChunks;
+	while (completedChunks < quantityOfChunks && isChunkCompleted[completedChunks]) {
+		++completedChunks;
+	}
+	auto now = std::chrono::steady_clock::now();
+	bool isLast = completedChunks == quantityOfChunks;
+	if (completedChunks > previous
+		&& (isLast || std::chrono::duration<double>(now - timeOfCommit).count() >= checkpoint->intervalOfCommits)) {
+		checkpoint->commit(completedChunks == 0 ? firstCase : getEndOf(completedChunks - 1));
+		timeOfCommit = now;
+	}
+}
@@ -0,0 +1,138 @@
+#pragma once
+#include "BatchRunner.h"
+#include "OutputData.h"
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+class ResultRing;
+/*!
+ * \brief The ResultRecord class
+ * results of one case as stored in memory-mapped files,
+ * values are in the order of OutputData::fieldNames
+ */
+class ResultRecord
+{
+public:
+	void setFrom(const OutputData &result);
+	void copyTo(OutputData &result) const;
+	double value[OutputData::quantityOfFields];
+	std::uint32_t status;
+	std::uint32_t reserved;
+};
+/*!
+ * \brief The CommitRecord class
+ * progress of checkpointed run, the record is valid if its checksum matches,
+ * so the record torn by crash during writing is recognized and skipped
+ */
+class CommitRecord
+{
+public:
+	std::uint64_t sequence;
+	std::uint64_t quantityOfCommittedCases;
+	std::uint64_t checksum;
+};
+/*!
+ * \brief The CheckpointHeader class
+ * header of checkpoint file, it takes the first page of file and is followed by quantityOfCases records;
+ * the commit records are written alternately (sequence % 2), the valid record with greater sequence is the current one
+ */
+class CheckpointHeader
+{
+public:
+	char magic[4];
+	std::uint32_t version;
+	std::uint32_t quantityOfFields;
+	std::uint32_t sizeOfRecord;
+	std::uint64_t quantityOfCases;
+	std::uint64_t fingerprint;
+	CommitRecord commitRecord[2];
+};
+/*!
+ * \brief The CheckpointFile class
+ * memory-mapped file of results of long batch run which can be resumed after the process was stopped.
+ * The cases are solved in chunks, the results are written directly into the file
+ * and the quantity of cases solved without gaps from the beginning is committed periodically:
+ * first the results are synchronized with disk, then the commit record.
+ * The fingerprint of cases and options is checked when the file is resumed,
+ * the committed cases are not solved again.
+ * Without path the results are kept in anonymous shared memory, which is seen by the forked processes
+ * (see ShardedRunner), and the commits are not synchronized (POSIX only)
+ * \author Łukasz Dyraga
+ * \version 1.0
+ */
+class CheckpointFile
+{
+public:
+	CheckpointFile(const std::string &path, const std::uint64_t &quantityOfCases, const std::uint64_t &fingerprint,
+		const bool &isResumed);
+	CheckpointFile(const CheckpointFile &) = delete;
+	CheckpointFile& operator=(const CheckpointFile &) = delete;
+	~CheckpointFile();
+	std::vector<OutputData> solve(const BatchRunner &runner, std::vector<BatchCase> &cases,
+		SolverStatistics *statistics = nullptr);
+	void setResult(const std::uint64_t &index, const OutputData &result);
+	OutputData getResult(const std::uint64_t &index) const;
+	std::vector<OutputData> getResults() const;
+	void commit(const std::uint64_t &quantityOfCommittedCases);
+	std::uint64_t getQuantityOfCommittedCases() const;
+	std::uint64_t getQuantityOfCases() const;
+	static std::uint64_t getFingerprint(const std::vector<BatchCase> &cases, const BatchOptions &options);
+    /*!
+     * \brief quantity of cases solved by one thread at once
+     */
+	std::uint64_t quantityOfCasesInChunk{ 4096 };
+    /*!
+     * \brief minimum time between commits [s], the last commit is always made
+     */
+	double intervalOfCommits{ 1.0 };
+    /*!
+     * \brief if not null the results of completed chunks are also published into this ring buffer
+     */
+	ResultRing *stream{ nullptr };
+    /*!
+     * \brief size of header, the records start at the next page
+     */
+	static const size_t sizeOfHeader{ 4096 };
+private:
+	const CommitRecord* findCommitRecord() const;
+	void synchronize(const size_t &offset, const size_t &size);
+	static std::uint64_t getChecksum(const CommitRecord &record, const std::uint64_t &fingerprint);
+	std::string path;
+	int file;
+	char *memory;
+	size_t sizeOfMemory;
+	CheckpointHeader *header;
+	ResultRecord *records;
+};
+/*!
+ * \brief The ChunkProgress class
+ * divides the cases which are not committed yet into chunks of CheckpointFile::quantityOfCasesInChunk cases
+ * and commits the checkpoint when the chunks are completed without gaps
+ * and at least CheckpointFile::intervalOfCommits passed since the last commit (the last chunk is always committed),
+ * the results of completed chunk are published into CheckpointFile::stream,
+ * the chunks can be completed in any order, the object is not thread safe
+ */
+class ChunkProgress
+{
+public:
+	explicit ChunkProgress(CheckpointFile &checkpoint);
+	std::uint64_t getQuantityOfChunks() const;
+	std::uint64_t getBeginOf(const std::uint64_t &chunk) const;
+	std::uint64_t getEndOf(const std::uint64_t &chunk) const;
+	void complete(const std::uint64_t &chunk);
+private:
+	CheckpointFile *checkpoint;
+    /*!
+     * \brief first case of the first chunk
+     */
+	std::uint64_t firstCase;
+	std::uint64_t sizeOfChunk;
+	std::uint64_t quantityOfChunks;
+    /*!
+     * \brief quantity of chunks completed without gaps
+     */
+	std::uint64_t completedChunks;
+	std::vector<char> isChunkCompleted;
+	std::chrono::steady_clock::time_point timeOfCommit;
+};
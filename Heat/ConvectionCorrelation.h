@@ -0,0 +1,152 @@
+#pragma once
+#include "Dual.h"
+#include "NaturalConvection.h"
+#include "Power.h"
+#include "SolverStatistics.h"
+#include <cmath>
+/*!
+ * \file ConvectionCorrelation.h
+ * \brief
+ * correlations of convection as policy types, the Nusselt number is calculated for any number type
+ * (double, float or Dual), so HeatTransferSolver and HeatTransferModel use the same correlations,
+ * the forced convection policies store the constants of Nusselt number Nu = C Re^A Pr^B
+ * (the exponents A and B are the types of Power.h, so their kernels are chosen at compile time),
+ * their type is set into InputData by InputData::setForcedConvectionCorrelation
+ * and they are the template parameters of initial values of HeatTransferSolver,
+ * the natural convection policies calculate the Nusselt number of air around the pipe
+ * and are the template parameters of residual evaluation of HeatTransferSolver,
+ * so the solver chooses the correlations once per solve instead of on each evaluation
+ * \author Łukasz Dyraga
+ * \version 1.0
+ */
+
+/*!
+ * \brief
+ * forced convection Nu = C Re^A Pr^B, the base of forced convection policies,
+ * the constants and the type of forced convection are taken from Correlation
+ */
+template<class Correlation>
+class ForcedConvection
+{
+public:
+	/*!
+	 * \brief calculates the Nusselt number
+	 * \param reynolds Reynolds number of liquid
+	 * \param prandtl Prandtl number of liquid
+	 * \return value of Nusselt number
+	 */
+	template<class T>
+	static T getNusseltNumber(const T &reynolds, const T &prandtl)
+	{
+		return Correlation::C * Correlation::A::getPowerOf(reynolds)*Correlation::B::getPowerOf(prandtl);
+	}
+};
+/*!
+ * \brief Dittus-Boelter equation for heated liquid of low viscosity (forced convection type 0)
+ */
+class DittusBoelterHeating : public ForcedConvection<DittusBoelterHeating>
+{
+public:
+	static constexpr int type{ 0 };
+	static constexpr double C{ 0.023 };
+	typedef Exponent<4, 5> A;
+	typedef Exponent<2, 5> B;
+};
+/*!
+ * \brief Sieder-Tate equation for liquid of high viscosity (forced convection type 1), the wall viscosity term is omitted
+ */
+class SiederTate : public ForcedConvection<SiederTate>
+{
+public:
+	static constexpr int type{ 1 };
+	static constexpr double C{ 0.027 };
+	typedef Exponent<4, 5> A;
+	typedef Exponent<33, 100> B;
+};
+/*!
+ * \brief flow perpendicular to the pipe (forced convection type 2)
+ */
+class CrossFlow : public ForcedConvection<CrossFlow>
+{
+public:
+	static constexpr int type{ 2 };
+	static constexpr double C{ 0.283 };
+	typedef Exponent<3, 5> A;
+	typedef Exponent<31, 100> B;
+};
+/*!
+ * \brief Dittus-Boelter equation for cooled liquid of low viscosity (forced convection type 3)
+ */
+class DittusBoelterCooling : public ForcedConvection<DittusBoelterCooling>
+{
+public:
+	static constexpr int type{ 3 };
+	static constexpr double C{ 0.023 };
+	typedef Exponent<4, 5> A;
+	typedef Exponent<3, 10> B;
+};
+/*!
+ * \brief
+ * natural convection Nu = C (Gr Pr)^A with the parameters of regime of flow
+ * taken from NaturalConvection (natural convection type 0),
+ * the regime is chosen at run time and each regime has its exponent kernel
+ */
+class SimplifiedNaturalConvection
+{
+public:
+	typedef Exponent<0, 1> ExponentOfNoFlow;
+	typedef Exponent<1, 8> ExponentOfLaminarFlow;
+	typedef Exponent<1, 4> ExponentOfTransitionalFlow;
+	typedef Exponent<33, 100> ExponentOfTurbulentFlow;
+	static_assert(ExponentOfNoFlow::value == NaturalConvection::regimes[0].A
+		&& ExponentOfLaminarFlow::value == NaturalConvection::regimes[1].A
+		&& ExponentOfTransitionalFlow::value == NaturalConvection::regimes[2].A
+		&& ExponentOfTurbulentFlow::value == NaturalConvection::regimes[3].A,
+		"exponents of regimes differ from NaturalConvection::regimes");
+	/*!
+	 * \brief calculates the Nusselt number
+	 * \param productOfGrAndPr product of Grashof number and Prandtl number
+	 * \return value of Nusselt number
+	 */
+	template<class T>
+	static T getNusseltNumber(const T &productOfGrAndPr, const T &)
+	{
+		int indexOfRegime = NaturalConvection::getIndexOfRegime(valueOf(productOfGrAndPr));
+		HEAT_COUNT(regimeSelections[indexOfRegime]);
+		const NaturalConvectionRegime &regime = NaturalConvection::regimes[indexOfRegime];
+		switch (indexOfRegime) {
+		case 0:
+			return regime.C*ExponentOfNoFlow::getPowerOf(productOfGrAndPr);
+		case 1:
+			return regime.C*ExponentOfLaminarFlow::getPowerOf(productOfGrAndPr);
+		case 2:
+			return regime.C*ExponentOfTransitionalFlow::getPowerOf(productOfGrAndPr);
+		default:
+			return regime.C*ExponentOfTurbulentFlow::getPowerOf(productOfGrAndPr);
+		}
+	}
+};
+/*!
+ * \brief
+ * Churchill-Chu equation for horizontal cylinder (natural convection type 1):
+ * Nu = (0.60 + 0.387 Ra^(1/6) / (1 + (0.559/Pr)^(9/16))^(8/27))^2,
+ * the absolute value of Rayleigh number is used when the isolator is colder than environment
+ */
+class ChurchillChuNaturalConvection
+{
+public:
+	/*!
+	 * \brief calculates the Nusselt number
+	 * \param productOfGrAndPr product of Grashof number and Prandtl number (Rayleigh number)
+	 * \param prandtl Prandtl number of air
+	 * \return value of Nusselt number
+	 */
+	template<class T>
+	static T getNusseltNumber(const T &productOfGrAndPr, const T &prandtl)
+	{
+		T rayleigh = valueOf(productOfGrAndPr) < 0 ? -productOfGrAndPr : productOfGrAndPr;
+		T denominator = Exponent<8, 27>::getPowerOf(1 + Exponent<9, 16>::getPowerOf(0.559 / prandtl));
+		T root = 0.60 + 0.387*Exponent<1, 6>::getPowerOf(rayleigh) / denominator;
+		return root * root;
+	}
+};
@@ -0,0 +1,142 @@
+#pragma once
+#include <array>
+#include <math.h>
+/*!
+ * \brief The Dual class
+ * multi-component dual number used by forward-mode automatic differentiation,
+ * stores the value and its derivatives with respect to Quantity variables
+ * \author Łukasz Dyraga
+ * \version 1.0
+ */
+template<int Quantity>
+class Dual
+{
+public:
+	Dual(): value{0}, derivative{} {}
+	Dual(const double &value): value{value}, derivative{} {}
+    /*!
+     * \brief creates the variable: its derivative with respect to itself is 1
+     * \param value value of variable
+     * \param index index of variable
+     */
+	static Dual variable(const double &value, const int &index)
+	{
+		Dual result{ value };
+		result.derivative[index] = 1;
+		return result;
+	}
+	double value;
+	std::array<double, Quantity> derivative;
+	Dual& operator+=(const Dual &other)
+	{
+		value += other.value;
+		for (int i = 0; i < Quantity; ++i) { derivative[i] += other.derivative[i]; }
+		return *this;
+	}
+	Dual& operator-=(const Dual &other)
+	{
+		value -= other.value;
+		for (int i = 0; i < Quantity; ++i) { derivative[i] -= other.derivative[i]; }
+		return *this;
+	}
+	Dual& operator*=(const Dual &other)
+	{
+		for (int i = 0; i < Quantity; ++i) { derivative[i] = derivative[i] * other.value + value * other.derivative[i]; }
+		value *= other.value;
+		return *this;
+	}
+	Dual& operator/=(const Dual &other)
+	{
+		double quotient = value / other.value;
+		for (int i = 0; i < Quantity; ++i) { derivative[i] = (derivative[i] - quotient * other.derivative[i]) / other.value; }
+		value = quotient;
+		return *this;
+	}
+};
+
+template<int Quantity>
+Dual<Quantity> operator+(Dual<Quantity> first, const Dual<Quantity> &second) { return first += second; }
+template<int Quantity>
+Dual<Quantity> operator-(Dual<Quantity> first, const Dual<Quantity> &second) { return first -= second; }
+template<int Quantity>
+Dual<Quantity> operator*(Dual<Quantity> first, const Dual<Quantity> &second) { return first *= second; }
+template<int Quantity>
+Dual<Quantity> operator/(Dual<Quantity> first, const Dual<Quantity> &second) { return first /= second; }
+template<int Quantity>
+Dual<Quantity> operator+(Dual<Quantity> first, const double &second) { first.value += second; return first; }
+template<int Quantity>
+Dual<Quantity> operator+(const double &first, Dual<Quantity> second) { second.value += first; return second; }
+template<int Quantity>
+Dual<Quantity> operator-(Dual<Quantity> first, const double &second) { first.value -= second; return first; }
+template<int Quantity>
+Dual<Quantity> operator-(const double &first, const Dual<Quantity> &second) { return Dual<Quantity>{ first } -= second; }
+template<int Quantity>
+Dual<Quantity> operator-(Dual<Quantity> dual)
+{
+	dual.value = -dual.value;
+	for (auto &derivative : dual.derivative) { derivative = -derivative; }
+	return dual;
+}
+template<int Quantity>
+Dual<Quantity> operator*(Dual<Quantity> first, const double &second)
+{
+	first.value *= second;
+	for (auto &derivative : first.derivative) { derivative *= second; }
+	return first;
+}
+template<int Quantity>
+Dual<Quantity> operator*(const double &first, const Dual<Quantity> &second) { return second * first; }
+template<int Quantity>
+Dual<Quantity> operator/(const Dual<Quantity> &first, const double &second) { return first * (1 / second); }
+template<int Quantity>
+Dual<Quantity> operator/(const double &first, const Dual<Quantity> &second) { return Dual<Quantity>{ first } /= second; }
+/*!
+ * \brief calculates the natural logarithm of dual number
+ */
+template<int Quantity>
+Dual<Quantity> log(Dual<Quantity> dual)
+{
+	for (auto &derivative : dual.derivative) { derivative /= dual.value; }
+	dual.value = ::log(dual.value);
+	return dual;
+}
+/*!
+ * \brief calculates the square root of dual number
+ */
+template<int Quantity>
+Dual<Quantity> sqrt(Dual<Quantity> dual)
+{
+	double result = ::sqrt(dual.value);
+	for (auto &derivative : dual.derivative) { derivative /= 2 * result; }
+	dual.value = result;
+	return dual;
+}
+/*!
+ * \brief calculates the cube root of dual number
+ */
+template<int Quantity>
+Dual<Quantity> cbrt(Dual<Quantity> dual)
+{
+	double result = ::cbrt(dual.value);
+	for (auto &derivative : dual.derivative) { derivative /= 3 * result*result; }
+	dual.value = result;
+	return dual;
+}
+/*!
+ * \brief calculates the power of dual number with constant exponent
+ */
+template<int Quantity>
+Dual<Quantity> pow(Dual<Quantity> base, const double &exponent)
+{
+	double result = ::pow(base.value, exponent);
+	double derivativeOfPower = exponent == 0 ? 0 : exponent * ::pow(base.value, exponent - 1);
+	for (auto &derivative : base.derivative) { derivative *= derivativeOfPower; }
+	base.value = result;
+	return base;
+}
+/*!
+ * \brief returns the value of number without derivatives
+ */
+inline double valueOf(const double &number) { return number; }
+template<int Quantity>
+double valueOf(const Dual<Quantity> &number) { return number.value; }
@@ -0,0 +1,44 @@
+#include "FluidLibrary.h"
+#include <stdexcept>
+
+const int FluidLibrary::quantityOfLiquids;
+const char *const FluidLibrary::fileNamesOfLiquids[FluidLibrary::quantityOfLiquids]{
+	"water.txt",
+	"engine_oil_unused.txt",
+	"glycerin.txt",
+	"isobutane.txt",
+	"methanol.txt"
+};
+/*!
+ * \brief constructor, loads the properties of all liquids and of air
+ * \param directory directory which stores the files with properties, ended with '/'
+ */
+FluidLibrary::FluidLibrary(const std::string &directory):
+	airProperties{ directory + "air.txt" }
+{
+	liquids.reserve(quantityOfLiquids);
+	for (int i = 0; i < quantityOfLiquids; ++i) {
+		liquids.emplace_back(directory + fileNamesOfLiquids[i]);
+	}
+}
+/*!
+ * \brief returns the properties of liquid
+ * \param typeOfLiquid index of liquid
+ * \throw std::out_of_range if there is no liquid with that index
+ * \return properties of liquid
+ */
+const ThermalProperties& FluidLibrary::liquid(const int &typeOfLiquid) const
+{
+	if (typeOfLiquid < 0 || typeOfLiquid >= quantityOfLiquids) {
+		throw std::out_of_range("Unknown type of liquid.");
+	}
+	return liquids[typeOfLiquid];
+}
+/*!
+ * \brief returns the properties of air
+ * \return properties of air
+ */
+const ThermalProperties& FluidLibrary::air() const
+{
+	return airProperties;
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include "ThermalProperties.h"
+#include <string>
+#include <vector>
+/*!
+ * \brief The FluidLibrary class
+ * loads the properties of all liquids and of air only once,
+ * so many cases can be solved without reading the files again,
+ * the index of liquid is the same as in the test data file:
+ * 0-water, 1-engine oil, 2-glycerin, 3-isobutane, 4-methanol
+ * \author Łukasz Dyraga
+ * \version 1.0
+ */
+class FluidLibrary
+{
+public:
+	explicit FluidLibrary(const std::string &directory = "fluids_properties/");
+	const ThermalProperties& liquid(const int &typeOfLiquid) const;
+	const ThermalProperties& air() const;
+    /*!
+     * \brief quantity of liquids
+     */
+	static const int quantityOfLiquids{ 5 };
+    /*!
+     * \brief names of files which store the properties of liquids
+     */
+	static const char *const fileNamesOfLiquids[quantityOfLiquids];
+private:
+    /*!
+     * \brief properties of all liquids
+     */
+	std::vector<ThermalProperties> liquids;
+    /*!
+     * \brief properties of air
+     */
+	ThermalProperties airProperties;
+};
@@ -33,8 +33,11 @@ SOURCES += \
     HeatTransferSolver.cpp \
     NaturalConvection.cpp \
     InputData.cpp \
+    LayerStack.cpp \
     Interpolation.cpp \
     OutputData.cpp \
+    SolverStatistics.cpp \
+    TraceRecorder.cpp \
     ThermalProperties.cpp \
     tableoffluids.cpp \
     xmlwriter.cpp
@@ -42,11 +45,18 @@ SOURCES += \
 HEADERS += \
         mainwindow.h \
     HeatTransferSolver.h \
+    HeatTransferEquations.h \
+    Power.h \
     Interpolation.h \
     ThermalProperties.h \
     NaturalConvection.h \
+    ConvectionCorrelation.h \
     InputData.h \
+    LayerStack.h \
+    MathConstants.h \
     OutputData.h \
+    SolverStatistics.h \
+    TraceRecorder.h \
     tableoffluids.h \
     xmlwriter.h
 
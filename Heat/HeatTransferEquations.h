@@ -0,0 +1,136 @@
+#pragma once
+#include "MathConstants.h"
+#include "Power.h"
+#include <math.h>
+/*!
+ * \brief The HeatTransferEquations class
+ * the equations of heat transfer written for any number type, they are the only source of physics of
+ * HeatTransferSolver (double) and HeatTransferModel (float and dual numbers),
+ * the properties of liquid and air are looked up by the caller,
+ * the quotients which may divide by zero are calculated by the quotient function of caller
+ * (HeatTransferSolver sets the status of results there)
+ * \author Łukasz Dyraga
+ * \version 1.0
+ */
+class HeatTransferEquations
+{
+public:
+	template<class Forced, class T>
+	static T getConvectionCoefficient1(const T &meanVelocityOfLiquid, const T &innerDiameterOfPipe, const T &viscosity,
+		const T &prandtl, const T &conductivity);
+	template<class T>
+	static T getResistanceOfThermalConduction(const T &outerDiameterOfPipe, const T &overallDiameterOfPipe,
+		const T &thermalConductivityOfIsolator, const T &lengthOfPipe);
+	template<class T>
+	static T getResistanceOfThermalPenetration(const T &convectionCoefficient1, const T &innerDiameterOfPipe);
+	template<class T, class Quotient>
+	static T getHeatFlow1(const T &meanTemperatureOfLiquid, const T &temperatureOnIsolator,
+		const T &resistanceOfThermalConduction, const T &resistanceOfThermalPenetration, const Quotient &quotient);
+	template<class T>
+	static T getHeatFlow2(const T &coefficient2, const T &overallDiameterOfPipe, const T &temperatureOnIsolator,
+		const T &temperatureOfEnvironment);
+	template<class T>
+	static T getRadiationCoefficient2(const T &ratioOfRadiantEnergyExchange, const T &temperatureOnIsolator,
+		const T &temperatureOfEnvironment, const double &StefanBoltzmannConstant);
+	template<class T, class Quotient>
+	static T getConvectionCoefficient2(const T &nusseltNumber, const T &conductivityOfAir, const T &overallDiameterOfPipe,
+		const Quotient &quotient);
+	template<class T, class Quotient>
+	static T getGrashofNumber(const T &temperatureOnIsolator, const T &temperatureOfEnvironment,
+		const T &overallDiameterOfPipe, const T &viscosityOfAir, const double &accelerationOfGravity, const Quotient &quotient);
+};
+/*!
+ * \brief
+ * calculates the convection coefficient 1 from the Nusselt number of forced convection,
+ * the properties of liquid are taken at the mean temperature of liquid
+ * \tparam Forced correlation of forced convection, see ConvectionCorrelation.h
+ * \param viscosity kinematic viscosity of liquid
+ * \param prandtl Prandtl number of liquid
+ * \param conductivity thermal conductivity of liquid
+ * \return value of convection coefficient 1
+ */
+template<class Forced, class T>
+T HeatTransferEquations::getConvectionCoefficient1(const T &meanVelocityOfLiquid, const T &innerDiameterOfPipe,
+	const T &viscosity, const T &prandtl, const T &conductivity)
+{
+	T reynolds = (meanVelocityOfLiquid*innerDiameterOfPipe) / viscosity;
+	T nusselt = Forced::getNusseltNumber(reynolds, prandtl);
+	return (nusselt*conductivity) / innerDiameterOfPipe;
+}
+/*!
+ * \brief calculates the resistance of thermal conduction of single isolator
+ */
+template<class T>
+T HeatTransferEquations::getResistanceOfThermalConduction(const T &outerDiameterOfPipe, const T &overallDiameterOfPipe,
+	const T &thermalConductivityOfIsolator, const T &lengthOfPipe)
+{
+	T numerator = log(overallDiameterOfPipe / outerDiameterOfPipe);
+	T denominator = 2 * numberPi*thermalConductivityOfIsolator * lengthOfPipe;
+	return numerator / denominator;
+}
+/*!
+ * \brief calculates the resistance of thermal penetration
+ */
+template<class T>
+T HeatTransferEquations::getResistanceOfThermalPenetration(const T &convectionCoefficient1, const T &innerDiameterOfPipe)
+{
+	return 1.0 / (convectionCoefficient1*numberPi*innerDiameterOfPipe);
+}
+/*!
+ * \brief calculates the heat flow 1 flowing from liquid into the surface of isolator
+ */
+template<class T, class Quotient>
+T HeatTransferEquations::getHeatFlow1(const T &meanTemperatureOfLiquid, const T &temperatureOnIsolator,
+	const T &resistanceOfThermalConduction, const T &resistanceOfThermalPenetration, const Quotient &quotient)
+{
+	return quotient(meanTemperatureOfLiquid - temperatureOnIsolator,
+		resistanceOfThermalConduction + resistanceOfThermalPenetration);
+}
+/*!
+ * \brief calculates the heat flow 2 flowing away from the surface of isolator
+ * \param coefficient2 radiation coefficient 2, convection coefficient 2 or their sum
+ * \return heat flow by radiation, by convection or the whole heat flow 2
+ */
+template<class T>
+T HeatTransferEquations::getHeatFlow2(const T &coefficient2, const T &overallDiameterOfPipe, const T &temperatureOnIsolator,
+	const T &temperatureOfEnvironment)
+{
+	return numberPi * overallDiameterOfPipe*coefficient2*(temperatureOnIsolator - temperatureOfEnvironment);
+}
+/*!
+ * \brief
+ * calculates the radiation coefficient 2,
+ * the difference of fourth powers divided by difference of temperatures is factored:
+ * (a^4-b^4)/(100(a-b)) = (a^2+b^2)(a+b)/100, so it is not calculated by pow and not divided by 0
+ */
+template<class T>
+T HeatTransferEquations::getRadiationCoefficient2(const T &ratioOfRadiantEnergyExchange, const T &temperatureOnIsolator,
+	const T &temperatureOfEnvironment, const double &StefanBoltzmannConstant)
+{
+	T a = temperatureOnIsolator / 100.0;
+	T b = temperatureOfEnvironment / 100.0;
+	return ratioOfRadiantEnergyExchange * StefanBoltzmannConstant*(a*a + b * b)*(a + b) / 100.0;
+}
+/*!
+ * \brief calculates the convection coefficient 2 from the Nusselt number of natural convection, see ConvectionCorrelation.h
+ */
+template<class T, class Quotient>
+T HeatTransferEquations::getConvectionCoefficient2(const T &nusseltNumber, const T &conductivityOfAir,
+	const T &overallDiameterOfPipe, const Quotient &quotient)
+{
+	return quotient(nusseltNumber*conductivityOfAir, overallDiameterOfPipe);
+}
+/*!
+ * \brief calculates the Grashof number of air around the isolator
+ * \param viscosityOfAir kinematic viscosity of air at the mean temperature of isolator and environment
+ */
+template<class T, class Quotient>
+T HeatTransferEquations::getGrashofNumber(const T &temperatureOnIsolator, const T &temperatureOfEnvironment,
+	const T &overallDiameterOfPipe, const T &viscosityOfAir, const double &accelerationOfGravity, const Quotient &quotient)
+{
+	T beta = 2.0 / (temperatureOnIsolator + temperatureOfEnvironment);
+	T numerator = accelerationOfGravity * beta;
+	numerator *= (temperatureOnIsolator - temperatureOfEnvironment);
+	numerator *= getPowerOf<3>(overallDiameterOfPipe);
+	return quotient(numerator, getPowerOf<2>(viscosityOfAir));
+}
@@ -0,0 +1,295 @@
+#pragma once
+#include "HeatTransferEquations.h"
+#include "ConvectionCorrelation.h"
+#include "InputData.h"
+#include "Interpolation.h"
+#include "OutputData.h"
+#include "ThermalProperties.h"
+#include "Dual.h"
+/*!
+ * \brief The HeatTransferModel class
+ * the model of HeatTransferSolver for any number type, the equations are taken from HeatTransferEquations,
+ * used with dual numbers it calculates the derivatives of results with respect to input values,
+ * used with float it is the single precision part of MixedPrecisionSolver,
+ * the input values are copied from InputData and can be replaced by variables before calculateTheRemainingData,
+ * the correlation of natural convection is chosen once by the caller of the templated functions (...With<Natural>),
+ * the other functions choose it from InputData on every call; the layers are not taken into account
+ * \author Łukasz Dyraga
+ * \version 1.0
+ */
+template<class T>
+class HeatTransferModel
+{
+public:
+	HeatTransferModel(const InputData &data, const ThermalProperties &liquid, const ThermalProperties &air);
+	void calculateTheRemainingData();
+	void calculateInitialValues();
+	T getHeatFlow1(const T &temperatureOnIsolator);
+	T getHeatFlow2(const T &temperatureOnIsolator);
+	template<class Natural>
+	T getHeatFlow2With(const T &temperatureOnIsolator);
+	T getDifferenceOfHeatFlows(const T &temperatureOnIsolator);
+	template<class Natural>
+	T getDifferenceOfHeatFlowsWith(const T &temperatureOnIsolator);
+	T getRadiationCoefficient2(const T &temperatureOnIsolator);
+	T getConvectionCoefficient2(const T &temperatureOnIsolator);
+	template<class Natural>
+	T getConvectionCoefficient2With(const T &temperatureOnIsolator);
+	T getGrashofNumber(const T &temperatureOnIsolator, const T &viscosityOfAir);
+	void getResults(const T &temperatureOnIsolator, T *values);
+	template<class Natural>
+	void getResultsWith(const T &temperatureOnIsolator, T *values);
+	T getQuotient(const T &numerator, const T &denominator);
+	//Input values
+	T innerDiameterOfPipe;
+	T thicknessOfPipe;
+	T meanVelocityOfLiquid;
+	T meanTemperatureOfLiquid;
+	T thermalConductivityOfIsolator;
+	T thicknessOfIsolator;
+	T temperatureOfEnvironment;
+	T emissivityOfIsolator;
+	T lengthOfPipe;
+	//Calculated values
+	T outerDiameterOfPipe;
+	T overallDiameterOfPipe;
+	T ratioOfRadiantEnergyExchange;
+	T convectionCoefficient1;
+	T resistanceOfThermalConduction;
+	T resistanceOfThermalPenetration;
+    /*!
+     * \brief true after getQuotient divided by zero, it is reset by the user of model (as the status of HeatTransferSolver)
+     */
+	bool isDividedByZero;
+private:
+    /*!
+     * \brief quotient function passed to HeatTransferEquations, isDividedByZero is set by getQuotient
+     */
+	class Quotient
+	{
+	public:
+		HeatTransferModel *model;
+		T operator()(const T &numerator, const T &denominator) const
+		{
+			return model->getQuotient(numerator, denominator);
+		}
+	};
+    /*!
+     * \brief input data, the constant values are taken from it
+     */
+	const InputData *data;
+	const ThermalProperties *liquid;
+	const ThermalProperties *air;
+	Interpolation interpolation;
+	template<class Forced>
+	void calculateInitialValuesWith();
+};
+/*!
+ * \brief constructor, copies the input values
+ * \param data input data
+ * \param liquid properties of liquid, they have to outlive the model
+ * \param air properties of air, they have to outlive the model
+ */
+template<class T>
+HeatTransferModel<T>::HeatTransferModel(const InputData &data, const ThermalProperties &liquid, const ThermalProperties &air):
+	innerDiameterOfPipe(data.innerDiameterOfPipe),thicknessOfPipe(data.thicknessOfPipe),
+	meanVelocityOfLiquid(data.meanVelocityOfLiquid),meanTemperatureOfLiquid(data.meanTemperatureOfLiquid),
+	thermalConductivityOfIsolator(data.thermalConductivityOfIsolator),thicknessOfIsolator(data.thicknessOfIsolator),
+	temperatureOfEnvironment(data.temperatureOfEnvironment),emissivityOfIsolator(data.emissivityOfIsolator),
+	lengthOfPipe(data.lengthOfPipe),isDividedByZero{false},data{&data},liquid{&liquid},air{&air},interpolation{}
+{
+}
+/*!
+ * \brief calculates the geometry parameters and radiant energy exchange value, see InputData
+ */
+template<class T>
+void HeatTransferModel<T>::calculateTheRemainingData()
+{
+	outerDiameterOfPipe = innerDiameterOfPipe + 2.0 * thicknessOfPipe;
+	overallDiameterOfPipe = outerDiameterOfPipe + 2.0 * thicknessOfIsolator;
+	T quotientOfArea = outerDiameterOfPipe / overallDiameterOfPipe;
+	T radiantRatio = 1.0 / emissivityOfIsolator + quotientOfArea * ((1 / data->emissivityOfEnvironment) - 1);
+	ratioOfRadiantEnergyExchange = 1.0 / radiantRatio;
+}
+/*!
+ * \brief calculates convection coefficient 1, thermal conduction and thermal penetration, see HeatTransferSolver
+ */
+template<class T>
+void HeatTransferModel<T>::calculateInitialValues()
+{
+	switch (data->typeOfForcedConvection) {
+	case 1:
+		calculateInitialValuesWith<SiederTate>();
+		break;
+	case 2:
+		calculateInitialValuesWith<CrossFlow>();
+		break;
+	case 3:
+		calculateInitialValuesWith<DittusBoelterCooling>();
+		break;
+	default:
+		calculateInitialValuesWith<DittusBoelterHeating>();
+		break;
+	}
+}
+/*!
+ * \brief calculates the initial values, see calculateInitialValues
+ * \tparam Forced correlation of forced convection, see ConvectionCorrelation.h
+ */
+template<class T>
+template<class Forced>
+void HeatTransferModel<T>::calculateInitialValuesWith()
+{
+	T viscosity = interpolation.calculateAt(meanTemperatureOfLiquid, liquid->temperature, liquid->kinematicViscosity);
+	T prandtl = interpolation.calculateAt(meanTemperatureOfLiquid, liquid->temperature, liquid->prandtlNumber);
+	T conductivity = interpolation.calculateAt(meanTemperatureOfLiquid, liquid->temperature, liquid->thermalConductivity);
+	convectionCoefficient1 = HeatTransferEquations::getConvectionCoefficient1<Forced>(meanVelocityOfLiquid,
+		innerDiameterOfPipe, viscosity, prandtl, conductivity);
+	resistanceOfThermalConduction = HeatTransferEquations::getResistanceOfThermalConduction(outerDiameterOfPipe,
+		overallDiameterOfPipe, thermalConductivityOfIsolator, lengthOfPipe);
+	resistanceOfThermalPenetration = HeatTransferEquations::getResistanceOfThermalPenetration(convectionCoefficient1,
+		innerDiameterOfPipe);
+}
+template<class T>
+T HeatTransferModel<T>::getHeatFlow1(const T &temperatureOnIsolator)
+{
+	return HeatTransferEquations::getHeatFlow1(meanTemperatureOfLiquid, temperatureOnIsolator,
+		resistanceOfThermalConduction, resistanceOfThermalPenetration, Quotient{ this });
+}
+template<class T>
+T HeatTransferModel<T>::getHeatFlow2(const T &temperatureOnIsolator)
+{
+	switch (data->typeOfNaturalConvection) {
+	case 1:
+		return getHeatFlow2With<ChurchillChuNaturalConvection>(temperatureOnIsolator);
+	default:
+		return getHeatFlow2With<SimplifiedNaturalConvection>(temperatureOnIsolator);
+	}
+}
+/*!
+ * \brief calculates the heat flow 2, see getHeatFlow2
+ * \tparam Natural correlation of natural convection, see ConvectionCorrelation.h
+ */
+template<class T>
+template<class Natural>
+T HeatTransferModel<T>::getHeatFlow2With(const T &temperatureOnIsolator)
+{
+	return HeatTransferEquations::getHeatFlow2(getRadiationCoefficient2(temperatureOnIsolator) +
+		getConvectionCoefficient2With<Natural>(temperatureOnIsolator), overallDiameterOfPipe, temperatureOnIsolator,
+		temperatureOfEnvironment);
+}
+template<class T>
+T HeatTransferModel<T>::getDifferenceOfHeatFlows(const T &temperatureOnIsolator)
+{
+	switch (data->typeOfNaturalConvection) {
+	case 1:
+		return getDifferenceOfHeatFlowsWith<ChurchillChuNaturalConvection>(temperatureOnIsolator);
+	default:
+		return getDifferenceOfHeatFlowsWith<SimplifiedNaturalConvection>(temperatureOnIsolator);
+	}
+}
+/*!
+ * \brief calculates the difference between heat flow 2 and heat flow 1, see getDifferenceOfHeatFlows
+ * \tparam Natural correlation of natural convection, see ConvectionCorrelation.h
+ */
+template<class T>
+template<class Natural>
+T HeatTransferModel<T>::getDifferenceOfHeatFlowsWith(const T &temperatureOnIsolator)
+{
+	return getHeatFlow2With<Natural>(temperatureOnIsolator) - getHeatFlow1(temperatureOnIsolator);
+}
+template<class T>
+T HeatTransferModel<T>::getRadiationCoefficient2(const T &temperatureOnIsolator)
+{
+	return HeatTransferEquations::getRadiationCoefficient2(ratioOfRadiantEnergyExchange, temperatureOnIsolator,
+		temperatureOfEnvironment, data->StefanBoltzmannConstant);
+}
+template<class T>
+T HeatTransferModel<T>::getConvectionCoefficient2(const T &temperatureOnIsolator)
+{
+	switch (data->typeOfNaturalConvection) {
+	case 1:
+		return getConvectionCoefficient2With<ChurchillChuNaturalConvection>(temperatureOnIsolator);
+	default:
+		return getConvectionCoefficient2With<SimplifiedNaturalConvection>(temperatureOnIsolator);
+	}
+}
+/*!
+ * \brief calculates the convection coefficient 2, see getConvectionCoefficient2
+ * \tparam Natural correlation of natural convection, see ConvectionCorrelation.h
+ */
+template<class T>
+template<class Natural>
+T HeatTransferModel<T>::getConvectionCoefficient2With(const T &temperatureOnIsolator)
+{
+	T meanTemperature = 0.5*(temperatureOnIsolator + temperatureOfEnvironment);
+	T conductivityAir = interpolation.calculateAt(meanTemperature, air->temperature, air->thermalConductivity);
+	T prandtlAir = interpolation.calculateAt(meanTemperature, air->temperature, air->prandtlNumber);
+	T viscosityAir = interpolation.calculateAt(meanTemperature, air->temperature, air->kinematicViscosity);
+	T product = getGrashofNumber(temperatureOnIsolator, viscosityAir)*prandtlAir;
+	T nusselt = Natural::getNusseltNumber(product, prandtlAir);
+	return HeatTransferEquations::getConvectionCoefficient2(nusselt, conductivityAir, overallDiameterOfPipe, Quotient{ this });
+}
+template<class T>
+T HeatTransferModel<T>::getGrashofNumber(const T &temperatureOnIsolator, const T &viscosityOfAir)
+{
+	return HeatTransferEquations::getGrashofNumber(temperatureOnIsolator, temperatureOfEnvironment, overallDiameterOfPipe,
+		viscosityOfAir, data->accelerationOfGravity, Quotient{ this });
+}
+/*!
+ * \brief calculates the results in the order of OutputData::fieldNames
+ * \param temperatureOnIsolator the final value of temperature on isolator
+ * \param values place for OutputData::quantityOfFields values
+ */
+template<class T>
+void HeatTransferModel<T>::getResults(const T &temperatureOnIsolator, T *values)
+{
+	switch (data->typeOfNaturalConvection) {
+	case 1:
+		getResultsWith<ChurchillChuNaturalConvection>(temperatureOnIsolator, values);
+		break;
+	default:
+		getResultsWith<SimplifiedNaturalConvection>(temperatureOnIsolator, values);
+		break;
+	}
+}
+/*!
+ * \brief calculates the results, see getResults
+ * \tparam Natural correlation of natural convection, see ConvectionCorrelation.h
+ */
+template<class T>
+template<class Natural>
+void HeatTransferModel<T>::getResultsWith(const T &temperatureOnIsolator, T *values)
+{
+	T convectionCoefficient2 = getConvectionCoefficient2With<Natural>(temperatureOnIsolator);
+	T radiationCoefficient2 = getRadiationCoefficient2(temperatureOnIsolator);
+	values[0] = temperatureOnIsolator;
+	values[1] = convectionCoefficient1;
+	values[2] = convectionCoefficient2;
+	values[3] = radiationCoefficient2;
+	values[4] = HeatTransferEquations::getHeatFlow2(convectionCoefficient2, overallDiameterOfPipe, temperatureOnIsolator,
+		temperatureOfEnvironment);
+	values[5] = HeatTransferEquations::getHeatFlow2(radiationCoefficient2, overallDiameterOfPipe, temperatureOnIsolator,
+		temperatureOfEnvironment);
+	values[6] = getHeatFlow1(temperatureOnIsolator);
+	values[7] = values[4] + values[5];
+	values[8] = resistanceOfThermalConduction;
+	values[9] = resistanceOfThermalPenetration;
+}
+/*!
+ * \brief
+ * calculates the quotient, returns 0 if numerator or denominator is 0 (as HeatTransferSolver),
+ * isDividedByZero is set if the denominator is 0
+ */
+template<class T>
+T HeatTransferModel<T>::getQuotient(const T &numerator, const T &denominator)
+{
+	if (valueOf(denominator) == 0) {
+		isDividedByZero = true;
+		return T{ 0 };
+	}
+	if (valueOf(numerator) != 0) {
+		return numerator / denominator;
+	}
+	return T{ 0 };
+}
@@ -1,6 +1,8 @@
 #include "HeatTransferSolver.h"
+#include <algorithm>
+#include <cmath>
 
-
+const char *const HeatTransferSolver::airFilePath{ "fluids_properties/air.txt" };
 
 /*!
  * \brief constructor, sets the value of class attributes
@@ -8,12 +10,40 @@
  * \param liquid stores the properties of liquid which flows through pipe
  */
 HeatTransferSolver::HeatTransferSolver(InputData &data,ThermalProperties &liquid):
-    data{&data},liquid{&liquid},naturalTransfer{}, isWarningAlertDisplay{false}
+    data{&data},liquid{&liquid},isAirOwner{true},statusOfInitialValues{0}
 
 {
 	air = new ThermalProperties{ airFilePath };
+	HEAT_TRACE_SCOPE("construct solver", "solver");
+#ifdef HEAT_INSTRUMENTATION
+	SolverStatistics before = SolverStatistics::local();
+#endif
 	this->data->calculateTheRemainingData();//Check do u need it!
 	calculateInitialValues();
+#ifdef HEAT_INSTRUMENTATION
+	addStatistics(before, false);
+#endif
+}
+/*!
+ * \brief
+ * constructor which uses already loaded properties of air,
+ * used when many cases are solved one after another (batch runs)
+ * \param data stores the input data
+ * \param liquid stores the properties of liquid which flows through pipe
+ * \param air stores the properties of air, it has to outlive the solver
+ */
+HeatTransferSolver::HeatTransferSolver(InputData &data, const ThermalProperties &liquid, const ThermalProperties &air):
+	data{&data},liquid{&liquid},air{&air},isAirOwner{false},statusOfInitialValues{0}
+{
+	HEAT_TRACE_SCOPE("construct solver", "solver");
+#ifdef HEAT_INSTRUMENTATION
+	SolverStatistics before = SolverStatistics::local();
+#endif
+	this->data->calculateTheRemainingData();
+	calculateInitialValues();
+#ifdef HEAT_INSTRUMENTATION
+	addStatistics(before, false);
+#endif
 }
 /*!
  * \brief
@@ -24,22 +54,181 @@ HeatTransferSolver::HeatTransferSolver(InputData &data,ThermalProperties &liquid
  */
 void HeatTransferSolver::calculateInitialValues()
 {
-	calculateConvectionCoefficient1();
+	switch (data->typeOfForcedConvection) {
+	case 1:
+		calculateInitialValuesWith<SiederTate>();
+		break;
+	case 2:
+		calculateInitialValuesWith<CrossFlow>();
+		break;
+	case 3:
+		calculateInitialValuesWith<DittusBoelterCooling>();
+		break;
+	default:
+		calculateInitialValuesWith<DittusBoelterHeating>();
+		break;
+	}
+}
+/*!
+ * \brief calculates the initial values, see calculateInitialValues
+ * \tparam Forced correlation of forced convection, see ConvectionCorrelation.h
+ */
+template<class Forced>
+void HeatTransferSolver::calculateInitialValuesWith()
+{
+	HEAT_TIME_PHASE(timeOfInitialValues);
+	results.status = 0;
+	calculateConvectionCoefficient1With<Forced>();
 	calculateResistanceOfThermalConduction();
 	calculateResistanceOfThermalPenetration();
+	statusOfInitialValues = results.status;
 }
 /*!
- * \brief starts the main solving algorithm
+ * \brief
+ * starts the main solving algorithm,
+ * the status of results is set from the initial values, root finding and final values,
+ * the values evaluated while the interval is searched are not taken into account
+ * \param tolerance value of tolerance used by bisection method
  */
-void HeatTransferSolver::runTheSolver()
+void HeatTransferSolver::runTheSolver(const double &tolerance)
 {
-	std::vector<double> interval=getIntervalValues(&HeatTransferSolver::getDifferenceOfHeatFlows);
-	double temperatureOnIsolator
-		=getTheIntersectionPointOfFunction(&HeatTransferSolver::getDifferenceOfHeatFlows, interval[0], interval[1]);
+#ifdef HEAT_INSTRUMENTATION
+	SolverStatistics before = SolverStatistics::local();
+#endif
+	HEAT_TRACE_SCOPE("solve", "solver");
+	results.status = statusOfInitialValues;
+	double temperatureOnIsolator;
+	switch (data->typeOfNaturalConvection) {
+	case 1://the interval search evaluates this correlation far from the solution, the physical interval is used instead
+		temperatureOnIsolator = findTemperatureOnIsolatorWith<ChurchillChuNaturalConvection>(
+			0.5*(data->meanTemperatureOfLiquid + data->temperatureOfEnvironment), tolerance);
+		break;
+	default:
+		temperatureOnIsolator = runTheRootFindingWith<SimplifiedNaturalConvection>(tolerance);
+		break;
+	}
 	setResults(temperatureOnIsolator);
+#ifdef HEAT_INSTRUMENTATION
+	addStatistics(before, true);
+#endif
 }
 /*!
- * \brief finds the intersection point of function using bisection method
+ * \brief searches the interval and finds the temperature on isolator by bisection method
+ * \tparam Natural correlation of natural convection, see ConvectionCorrelation.h
+ * \param tolerance value of tolerance used by bisection method
+ * \return the temperature on isolator
+ */
+template<class Natural>
+double HeatTransferSolver::runTheRootFindingWith(const double &tolerance)
+{
+	auto difference = [this](const double &temperatureOnIsolator) {
+		return getDifferenceOfHeatFlowsWith<Natural>(temperatureOnIsolator);
+	};
+	std::array<double, 2> interval;
+	{
+		HEAT_TRACE_SCOPE("bracketing", "solver");
+		HEAT_TIME_PHASE(timeOfBracketing);
+		interval = findIntervalValues(difference);
+	}
+	HEAT_TRACE_SCOPE("root finding", "solver");
+	HEAT_TIME_PHASE(timeOfRootFinding);
+	results.status = statusOfInitialValues;
+	return findIntersectionPoint(difference, interval[0], interval[1], tolerance);
+}
+/*!
+ * \brief
+ * starts the solving algorithm from known temperature on isolator,
+ * e.g. the solution of similar case (warm start)
+ * \param initialTemperatureOnIsolator initial value of temperature on isolator
+ * \param tolerance value of tolerance
+ */
+void HeatTransferSolver::runTheSolverFrom(const double &initialTemperatureOnIsolator, const double &tolerance)
+{
+#ifdef HEAT_INSTRUMENTATION
+	SolverStatistics before = SolverStatistics::local();
+#endif
+	HEAT_TRACE_SCOPE("solve from initial value", "solver");
+	results.status = statusOfInitialValues;
+	double temperatureOnIsolator;
+	{
+		HEAT_TIME_PHASE(timeOfRootFinding);
+		temperatureOnIsolator = findTemperatureOnIsolator(initialTemperatureOnIsolator, tolerance);
+	}
+	setResults(temperatureOnIsolator);
+#ifdef HEAT_INSTRUMENTATION
+	addStatistics(before, true);
+#endif
+}
+/*!
+ * \brief
+ * finds the temperature on isolator using secant method started from initial value,
+ * the temperature is kept between temperature of liquid and temperature of environment,
+ * if the secant method fails the bisection method on that interval is used
+ * \param initialTemperatureOnIsolator initial value of temperature on isolator
+ * \param tolerance value of tolerance
+ * \return the temperature on isolator for which the heat flows are equal
+ */
+double HeatTransferSolver::findTemperatureOnIsolator(const double &initialTemperatureOnIsolator, const double &tolerance)
+{
+	switch (data->typeOfNaturalConvection) {
+	case 1:
+		return findTemperatureOnIsolatorWith<ChurchillChuNaturalConvection>(initialTemperatureOnIsolator, tolerance);
+	default:
+		return findTemperatureOnIsolatorWith<SimplifiedNaturalConvection>(initialTemperatureOnIsolator, tolerance);
+	}
+}
+/*!
+ * \brief finds the temperature on isolator using secant method, see findTemperatureOnIsolator
+ * \tparam Natural correlation of natural convection, see ConvectionCorrelation.h
+ * \param initialTemperatureOnIsolator initial value of temperature on isolator
+ * \param tolerance value of tolerance
+ * \return the temperature on isolator for which the heat flows are equal
+ */
+template<class Natural>
+double HeatTransferSolver::findTemperatureOnIsolatorWith(const double &initialTemperatureOnIsolator, const double &tolerance)
+{
+	auto difference = [this](const double &temperatureOnIsolator) {
+		return getDifferenceOfHeatFlowsWith<Natural>(temperatureOnIsolator);
+	};
+	const int maximumIterations = 50;
+	double bottom = std::min(data->meanTemperatureOfLiquid, data->temperatureOfEnvironment);
+	double upper = std::max(data->meanTemperatureOfLiquid, data->temperatureOfEnvironment);
+	if (upper - bottom <= tolerance) {
+		return 0.5*(bottom + upper);
+	}
+	double previous = std::min(std::max(initialTemperatureOnIsolator, bottom), upper);
+	double differencePrevious = difference(previous);
+	if (abs(differencePrevious) <= tolerance) {
+		return previous;
+	}
+	double current = previous + (previous < 0.5*(bottom + upper) ? 1.0 : -1.0);
+	current = std::min(std::max(current, bottom), upper);
+	for (int i = 0; i < maximumIterations && current != previous; ++i) {
+		HEAT_COUNT(rootIterations);
+		double differenceCurrent = difference(current);
+		if (abs(differenceCurrent) <= tolerance) {
+			return current;
+		}
+		double slope = (differenceCurrent - differencePrevious) / (current - previous);
+		if (slope == 0 || !std::isfinite(slope)) {
+			break;
+		}
+		double next = current - differenceCurrent / slope;
+		bool isInInterval = next >= bottom && next <= upper;
+		next = std::min(std::max(next, bottom), upper);
+		if (isInInterval && abs(next - current) <= tolerance) {
+			return next;
+		}
+		previous = current;
+		differencePrevious = differenceCurrent;
+		current = next;
+	}
+	return findIntersectionPoint(difference, upper, bottom, tolerance);
+}
+/*!
+ * \brief
+ * finds the intersection point of function using bisection method,
+ * if no change of sign of function was found the not converged flag of status is set
  * \param *fun  address to a function
  * \param upperInterval upper interval value
  * \param bottomInterval bottom interval value
@@ -48,30 +237,57 @@ void HeatTransferSolver::runTheSolver()
  */
 double HeatTransferSolver::getTheIntersectionPointOfFunction(double(HeatTransferSolver::*fun)(const double &), const double & upperInterval,
 															const double & bottomInterval, const double & tolerance)
+{
+	return findIntersectionPoint([this, fun](const double &x) { return (this->*fun)(x); }, upperInterval, bottomInterval, tolerance);
+}
+/*!
+ * \brief bisection method, see getTheIntersectionPointOfFunction
+ * \param fun function object
+ * \param upperInterval upper interval value
+ * \param bottomInterval bottom interval value
+ * \param tolerance value of tolerance
+ * \return the value of intersection point
+ */
+template<class Function>
+double HeatTransferSolver::findIntersectionPoint(const Function &fun, const double &upperInterval, const double &bottomInterval,
+	const double &tolerance)
 {
 	double a = bottomInterval;
 	double b = upperInterval;
 	double x0 = 0;//intersection point
+	double valueAtA = fun(a);
+	bool isConverged = false;
 	while (abs(a - b) > tolerance) {
+		HEAT_COUNT(rootIterations);
 		x0 = (a + b) / 2;
-		if ( abs ((this->*fun)(x0))   <= tolerance) {
+		double valueAtX0 = fun(x0);
+		if (abs(valueAtX0) <= tolerance) {
+			isConverged = true;
 			break;
 		}
-		else if ((this->*fun)(x0)  *  (this->*fun)(a) < 0) {
+		else if (valueAtX0 * valueAtA < 0) {
 			b = x0;
+			isConverged = true;//the change of sign is between a and b
 		}
 		else {
 			a = x0;
+			valueAtA = valueAtX0;
 		}
 	}
+	if (!isConverged) {
+		results.status |= OutputData::statusNotConverged;
+	}
 	return x0;// returns the intersection point
 }
 /*!
- * \brief sets the results into the OutputData object
+ * \brief
+ * sets the results into the OutputData object and the status flags of final values:
+ * extrapolation of properties of air, not a number and infinity
  * \param temperatureOnIsolator the final value of temperature on isolator
  */
 void HeatTransferSolver::setResults(double const & temperatureOnIsolator)
 {
+	HEAT_TIME_PHASE(timeOfResults);
 	double temp = temperatureOnIsolator;
 	results.temperatureOnIsolator = temp;
 	results.convectionCoefficient2 = getConvectionCeofficient2(temp);
@@ -80,6 +296,10 @@ void HeatTransferSolver::setResults(double const & temperatureOnIsolator)
 	results.heatFlowByRadiation2 = getHeatFlowByRadiation2(temp);
 	results.heatFlow1 = getHeatFlow1(temp);
 	results.heatFlow2 = getHeatFlow2(temp);
+	if (!air->isInRange(0.5*(temp + data->temperatureOfEnvironment))) {
+		results.status |= OutputData::statusExtrapolation;
+	}
+	results.addStatusOfValues();
 }
 /*!
  * \brief calculates the interval values
@@ -87,7 +307,18 @@ void HeatTransferSolver::setResults(double const & temperatureOnIsolator)
  */
 std::vector<double> HeatTransferSolver::getIntervalValues(double (HeatTransferSolver::* fun)(const double&))
 {
-	std::vector<double> interval{ 0,0 };//interval[0] bottom, interval[1] upper
+	std::array<double, 2> interval = findIntervalValues([this, fun](const double &x) { return (this->*fun)(x); });
+	return std::vector<double>(interval.begin(), interval.end());
+}
+/*!
+ * \brief calculates the interval values, see getIntervalValues
+ * \param fun function object
+ * \return the interval values: the bottom and upper
+ */
+template<class Function>
+std::array<double, 2> HeatTransferSolver::findIntervalValues(const Function &fun)
+{
+	std::array<double, 2> interval{ {0,0} };//interval[0] bottom, interval[1] upper
 	double temp{ 0 };//temporary
 	double length = abs(data->meanTemperatureOfLiquid + data->temperatureOfEnvironment);
 	if (length < 100) {
@@ -95,7 +326,8 @@ std::vector<double> HeatTransferSolver::getIntervalValues(double (HeatTransferSo
 	}
 	for (size_t j = 0, i = 0; i < length; ++j, i=j*10)
 	{
-		temp = (this->*fun)(i);
+		HEAT_COUNT(intervalEvaluations);
+		temp = fun(i);
 		if (temp < interval[0]) {//setting bottom interval
 			interval[0] = temp;
 		}
@@ -110,34 +342,60 @@ std::vector<double> HeatTransferSolver::getIntervalValues(double (HeatTransferSo
  */
 void HeatTransferSolver::calculateConvectionCoefficient1()
 {
+	switch (data->typeOfForcedConvection) {
+	case 1:
+		calculateConvectionCoefficient1With<SiederTate>();
+		break;
+	case 2:
+		calculateConvectionCoefficient1With<CrossFlow>();
+		break;
+	case 3:
+		calculateConvectionCoefficient1With<DittusBoelterCooling>();
+		break;
+	default:
+		calculateConvectionCoefficient1With<DittusBoelterHeating>();
+		break;
+	}
+}
+/*!
+ * \brief calculates the value of convection coefficient 1, see calculateConvectionCoefficient1
+ * \tparam Forced correlation of forced convection, see ConvectionCorrelation.h
+ */
+template<class Forced>
+void HeatTransferSolver::calculateConvectionCoefficient1With()
+{
+	HEAT_COUNT_MANY(liquidPropertyLookups, 4);
 	double TemperatureLiquid = data->meanTemperatureOfLiquid;
-	double ReynoldsNumber = (data->meanVelocityOfLiquid*data->innerDiameterOfPipe) /
-		liquid->valueAt(TemperatureLiquid, PropertyType::viscosity);
-	double v = liquid->valueAt(TemperatureLiquid, PropertyType::viscosity);
-	double PrandtlNumber = liquid->valueAt(TemperatureLiquid, PropertyType::prandtl);
-	double A = data->forcedConvectionConstValueA;
-	double B = data->forcedConvectionConstValueB;
-	double C = data->forcedConvectionConstValueC;
-	double NusseltNumber = C * getPower(ReynoldsNumber, A)*getPower(PrandtlNumber, B);
-	results.convectionCoefficient1 = (NusseltNumber*liquid->valueAt(TemperatureLiquid, PropertyType::conductivity))
-		/ data->innerDiameterOfPipe;	
+	if (!liquid->isInRange(TemperatureLiquid)) {
+		results.status |= OutputData::statusExtrapolation;
+	}
+	results.convectionCoefficient1 = HeatTransferEquations::getConvectionCoefficient1<Forced>(data->meanVelocityOfLiquid,
+		data->innerDiameterOfPipe, liquid->valueAt(TemperatureLiquid, PropertyType::viscosity),
+		liquid->valueAt(TemperatureLiquid, PropertyType::prandtl),
+		liquid->valueAt(TemperatureLiquid, PropertyType::conductivity));
 }
 /*!
- * \brief calculates the value of resistance of thermal conduction
+ * \brief
+ * calculates the value of resistance of thermal conduction,
+ * if the layers are set it is the resistance of all layers (pipe wall included),
+ * otherwise only the isolator is taken into account
  */
 void HeatTransferSolver::calculateResistanceOfThermalConduction()
 {
-	double numerator = log(data->overallDiameterOfPipe / data->outerDiameterOfPipe);
-	double denominator = 2 * data->PI*data->thermalConductivityOfIsolator * data->lengthOfPipe;
-	results.resistanceOfThermalConduction = numerator / denominator;
+	if (data->layers.size() > 0) {
+		results.resistanceOfThermalConduction = data->layers.getResistance(data->innerDiameterOfPipe, data->lengthOfPipe);
+		return;
+	}
+	results.resistanceOfThermalConduction = HeatTransferEquations::getResistanceOfThermalConduction(
+		data->outerDiameterOfPipe, data->overallDiameterOfPipe, data->thermalConductivityOfIsolator, data->lengthOfPipe);
 }
 /*!
  * \brief calculates the value of resistance of thermal penetration
  */
 void HeatTransferSolver::calculateResistanceOfThermalPenetration()
 {
-	results.resistanceOfThermalPenetration = 1.0 /
-		(results.convectionCoefficient1*data->PI*data->innerDiameterOfPipe);
+	results.resistanceOfThermalPenetration = HeatTransferEquations::getResistanceOfThermalPenetration(
+		results.convectionCoefficient1, data->innerDiameterOfPipe);
 }
 /*!
  * \brief calculates the heat flow 1 value
@@ -146,10 +404,8 @@ void HeatTransferSolver::calculateResistanceOfThermalPenetration()
  */
 double HeatTransferSolver::getHeatFlow1(const double &temperatureOnIsolator)
 {
-	double numerator = data->meanTemperatureOfLiquid - temperatureOnIsolator;
-	double denominator = results.resistanceOfThermalConduction + 
-		results.resistanceOfThermalPenetration;
-	return getQuotient(numerator,denominator);
+	return HeatTransferEquations::getHeatFlow1(data->meanTemperatureOfLiquid, temperatureOnIsolator,
+		results.resistanceOfThermalConduction, results.resistanceOfThermalPenetration, Quotient{ this });
 }
 /*!
  * \brief calculates the heat flow 2 value
@@ -158,13 +414,9 @@ double HeatTransferSolver::getHeatFlow1(const double &temperatureOnIsolator)
  */
 double HeatTransferSolver::getHeatFlow2(const double & temperatureOnIsolator)
 {
-	double a2r=getRadiationCoefficient2(temperatureOnIsolator);
-	double a2k = getConvectionCeofficient2(temperatureOnIsolator);
-	double heatFlow = data->PI*data->overallDiameterOfPipe;
-	heatFlow *= (getRadiationCoefficient2(temperatureOnIsolator) +
-		getConvectionCeofficient2(temperatureOnIsolator));
-	heatFlow *= (temperatureOnIsolator - data->temperatureOfEnvironment);
-	return heatFlow;
+	return HeatTransferEquations::getHeatFlow2(getRadiationCoefficient2(temperatureOnIsolator) +
+		getConvectionCeofficient2(temperatureOnIsolator), data->overallDiameterOfPipe, temperatureOnIsolator,
+		data->temperatureOfEnvironment);
 }
 /*!
  * \brief calculates the difference between heat flow 2 and heat flow 1
@@ -173,7 +425,27 @@ double HeatTransferSolver::getHeatFlow2(const double & temperatureOnIsolator)
  */
 double HeatTransferSolver::getDifferenceOfHeatFlows(const double & temperatureOnIsolator)
 {
-	return getHeatFlow2(temperatureOnIsolator)-getHeatFlow1(temperatureOnIsolator);
+	switch (data->typeOfNaturalConvection) {
+	case 1:
+		return getDifferenceOfHeatFlowsWith<ChurchillChuNaturalConvection>(temperatureOnIsolator);
+	default:
+		return getDifferenceOfHeatFlowsWith<SimplifiedNaturalConvection>(temperatureOnIsolator);
+	}
+}
+/*!
+ * \brief calculates the difference between heat flow 2 and heat flow 1, see getDifferenceOfHeatFlows
+ * \tparam Natural correlation of natural convection, see ConvectionCorrelation.h
+ * \param temperatureOnIsolator value of temperature on isolator
+ * \return value of difference between heat flows
+ */
+template<class Natural>
+double HeatTransferSolver::getDifferenceOfHeatFlowsWith(const double &temperatureOnIsolator)
+{
+	HEAT_COUNT(residualEvaluations);
+	double heatFlow2 = HeatTransferEquations::getHeatFlow2(getRadiationCoefficient2(temperatureOnIsolator) +
+		getConvectionCoefficient2With<Natural>(temperatureOnIsolator), data->overallDiameterOfPipe, temperatureOnIsolator,
+		data->temperatureOfEnvironment);
+	return heatFlow2 - getHeatFlow1(temperatureOnIsolator);
 }
 /*!
  * \brief calculates the heat flow made by radiation 2
@@ -182,10 +454,8 @@ double HeatTransferSolver::getDifferenceOfHeatFlows(const double & temperatureOn
  */
 double HeatTransferSolver::getHeatFlowByRadiation2(const double & temperatureOnIsolator)
 {
-	return data->PI*
-		data->overallDiameterOfPipe*
-		getRadiationCoefficient2(temperatureOnIsolator)*
-		(temperatureOnIsolator - data->temperatureOfEnvironment);
+	return HeatTransferEquations::getHeatFlow2(getRadiationCoefficient2(temperatureOnIsolator), data->overallDiameterOfPipe,
+		temperatureOnIsolator, data->temperatureOfEnvironment);
 }
 /*!
  * \brief calculates the heat flow made by convection 2
@@ -194,22 +464,18 @@ double HeatTransferSolver::getHeatFlowByRadiation2(const double & temperatureOnI
  */
 double HeatTransferSolver::getHeatFlowByConvection2(const double & temperatureOnIsolator)
 {
-	return data->PI*
-		data->overallDiameterOfPipe*
-		getConvectionCeofficient2(temperatureOnIsolator)*
-		(temperatureOnIsolator - data->temperatureOfEnvironment);
+	return HeatTransferEquations::getHeatFlow2(getConvectionCeofficient2(temperatureOnIsolator), data->overallDiameterOfPipe,
+		temperatureOnIsolator, data->temperatureOfEnvironment);
 }
 /*!
- * \brief calculates the radiation coefficient 2
+ * \brief calculates the radiation coefficient 2 in the factored form, see HeatTransferEquations
  * \param temperatureOnIsolator value of temperature on isolator
  * \return value of radiation coefficient 2
  */
 double HeatTransferSolver::getRadiationCoefficient2(const double & temperatureOnIsolator)
 {
-	double numerator = data->ratioOfRadiantEnergyExchange*data->StefanBoltzmannConstant;
-	numerator *= (getPower(temperatureOnIsolator / 100, 4) - getPower(data->temperatureOfEnvironment / 100, 4));
-	double denominator = temperatureOnIsolator - data->temperatureOfEnvironment;
-	return getQuotient(numerator, denominator);
+	return HeatTransferEquations::getRadiationCoefficient2(data->ratioOfRadiantEnergyExchange, temperatureOnIsolator,
+		data->temperatureOfEnvironment, data->StefanBoltzmannConstant);
 }
 /*!
  * \brief calculates the convection coefficient 2
@@ -218,16 +484,30 @@ double HeatTransferSolver::getRadiationCoefficient2(const double & temperatureOn
  */
 double HeatTransferSolver::getConvectionCeofficient2(const double & temperatureOnIsolator)
 {
+	switch (data->typeOfNaturalConvection) {
+	case 1:
+		return getConvectionCoefficient2With<ChurchillChuNaturalConvection>(temperatureOnIsolator);
+	default:
+		return getConvectionCoefficient2With<SimplifiedNaturalConvection>(temperatureOnIsolator);
+	}
+}
+/*!
+ * \brief calculates the convection coefficient 2, see getConvectionCeofficient2
+ * \tparam Natural correlation of natural convection, see ConvectionCorrelation.h
+ * \param temperatureOnIsolator value of temperature on isolator
+ * \return value of convection coefficient 2
+ */
+template<class Natural>
+double HeatTransferSolver::getConvectionCoefficient2With(const double &temperatureOnIsolator)
+{
+	HEAT_COUNT_MANY(airPropertyLookups, 3);
 	double meanTemperature = 0.5*(temperatureOnIsolator + data->temperatureOfEnvironment);
 	double conductivityAir = air->valueAt(meanTemperature, PropertyType::conductivity);
 	double prandtlAir = air->valueAt(meanTemperature, PropertyType::prandtl);
 	double viscosityAir = air->valueAt(meanTemperature, PropertyType::viscosity);
 	double GrashofNumber = getGrashofNumber(temperatureOnIsolator, viscosityAir);
-	naturalTransfer.setValueOfAandC(GrashofNumber*prandtlAir);
-	double numerator = naturalTransfer.C*conductivityAir;
-	numerator *= getPower(GrashofNumber*prandtlAir, naturalTransfer.A);
-	double denominator = data->overallDiameterOfPipe;
-	return getQuotient(numerator, denominator);
+	return HeatTransferEquations::getConvectionCoefficient2(Natural::getNusseltNumber(GrashofNumber*prandtlAir, prandtlAir),
+		conductivityAir, data->overallDiameterOfPipe, Quotient{ this });
 }
 /*!
  * \brief calculates the Grashof's value
@@ -237,52 +517,30 @@ double HeatTransferSolver::getConvectionCeofficient2(const double & temperatureO
  */
 double HeatTransferSolver::getGrashofNumber(const double &temperatureOnIsolator, const double &viscosityOfAir)
 {
-	double beta = 2.0 / (temperatureOnIsolator + data->temperatureOfEnvironment);
-	double numerator = data->accelerationOfGravity*beta;
-	numerator *= (temperatureOnIsolator - data->temperatureOfEnvironment);
-	numerator *= getPower(data->overallDiameterOfPipe, 3);
-	double denominator = getPower(viscosityOfAir, 2);
-	return getQuotient(numerator, denominator);
+	return HeatTransferEquations::getGrashofNumber(temperatureOnIsolator, data->temperatureOfEnvironment,
+		data->overallDiameterOfPipe, viscosityOfAir, data->accelerationOfGravity, Quotient{ this });
 }
 /*!
- * \brief calculates the quotient
+ * \brief
+ * calculates the quotient,
+ * if the denominator is 0 the division by zero flag of status is set and 0 is returned
  * \param numerator value of numerator
  * \param denominator value of denominator
  * \return value of quotient
  */
 double HeatTransferSolver::getQuotient(const double & numerator, const double & denominator)
 {
-	if (numerator != 0 && denominator != 0) {
+	if (denominator == 0) {
+		results.status |= OutputData::statusDivisionByZero;
+		return 0.0;
+	}
+	if (numerator != 0) {
 		return numerator / denominator;
 	}
 	else {
 		return 0.0;
 	}
 }
-/*!
- * \brief calculates exponentiation
- * \param base value of base
- * \param exponent value of exponent
- * \throw if the results is NaN or inf it will displays warning message on application window
- * \return value of exponentiation
- */
-double HeatTransferSolver::getPower(double base, double exponent)
-{
-    double result = pow(base, exponent);
-    try {
-        if ( isinf( abs(result) ) || isnan(result) ) {
-            throw std::invalid_argument("Results may be incorrect.");
-        }
-    }
-    catch (std::invalid_argument error) {
-        if(!isWarningAlertDisplay){
-            QMessageBox::warning(nullptr,"Warning from solver.",
-                                 QString::fromStdString(error.what()));
-            isWarningAlertDisplay=true;
-        }
-    }
-    return result;
-}
 /*!
  * \brief returns the results obtained from solver
  * \return values of results
@@ -291,10 +549,36 @@ OutputData * HeatTransferSolver::getResults()
 {
 	return &results;
 }
+/*!
+ * \brief returns the counters and timers of this solver (empty if built without HEAT_INSTRUMENTATION)
+ * \return statistics
+ */
+const SolverStatistics& HeatTransferSolver::getStatistics() const
+{
+	return statistics;
+}
+/*!
+ * \brief adds the statistics collected by current thread since before to the statistics of solver
+ * \param before statistics of current thread at the beginning
+ * \param isSolve true if the temperature on isolator was found (the solve is counted)
+ */
+void HeatTransferSolver::addStatistics(const SolverStatistics &before, const bool &isSolve)
+{
+	SolverStatistics &local = SolverStatistics::local();
+	if (isSolve) {
+		++local.quantityOfSolves;
+	}
+	SolverStatistics difference = local - before;
+	difference.maximumRootIterations = difference.rootIterations;
+	local.maximumRootIterations = std::max(local.maximumRootIterations, difference.rootIterations);
+	statistics += difference;
+}
 /*!
  * \brief destructor that release dynamic allocated data
  */
 HeatTransferSolver::~HeatTransferSolver()
 {
-	delete air;
+	if (isAirOwner) {
+		delete air;
+	}
 }
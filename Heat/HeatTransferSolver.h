@@ -1,11 +1,14 @@
 #pragma once
 #include "InputData.h"
 #include "ThermalProperties.h"
+#include <array>
 #include <string>
-#include "NaturalConvection.h"
+#include "ConvectionCorrelation.h"
+#include "HeatTransferEquations.h"
 #include "OutputData.h"
-#include <QMessageBox>
-#include <QString>
+#include "Power.h"
+#include "SolverStatistics.h"
+#include "TraceRecorder.h"
 /*!
  * \brief The HeatTransferSolver class
  * solves the heat transfer problemm,
@@ -20,14 +23,20 @@ class HeatTransferSolver
 public:
 	HeatTransferSolver() = delete;
 	explicit HeatTransferSolver(InputData &data,ThermalProperties &liquid);
+	HeatTransferSolver(InputData &data, const ThermalProperties &liquid, const ThermalProperties &air);
+	HeatTransferSolver(const HeatTransferSolver &) = delete;
+	HeatTransferSolver& operator=(const HeatTransferSolver &) = delete;
 	//Main algorithm functions
 	void calculateInitialValues();
-	void runTheSolver();
+	void runTheSolver(const double &tolerance = 0.001);
+	void runTheSolverFrom(const double &initialTemperatureOnIsolator, const double &tolerance = 0.001);
+	double findTemperatureOnIsolator(const double &initialTemperatureOnIsolator, const double &tolerance = 0.001);
 	double getTheIntersectionPointOfFunction(double (HeatTransferSolver::*fun)(const double &),const double &upperInterval, const double
 										&bottomInterval,const double &tolerance =0.001);//Bisection method
 	void setResults(double const &temperatureOnIsolator);
 	std::vector<double> getIntervalValues(double (HeatTransferSolver::* fun)(const double&));
-	OutputData* getResults();																					
+	OutputData* getResults();
+	const SolverStatistics& getStatistics() const;																					
 	//Thermal Resistance functions
 	void calculateResistanceOfThermalConduction();
 	void calculateResistanceOfThermalPenetration();
@@ -44,7 +53,6 @@ public:
 	//Other functions
 	double getGrashofNumber(const double &temperatureOnIsolator,const double &viscosityOfAir);
 	double getQuotient(const double &numerator, const double &denominator);
-	double getPower(double base, double exponent);
 	~HeatTransferSolver();
 private:
     /*!
@@ -60,20 +68,54 @@ private:
      */
 	const ThermalProperties *air;
     /*!
-     * \brief parameters of natural convection equation
+     * \brief true if the properties of air were loaded by the solver and have to be released
      */
-	NaturalConvection naturalTransfer;
+	bool isAirOwner;
     /*!
-     * \brief file path for air properties
+     * \brief file path for air properties, not a std::string member so the construction of solver does not allocate
      */
-	const std::string airFilePath{ "fluids_properties/air.txt" };
+	static const char *const airFilePath;
     /*!
      * \brief stores the output data (results)
      */
 	OutputData results;
     /*!
-     * \brief stores the output data (results)
+     * \brief status flags found while the initial values were calculated
+     */
+	unsigned int statusOfInitialValues;
+    /*!
+     * \brief counters and timers of this solver, collected only with HEAT_INSTRUMENTATION
+     */
+	SolverStatistics statistics;
+    /*!
+     * \brief quotient function passed to HeatTransferEquations, the status of results is set by getQuotient
      */
-    bool isWarningAlertDisplay;
+	class Quotient
+	{
+	public:
+		HeatTransferSolver *solver;
+		double operator()(const double &numerator, const double &denominator) const
+		{
+			return solver->getQuotient(numerator, denominator);
+		}
+	};
+	void addStatistics(const SolverStatistics &before, const bool &isSolve);
+	template<class Forced>
+	void calculateInitialValuesWith();
+	template<class Forced>
+	void calculateConvectionCoefficient1With();
+	template<class Natural>
+	double runTheRootFindingWith(const double &tolerance);
+	template<class Natural>
+	double findTemperatureOnIsolatorWith(const double &initialTemperatureOnIsolator, const double &tolerance);
+	template<class Function>
+	double findIntersectionPoint(const Function &fun, const double &upperInterval, const double &bottomInterval,
+		const double &tolerance);
+	template<class Function>
+	std::array<double, 2> findIntervalValues(const Function &fun);
+	template<class Natural>
+	double getDifferenceOfHeatFlowsWith(const double &temperatureOnIsolator);
+	template<class Natural>
+	double getConvectionCoefficient2With(const double &temperatureOnIsolator);
 };
 
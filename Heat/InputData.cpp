@@ -1,4 +1,12 @@
 #include "InputData.h"
+#include "ConvectionCorrelation.h"
+
+const int InputData::quantityOfForcedConvectionTypes;
+const int InputData::quantityOfNaturalConvectionTypes;
+constexpr double DittusBoelterHeating::C;
+constexpr double SiederTate::C;
+constexpr double CrossFlow::C;
+constexpr double DittusBoelterCooling::C;
 
 InputData::InputData()
 {
@@ -12,10 +20,15 @@ void InputData::calculateTheRemainingData()
 	calculateRadiantEnergyExchange();
 }
 /*!
- * \brief calculates the geometry parameters: diameters and areas
+ * \brief calculates the geometry parameters: diameters and areas,
+ * the thickness of pipe and isolator are taken from layers if they are set
  */
 void InputData::calculateGeometry()
 {
+	if (layers.size() > 0) {
+		thicknessOfPipe = layers[0].thickness;
+		thicknessOfIsolator = layers.getThickness() - thicknessOfPipe;
+	}
 	outerDiameterOfPipe = innerDiameterOfPipe + 2*thicknessOfPipe;
 	overallDiameterOfPipe = outerDiameterOfPipe + 2*thicknessOfIsolator;
 	areaOfOuterPipe = outerDiameterOfPipe * pow(PI, 2);
@@ -31,3 +44,42 @@ void InputData::calculateRadiantEnergyExchange()
 		quotientOfArea * ((1 / emissivityOfEnvironment)-1);
 	ratioOfRadiantEnergyExchange = pow(radiantRatio, -1);
 }
+/*!
+ * \brief sets the correlation of forced convection
+ * \param typeOfForcedConvection 0-low viscosity, 1-high viscosity, 2-perpendicular flow, 3-cooled liquid of low viscosity
+ */
+void InputData::setForcedConvectionConstValues(const int &typeOfForcedConvection)
+{
+	switch (typeOfForcedConvection) {
+	case 0://low viscosity
+		setForcedConvectionCorrelation<DittusBoelterHeating>();
+		break;
+	case 1://high viscosity
+		setForcedConvectionCorrelation<SiederTate>();
+		break;
+	case 2://perpendicular flow
+		setForcedConvectionCorrelation<CrossFlow>();
+		break;
+	case 3://cooled liquid of low viscosity
+		setForcedConvectionCorrelation<DittusBoelterCooling>();
+		break;
+	}
+}
+/*!
+ * \brief sets the value of emissivity of isolator
+ * \param typeOfEmissivity 0-low (0.3), 1-medium (0.6), 2-high (0.9)
+ */
+void InputData::setEmissivityOfIsolator(const int &typeOfEmissivity)
+{
+	switch (typeOfEmissivity) {
+	case 0://low
+		emissivityOfIsolator = 0.3;
+		break;
+	case 1://medium
+		emissivityOfIsolator = 0.6;
+		break;
+	case 2://high
+		emissivityOfIsolator = 0.9;
+		break;
+	}
+}
@@ -1,5 +1,6 @@
 #pragma once
 #include <math.h>
+#include "LayerStack.h"
 /*!
  * \brief The InputData class
  * stores the values that are required for solving the heat transfer problem
@@ -11,6 +12,10 @@ class InputData
 public:
 	InputData();
 	void calculateTheRemainingData();
+	void setForcedConvectionConstValues(const int &typeOfForcedConvection);
+	template<class Correlation>
+	void setForcedConvectionCorrelation();
+	void setEmissivityOfIsolator(const int &typeOfEmissivity);
 	//Geometry of pipe and isolator
 	double innerDiameterOfPipe;
 	double outerDiameterOfPipe;
@@ -29,20 +34,47 @@ public:
 	//Properties of isolator
 	double emissivityOfIsolator;
 	double thermalConductivityOfIsolator;
+    /*!
+     * \brief
+     * optional layers around the liquid: pipe wall, layers of isolator and jacket,
+     * if it is not empty it sets the thickness of pipe (the first layer) and of isolator (the other layers)
+     * and replaces the single isolator in the resistance of thermal conduction
+     */
+	LayerStack layers;
 	//Properties of environment
 	const double emissivityOfEnvironment{1};
 	double temperatureOfEnvironment;
 	double ratioOfRadiantEnergyExchange;
-	//Constant values of forced convection
-	double forcedConvectionConstValueC;
-	double forcedConvectionConstValueA;
-	double forcedConvectionConstValueB;
+    /*!
+     * \brief correlation of forced convection (policy of ConvectionCorrelation.h), see setForcedConvectionConstValues
+     */
+	int typeOfForcedConvection{ 0 };
+    /*!
+     * \brief quantity of types of forced convection, see setForcedConvectionConstValues
+     */
+	static const int quantityOfForcedConvectionTypes{ 4 };
+    /*!
+     * \brief correlation of natural convection: 0-simplified (regimes of NaturalConvection), 1-Churchill-Chu
+     */
+	int typeOfNaturalConvection{ 0 };
+    /*!
+     * \brief quantity of types of natural convection
+     */
+	static const int quantityOfNaturalConvectionTypes{ 2 };
 	//Fundamental Physcial Constants
 	const double accelerationOfGravity{ 9.80665 };
 	const double StefanBoltzmannConstant{5.670367};
-	const double PI{ 3.141592653589793238 };
+	const double PI{ numberPi };
 private:
 	void calculateGeometry();
 	void calculateRadiantEnergyExchange();
 };
 
+/*!
+ * \brief sets the type of forced convection from the correlation policy, see ConvectionCorrelation.h
+ */
+template<class Correlation>
+void InputData::setForcedConvectionCorrelation()
+{
+	typeOfForcedConvection = Correlation::type;
+}
@@ -0,0 +1,262 @@
+#include "InsulationOptimizer.h"
+#include "HeatTransferSolver.h"
+#include <cmath>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+/*!
+ * \brief The ThicknessCost class
+ * calculates the total cost of isolator thickness using one solver
+ */
+class ThicknessCost
+{
+public:
+	ThicknessCost(InputData &data, HeatTransferSolver &solver, const IsolatorMaterial &material,
+		const InsulationCosts &costs, const double &presentValueFactor):
+		data{&data},solver{&solver},material{&material},costs{&costs},presentValueFactor{presentValueFactor},
+		temperatureOnIsolator{0.5*(data.meanTemperatureOfLiquid + data.temperatureOfEnvironment)},quantityOfSolves{0}
+	{
+		this->data->thermalConductivityOfIsolator = material.thermalConductivity;
+	}
+	/*!
+	 * \brief calculates the total cost of one meter of pipe, only the isolator side of problem is calculated
+	 * \param thickness thickness of isolator
+	 * \param optimum if not null the costs and heat flow are set
+	 * \return total cost
+	 */
+	double operator()(const double &thickness, InsulationOptimum *optimum = nullptr)
+	{
+		data->thicknessOfIsolator = thickness;
+		data->calculateTheRemainingData();
+		solver->calculateResistanceOfThermalConduction();
+		temperatureOnIsolator = solver->findTemperatureOnIsolator(temperatureOnIsolator, costs->tolerance);
+		++quantityOfSolves;
+		double heatFlow = solver->getHeatFlow1(temperatureOnIsolator);
+		double volume = 0.25*data->PI*(data->overallDiameterOfPipe*data->overallDiameterOfPipe -
+			data->outerDiameterOfPipe*data->outerDiameterOfPipe);
+		double capitalCost = material->costPerVolume*volume + costs->fixedCostPerLength;
+		double costOfHeatLoss = heatFlow / 1000 * costs->operatingHoursPerYear*costs->priceOfHeat*presentValueFactor;
+		if (optimum != nullptr) {
+			optimum->thicknessOfIsolator = thickness;
+			optimum->heatFlow = heatFlow;
+			optimum->capitalCost = capitalCost;
+			optimum->costOfHeatLoss = costOfHeatLoss;
+			optimum->totalCost = capitalCost + costOfHeatLoss;
+		}
+		return capitalCost + costOfHeatLoss;
+	}
+	InputData *data;
+	HeatTransferSolver *solver;
+	const IsolatorMaterial *material;
+	const InsulationCosts *costs;
+	double presentValueFactor;
+	double temperatureOnIsolator;
+	int quantityOfSolves;
+};
+/*!
+ * \brief finds the minimum of function on interval using Brent's method
+ * \param function minimized function
+ * \param bottom bottom interval value
+ * \param upper upper interval value
+ * \param tolerance tolerance of argument
+ * \return argument of minimum
+ */
+double findMinimumByBrent(ThicknessCost &function, double bottom, double upper, const double &tolerance)
+{
+	const double goldenRatio = 0.3819660112501051;
+	const int maximumIterations = 100;
+	double x = bottom + goldenRatio * (upper - bottom);
+	double w = x, v = x;
+	double fx = function(x);
+	double fw = fx, fv = fx;
+	double step = 0, previousStep = 0;
+	for (int i = 0; i < maximumIterations; ++i) {
+		double middle = 0.5*(bottom + upper);
+		double tolerance1 = tolerance * 0.5 + 1e-10*std::abs(x);
+		double tolerance2 = 2 * tolerance1;
+		if (std::abs(x - middle) <= tolerance2 - 0.5*(upper - bottom)) {
+			break;
+		}
+		bool isGoldenStep = true;
+		if (std::abs(previousStep) > tolerance1) {
+			double r = (x - w)*(fx - fv);
+			double q = (x - v)*(fx - fw);
+			double p = (x - v)*q - (x - w)*r;
+			q = 2 * (q - r);
+			if (q > 0) { p = -p; }
+			q = std::abs(q);
+			if (std::abs(p) < std::abs(0.5*q*previousStep) && p > q*(bottom - x) && p < q*(upper - x)) {
+				previousStep = step;
+				step = p / q;
+				double u = x + step;
+				if (u - bottom < tolerance2 || upper - u < tolerance2) {
+					step = x < middle ? tolerance1 : -tolerance1;
+				}
+				isGoldenStep = false;
+			}
+		}
+		if (isGoldenStep) {
+			previousStep = (x >= middle ? bottom : upper) - x;
+			step = goldenRatio * previousStep;
+		}
+		double u = std::abs(step) >= tolerance1 ? x + step : x + (step > 0 ? tolerance1 : -tolerance1);
+		double fu = function(u);
+		if (fu <= fx) {
+			if (u >= x) { bottom = x; } else { upper = x; }
+			v = w; fv = fw;
+			w = x; fw = fx;
+			x = u; fx = fu;
+		}
+		else {
+			if (u < x) { bottom = u; } else { upper = u; }
+			if (fu <= fw || w == x) {
+				v = w; fv = fw;
+				w = u; fw = fu;
+			}
+			else if (fu <= fv || v == x || v == w) {
+				v = u; fv = fu;
+			}
+		}
+	}
+	return x;
+}
+}
+/*!
+ * \brief constructor
+ * \param fluids properties of all liquids and air, they have to outlive the optimizer
+ * \param costs economic data
+ */
+InsulationOptimizer::InsulationOptimizer(const FluidLibrary &fluids, const InsulationCosts &costs):
+	fluids{&fluids},costs{costs}
+{
+}
+/*!
+ * \brief calculates the factor which multiplied by yearly cost gives the cost of all years of operation
+ * \return present value factor
+ */
+double InsulationOptimizer::getPresentValueFactor() const
+{
+	if (costs.interestRate == 0) {
+		return costs.yearsOfOperation;
+	}
+	return (1 - pow(1 + costs.interestRate, -costs.yearsOfOperation)) / costs.interestRate;
+}
+/*!
+ * \brief checks if the pipe class and materials can be optimized
+ * \param pipeClass pipe class
+ * \param materials materials of isolator which can be chosen
+ * \throw std::invalid_argument if there is no material, the conductivity of material is not positive,
+ * the range of thickness is wrong, the liquid is unknown or layers are set
+ */
+void InsulationOptimizer::checkProblem(const BatchCase &pipeClass, const std::vector<IsolatorMaterial> &materials) const
+{
+	if (materials.empty() || !(costs.maximumThickness > costs.minimumThickness) || costs.minimumThickness < 0) {
+		throw std::invalid_argument("Materials and range of thickness of isolator have to be set.");
+	}
+	for (const auto &material : materials) {
+		if (!(material.thermalConductivity > 0)) {
+			throw std::invalid_argument("Thermal conductivity of material has to be positive.");
+		}
+	}
+	if (pipeClass.typeOfLiquid < 0 || pipeClass.typeOfLiquid >= FluidLibrary::quantityOfLiquids) {
+		throw std::invalid_argument("Unknown type of liquid.");
+	}
+	if (pipeClass.data.layers.size() > 0) {
+		throw std::invalid_argument("Optimizer does not support layers.");
+	}
+}
+/*!
+ * \brief finds the optimal isolator of one pipe class
+ * \param pipeClass pipe class, the thickness and conductivity of isolator are not used, length is one meter
+ * \param materials materials of isolator which can be chosen
+ * \throw std::invalid_argument if there is no material, the range of thickness is wrong, the liquid is unknown
+ * or layers are set
+ * \return optimal thickness and material
+ */
+InsulationOptimum InsulationOptimizer::optimize(const BatchCase &pipeClass,
+	const std::vector<IsolatorMaterial> &materials) const
+{
+	checkProblem(pipeClass, materials);
+	InputData data{ pipeClass.data };
+	data.lengthOfPipe = 1;
+	data.thicknessOfIsolator = costs.minimumThickness;
+	data.thermalConductivityOfIsolator = materials[0].thermalConductivity;
+	HeatTransferSolver solver{ data, fluids->liquid(pipeClass.typeOfLiquid), fluids->air() };
+	const double presentValueFactor = getPresentValueFactor();
+	InsulationOptimum best{};
+	int quantityOfSolves = 0;
+	for (size_t i = 0; i < materials.size(); ++i) {
+		ThicknessCost cost{ data, solver, materials[i], costs, presentValueFactor };
+		double thickness = findMinimumByBrent(cost, costs.minimumThickness, costs.maximumThickness,
+			costs.thicknessTolerance);
+		InsulationOptimum optimum{};
+		cost(thickness, &optimum);
+		double costOfBottom = cost(costs.minimumThickness);
+		if (costOfBottom < optimum.totalCost) {
+			cost(costs.minimumThickness, &optimum);
+		}
+		quantityOfSolves += cost.quantityOfSolves;
+		optimum.material = static_cast<int>(i);
+		if (best.material < 0 || optimum.totalCost < best.totalCost) {
+			best = optimum;
+		}
+	}
+	best.quantityOfSolves = quantityOfSolves;
+	return best;
+}
+/*!
+ * \brief
+ * finds the optimal isolator of many pipe classes, the classes are divided between threads,
+ * all pipe classes are checked before the threads start
+ * \param pipeClasses pipe classes
+ * \param materials materials of isolator which can be chosen
+ * \param quantityOfThreads quantity of threads
+ * \throw std::invalid_argument if there is no material, the range of thickness is wrong, the liquid is unknown
+ * or layers are set
+ * \return optimal thickness and material of every pipe class
+ */
+std::vector<InsulationOptimum> InsulationOptimizer::optimize(const std::vector<BatchCase> &pipeClasses,
+	const std::vector<IsolatorMaterial> &materials, const unsigned int &quantityOfThreads) const
+{
+	for (const auto &pipeClass : pipeClasses) {
+		checkProblem(pipeClass, materials);
+	}
+	std::vector<InsulationOptimum> optimum(pipeClasses.size());
+	size_t quantityOfParts = std::max<size_t>(1, std::min<size_t>(quantityOfThreads, pipeClasses.size()));
+	std::mutex errorLock;
+	std::exception_ptr error{};
+	auto optimizePart = [&](size_t begin, size_t end) {
+		try {
+			for (size_t i = begin; i < end; ++i) {
+				optimum[i] = optimize(pipeClasses[i], materials);
+			}
+		}
+		catch (...) {
+			std::lock_guard<std::mutex> lock(errorLock);
+			error = std::current_exception();
+		}
+	};
+	if (quantityOfParts == 1) {
+		optimizePart(0, pipeClasses.size());
+	}
+	else {
+		std::vector<std::thread> threads;
+		size_t partSize = pipeClasses.size() / quantityOfParts;
+		size_t remainder = pipeClasses.size() % quantityOfParts;
+		for (size_t part = 0, begin = 0; part < quantityOfParts; ++part) {
+			size_t size = partSize + (part < remainder ? 1 : 0);
+			threads.emplace_back(optimizePart, begin, begin + size);
+			begin += size;
+		}
+		for (auto &thread : threads) {
+			thread.join();
+		}
+	}
+	if (error) {
+		std::rethrow_exception(error);
+	}
+	return optimum;
+}
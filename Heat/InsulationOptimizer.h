@@ -0,0 +1,103 @@
+#pragma once
+#include "BatchRunner.h"
+#include "FluidLibrary.h"
+#include <vector>
+/*!
+ * \brief The IsolatorMaterial class
+ * stores the material of isolator which can be chosen by optimizer
+ */
+class IsolatorMaterial
+{
+public:
+	double thermalConductivity;
+    /*!
+     * \brief cost of one cubic meter of isolator (with installation)
+     */
+	double costPerVolume;
+};
+/*!
+ * \brief The InsulationCosts class
+ * stores the economic data used by optimizer, the costs are counted for one meter of pipe
+ */
+class InsulationCosts
+{
+public:
+    /*!
+     * \brief price of lost heat per kWh
+     */
+	double priceOfHeat{ 0.05 };
+	double operatingHoursPerYear{ 8760 };
+	double yearsOfOperation{ 20 };
+    /*!
+     * \brief interest rate used to discount the future costs of heat loss, 0 means no discount
+     */
+	double interestRate{ 0 };
+    /*!
+     * \brief cost of one meter of isolator which does not depend on thickness
+     */
+	double fixedCostPerLength{ 0 };
+	double minimumThickness{ 0 };
+	double maximumThickness{ 0.5 };
+    /*!
+     * \brief tolerance of optimal thickness [m]
+     */
+	double thicknessTolerance{ 1e-4 };
+    /*!
+     * \brief tolerance used by solver
+     */
+	double tolerance{ 0.001 };
+};
+/*!
+ * \brief The InsulationOptimum class
+ * stores the optimal isolator of one pipe class
+ */
+class InsulationOptimum
+{
+public:
+	double thicknessOfIsolator{ 0 };
+    /*!
+     * \brief index of chosen material
+     */
+	int material{ -1 };
+    /*!
+     * \brief heat flow lost by one meter of pipe [W/m]
+     */
+	double heatFlow{ 0 };
+	double capitalCost{ 0 };
+    /*!
+     * \brief discounted cost of heat lost during the years of operation
+     */
+	double costOfHeatLoss{ 0 };
+	double totalCost{ 0 };
+    /*!
+     * \brief quantity of heat balance solves
+     */
+	int quantityOfSolves{ 0 };
+};
+/*!
+ * \brief The InsulationOptimizer class
+ * finds the thickness (and material) of isolator which minimizes the capital cost
+ * plus the cost of heat lost during the lifetime of one meter of pipe.
+ * The thickness is found by Brent's method (golden section with parabolic steps),
+ * the liquid side of problem (convection coefficient 1, thermal penetration) does not depend
+ * on isolator so it is calculated once, and every solve starts from the temperature on isolator
+ * of the previous one. The single isolator model is used, the layers of input data are not supported
+ * \author Łukasz Dyraga
+ * \version 1.0
+ */
+class InsulationOptimizer
+{
+public:
+	InsulationOptimizer(const FluidLibrary &fluids, const InsulationCosts &costs);
+	InsulationOptimum optimize(const BatchCase &pipeClass, const std::vector<IsolatorMaterial> &materials) const;
+	std::vector<InsulationOptimum> optimize(const std::vector<BatchCase> &pipeClasses,
+		const std::vector<IsolatorMaterial> &materials, const unsigned int &quantityOfThreads = 1) const;
+	double getPresentValueFactor() const;
+private:
+	void checkProblem(const BatchCase &pipeClass, const std::vector<IsolatorMaterial> &materials) const;
+    /*!
+     * \brief properties of all liquids and air
+     */
+	const FluidLibrary *fluids;
+	InsulationCosts costs;
+};
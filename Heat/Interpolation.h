@@ -12,6 +12,35 @@ class Interpolation//Lagrange
 public:
 	Interpolation();
 	double calculate(const double &arg, const std::vector<double> &valueX, const std::vector<double> &valueY)const;
+	template<class T>
+	T calculateAt(const T &arg, const std::vector<double> &valueX, const std::vector<double> &valueY)const;
 	~Interpolation();
 };
+/*!
+ * \brief
+ * calculates the polynomial interpolation by Lagrange method for any number type,
+ * e.g. the dual number used to calculate derivatives or float
+ * \param arg the X value for which the Y value will be calculated
+ * \param valueX points for which the interpolation function is created
+ * \param valueY points for which the interpolation function is created
+ * \return value of Y for arg value
+ */
+template<class T>
+T Interpolation::calculateAt(const T &arg, const std::vector<double> &valueX, const std::vector<double> &valueY)const
+{
+	typedef decltype(arg * 1.0) Accumulator;//the terms cancel each other, so float is accumulated in double
+	Accumulator result(0);
+	for (size_t i = 0; i < valueX.size(); i++)
+	{
+		Accumulator fraction(valueY[i]);
+		for (size_t j = 0; j < valueX.size(); j++)
+		{
+			if (j != i) {
+				fraction = fraction * ((arg - valueX[j]) / (valueX[i] - valueX[j]));
+			}
+		}
+		result = result + fraction;
+	}
+	return T(result);
+}
 
@@ -0,0 +1,144 @@
+#include "InverseSolver.h"
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+/*!
+ * \brief constructor
+ * \param data input data, the free input value is replaced during solve
+ * \param liquid properties of liquid, they have to outlive the inverse solver
+ * \param air properties of air, they have to outlive the inverse solver
+ */
+InverseSolver::InverseSolver(const InputData &data, const ThermalProperties &liquid, const ThermalProperties &air):
+	data{data},solver{this->data, liquid, air},
+	temperatureOnIsolator{0.5*(data.meanTemperatureOfLiquid + data.temperatureOfEnvironment)}
+{
+}
+/*!
+ * \brief sets the free input and calculates again only the part of problem which depends on it
+ * \param freeInput changed input
+ * \param valueOfInput new value of input
+ */
+void InverseSolver::setFreeInput(const InverseProblem::FreeInput &freeInput, const double &valueOfInput)
+{
+	switch (freeInput) {
+	case InverseProblem::thicknessOfIsolator:
+		data.thicknessOfIsolator = valueOfInput;
+		data.calculateTheRemainingData();
+		solver.calculateResistanceOfThermalConduction();
+		break;
+	case InverseProblem::thermalConductivityOfIsolator:
+		data.thermalConductivityOfIsolator = valueOfInput;
+		solver.calculateResistanceOfThermalConduction();
+		break;
+	case InverseProblem::emissivityOfIsolator:
+		data.emissivityOfIsolator = valueOfInput;
+		data.calculateTheRemainingData();
+		break;
+	case InverseProblem::meanTemperatureOfLiquid:
+		data.meanTemperatureOfLiquid = valueOfInput;
+		solver.calculateConvectionCoefficient1();
+		solver.calculateResistanceOfThermalPenetration();
+		break;
+	case InverseProblem::meanVelocityOfLiquid:
+		data.meanVelocityOfLiquid = valueOfInput;
+		solver.calculateConvectionCoefficient1();
+		solver.calculateResistanceOfThermalPenetration();
+		break;
+	}
+}
+/*!
+ * \brief solves the heat transfer problem for given value of free input
+ * \param problem inverse problem
+ * \param valueOfInput value of free input
+ * \return result minus target value
+ */
+double InverseSolver::getDifferenceFromTarget(const InverseProblem &problem, const double &valueOfInput)
+{
+	setFreeInput(problem.freeInput, valueOfInput);
+	temperatureOnIsolator = solver.findTemperatureOnIsolator(temperatureOnIsolator, problem.tolerance);
+	solver.setResults(temperatureOnIsolator);
+	const OutputData *results = solver.getResults();
+	if (problem.target == InverseProblem::temperatureOnIsolator) {
+		return results->temperatureOnIsolator - problem.targetValue;
+	}
+	return results->heatFlow1 - problem.targetValue;
+}
+/*!
+ * \brief finds the value of free input for which the result is equal to target value
+ * \param problem inverse problem
+ * \throw std::invalid_argument if the interval is wrong or the free input is the thickness or conductivity
+ * of isolator while layers are set (the layers replace these values)
+ * \throw std::runtime_error if target value can not be reached in the interval
+ * \return value of free input and results
+ */
+InverseResult InverseSolver::solve(const InverseProblem &problem)
+{
+	if (!(problem.upperInterval > problem.bottomInterval)) {
+		throw std::invalid_argument("Upper interval value has to be greater than bottom interval value.");
+	}
+	if (data.layers.size() > 0 && (problem.freeInput == InverseProblem::thicknessOfIsolator
+		|| problem.freeInput == InverseProblem::thermalConductivityOfIsolator)) {
+		throw std::invalid_argument("Thickness and conductivity of isolator can not be changed when layers are set.");
+	}
+	InverseResult inverse{};
+	double a = problem.bottomInterval;
+	double b = problem.upperInterval;
+	double fa = getDifferenceFromTarget(problem, a);
+	double fb = getDifferenceFromTarget(problem, b);
+	inverse.quantityOfIterations = 2;
+	if (fa*fb > 0) {
+		throw std::runtime_error("Target value can not be reached in the interval.");
+	}
+	if (std::abs(fa) < std::abs(fb)) {
+		std::swap(a, b);
+		std::swap(fa, fb);
+	}
+	double c = a, fc = fa, d = b - a;
+	bool isBisection = true;
+	while (std::abs(fb) > problem.toleranceOfTarget && inverse.quantityOfIterations < problem.maximumIterations) {
+		double s;
+		if (fa != fc && fb != fc) {
+			s = a * fb*fc / ((fa - fb)*(fa - fc)) + b * fa*fc / ((fb - fa)*(fb - fc)) + c * fa*fb / ((fc - fa)*(fc - fb));
+		}
+		else {
+			s = b - fb * (b - a) / (fb - fa);
+		}
+		double bound = (3 * a + b) / 4;
+		if ((s - bound)*(s - b) >= 0 ||
+			(isBisection && std::abs(s - b) >= std::abs(b - c) / 2) ||
+			(!isBisection && std::abs(s - b) >= std::abs(c - d) / 2) ||
+			std::abs(b - a) < 1e-12*std::abs(b)) {
+			s = 0.5*(a + b);
+			isBisection = true;
+		}
+		else {
+			isBisection = false;
+		}
+		double fs = getDifferenceFromTarget(problem, s);
+		++inverse.quantityOfIterations;
+		d = c;
+		c = b;
+		fc = fb;
+		if (fa*fs < 0) {
+			b = s;
+			fb = fs;
+		}
+		else {
+			a = s;
+			fa = fs;
+		}
+		if (std::abs(fa) < std::abs(fb)) {
+			std::swap(a, b);
+			std::swap(fa, fb);
+		}
+	}
+	getDifferenceFromTarget(problem, b);
+	inverse.valueOfInput = b;
+	inverse.results = *solver.getResults();
+	inverse.isConverged = std::abs(fb) <= problem.toleranceOfTarget;
+	if (!inverse.isConverged) {
+		inverse.results.status |= OutputData::statusNotConverged;
+	}
+	return inverse;
+}
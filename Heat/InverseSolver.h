@@ -0,0 +1,86 @@
+#pragma once
+#include "HeatTransferSolver.h"
+#include "InputData.h"
+#include "OutputData.h"
+#include "ThermalProperties.h"
+/*!
+ * \brief The InverseProblem class
+ * describes which result has to be reached by changing which input value
+ */
+class InverseProblem
+{
+public:
+    /*!
+     * \brief results which can be the target of inverse solve
+     */
+	enum Target { temperatureOnIsolator, heatFlow1 };
+    /*!
+     * \brief input values which can be changed by inverse solve
+     */
+	enum FreeInput { thicknessOfIsolator, thermalConductivityOfIsolator, emissivityOfIsolator,
+		meanTemperatureOfLiquid, meanVelocityOfLiquid };
+	Target target{ temperatureOnIsolator };
+	FreeInput freeInput{ thicknessOfIsolator };
+	double targetValue{ 0 };
+    /*!
+     * \brief interval of free input in which the solution is searched
+     */
+	double bottomInterval{ 0 };
+	double upperInterval{ 0 };
+    /*!
+     * \brief tolerance of target value
+     */
+	double toleranceOfTarget{ 0.001 };
+    /*!
+     * \brief tolerance used by solver
+     */
+	double tolerance{ 0.001 };
+	int maximumIterations{ 100 };
+};
+/*!
+ * \brief The InverseResult class
+ * stores the found value of free input and the results for it,
+ * if the target value was not reached in maximum iterations the best value is stored
+ * and OutputData::statusNotConverged is set in the status of results
+ */
+class InverseResult
+{
+public:
+	double valueOfInput{ 0 };
+	OutputData results{};
+	int quantityOfIterations{ 0 };
+    /*!
+     * \brief true if the result differs from target value less than tolerance of target
+     */
+	bool isConverged{ false };
+};
+/*!
+ * \brief The InverseSolver class
+ * finds the value of one input (e.g. thickness of isolator) for which the result
+ * (temperature on isolator or heat flow) is equal to target value.
+ * Brent's method (bisection, secant and inverse quadratic interpolation) is used around the solver,
+ * the solver is kept between the iterations: only the changed part of problem is calculated again
+ * and every solve starts from the temperature on isolator of the previous one
+ * \author Łukasz Dyraga
+ * \version 1.0
+ */
+class InverseSolver
+{
+public:
+	InverseSolver(const InputData &data, const ThermalProperties &liquid, const ThermalProperties &air);
+	InverseSolver(const InverseSolver &) = delete;
+	InverseSolver& operator=(const InverseSolver &) = delete;
+	InverseResult solve(const InverseProblem &problem);
+	double getDifferenceFromTarget(const InverseProblem &problem, const double &valueOfInput);
+private:
+	void setFreeInput(const InverseProblem::FreeInput &freeInput, const double &valueOfInput);
+    /*!
+     * \brief copy of input data changed by inverse solve
+     */
+	InputData data;
+	HeatTransferSolver solver;
+    /*!
+     * \brief temperature on isolator of the last solve
+     */
+	double temperatureOnIsolator;
+};
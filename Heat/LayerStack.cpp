@@ -0,0 +1,81 @@
+#include "LayerStack.h"
+#include <stdexcept>
+
+const int LayerStack::maximumQuantityOfLayers;
+/*!
+ * \brief adds the layer outside the previous ones
+ * \param thickness thickness of layer
+ * \param thermalConductivity thermal conductivity of layer
+ * \throw std::invalid_argument if thickness or thermal conductivity is not positive
+ * \throw std::length_error if the stack already has maximumQuantityOfLayers layers
+ */
+void LayerStack::addLayer(const double &thickness, const double &thermalConductivity)
+{
+	if (!(thickness > 0) || !(thermalConductivity > 0)) {
+		throw std::invalid_argument("Thickness and thermal conductivity of layer have to be positive.");
+	}
+	if (quantityOfLayers == maximumQuantityOfLayers) {
+		throw std::length_error("Too many layers.");
+	}
+	layers[quantityOfLayers] = Layer{ thickness, thermalConductivity };
+	++quantityOfLayers;
+}
+/*!
+ * \brief removes all layers
+ */
+void LayerStack::clear()
+{
+	quantityOfLayers = 0;
+}
+/*!
+ * \brief returns the quantity of layers
+ * \return quantity of layers
+ */
+int LayerStack::size() const
+{
+	return quantityOfLayers;
+}
+/*!
+ * \brief returns the layer
+ * \param index index of layer, 0 is the pipe wall
+ * \return layer
+ */
+const Layer& LayerStack::operator[](const int &index) const
+{
+	return layers[index];
+}
+/*!
+ * \brief calculates the thickness of all layers
+ * \return thickness of all layers
+ */
+double LayerStack::getThickness() const
+{
+	double thickness = 0;
+	for (int i = 0; i < quantityOfLayers; ++i) {
+		thickness += layers[i].thickness;
+	}
+	return thickness;
+}
+/*!
+ * \brief
+ * calculates the resistance of thermal conduction of all layers,
+ * the common quantities of layers use the unrolled versions
+ * \param innerDiameter inner diameter of pipe
+ * \param length length of pipe
+ * \return value of resistance of thermal conduction
+ */
+double LayerStack::getResistance(const double &innerDiameter, const double &length) const
+{
+	switch (quantityOfLayers) {
+	case 0:
+		return 0;
+	case 1:
+		return getResistanceOfLayers<1>(layers.data(), innerDiameter, length);
+	case 2:
+		return getResistanceOfLayers<2>(layers.data(), innerDiameter, length);
+	case 3:
+		return getResistanceOfLayers<3>(layers.data(), innerDiameter, length);
+	default:
+		return getResistanceOfLayers(layers.data(), quantityOfLayers, innerDiameter, length);
+	}
+}
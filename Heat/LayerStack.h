@@ -0,0 +1,79 @@
+#pragma once
+#include "MathConstants.h"
+#include <array>
+#include <math.h>
+/*!
+ * \brief The Layer class
+ * stores one cylindrical layer of pipe wall, isolator or jacket
+ */
+class Layer
+{
+public:
+	double thickness;
+	double thermalConductivity;
+};
+/*!
+ * \brief calculates the resistance of thermal conduction of layers connected in series
+ * \param layers the first layer starts at inner diameter
+ * \param quantityOfLayers quantity of layers
+ * \param innerDiameter inner diameter of the first layer
+ * \param length length of pipe
+ * \return value of resistance of thermal conduction
+ */
+inline double getResistanceOfLayers(const Layer *layers, const int &quantityOfLayers, const double &innerDiameter,
+	const double &length)
+{
+	double sum = 0;
+	double diameter = innerDiameter;
+	for (int i = 0; i < quantityOfLayers; ++i) {
+		double outerDiameter = diameter + 2 * layers[i].thickness;
+		sum += log(outerDiameter / diameter) / layers[i].thermalConductivity;
+		diameter = outerDiameter;
+	}
+	return sum / (2 * numberPi*length);
+}
+/*!
+ * \brief
+ * calculates the resistance of thermal conduction of layers connected in series,
+ * the quantity of layers is known at compile time so the loop is unrolled
+ * \param layers the first layer starts at inner diameter
+ * \param innerDiameter inner diameter of the first layer
+ * \param length length of pipe
+ * \return value of resistance of thermal conduction
+ */
+template<int QuantityOfLayers>
+double getResistanceOfLayers(const Layer *layers, const double &innerDiameter, const double &length)
+{
+	return getResistanceOfLayers(layers, QuantityOfLayers, innerDiameter, length);
+}
+/*!
+ * \brief The LayerStack class
+ * stores the ordered layers around the flowing liquid: pipe wall (the first layer),
+ * layers of isolator and jacket; the layers are kept in fixed-capacity array
+ * so copying and evaluating the stack never allocates memory
+ * \author Łukasz Dyraga
+ * \version 1.0
+ */
+class LayerStack
+{
+public:
+	void addLayer(const double &thickness, const double &thermalConductivity);
+	void clear();
+	int size() const;
+	const Layer& operator[](const int &index) const;
+	double getThickness() const;
+	double getResistance(const double &innerDiameter, const double &length) const;
+    /*!
+     * \brief maximum quantity of layers
+     */
+	static const int maximumQuantityOfLayers{ 8 };
+private:
+    /*!
+     * \brief layers, the first quantityOfLayers are used
+     */
+	std::array<Layer, maximumQuantityOfLayers> layers{};
+    /*!
+     * \brief quantity of used layers
+     */
+	int quantityOfLayers{ 0 };
+};
@@ -0,0 +1,5 @@
+#pragma once
+/*!
+ * \brief ratio of circumference of circle to its diameter, used by all equations of model
+ */
+const double numberPi{ 3.141592653589793238 };
@@ -0,0 +1,194 @@
+#include "MixedPrecisionSolver.h"
+#include "TraceRecorder.h"
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+
+/*!
+ * \brief constructor, calculates the remaining data and the initial values
+ * \param data stores the input data
+ * \param liquid stores the properties of liquid which flows through pipe
+ * \param air stores the properties of air, it has to outlive the solver
+ * \throw std::invalid_argument if the layers are set
+ */
+MixedPrecisionSolver::MixedPrecisionSolver(InputData &data, const ThermalProperties &liquid, const ThermalProperties &air):
+	data{&data},liquid{&liquid},air{&air},model{data, liquid, air},results{}
+{
+	if (data.layers.size() > 0) {
+		throw std::invalid_argument("layers are not supported by mixed precision solver");
+	}
+	this->data->calculateTheRemainingData();
+	model.calculateTheRemainingData();
+	model.calculateInitialValues();
+}
+/*!
+ * \brief
+ * finds the temperature on isolator by bisection method and sets the results,
+ * the division by zero is flagged if it happened in root finding or final values
+ * \param tolerance value of tolerance
+ */
+void MixedPrecisionSolver::runTheSolver(const double &tolerance)
+{
+	HEAT_TRACE_SCOPE("solve in mixed precision", "solver");
+	switch (data->typeOfNaturalConvection) {
+	case 1:
+		runTheSolverWith<ChurchillChuNaturalConvection>(tolerance);
+		break;
+	default:
+		runTheSolverWith<SimplifiedNaturalConvection>(tolerance);
+		break;
+	}
+}
+/*!
+ * \brief finds the temperature on isolator and sets the results, see runTheSolver
+ * \tparam Natural correlation of natural convection, see ConvectionCorrelation.h
+ * \param tolerance value of tolerance
+ */
+template<class Natural>
+void MixedPrecisionSolver::runTheSolverWith(const double &tolerance)
+{
+	double a = std::min(data->meanTemperatureOfLiquid, data->temperatureOfEnvironment);
+	double b = std::max(data->meanTemperatureOfLiquid, data->temperatureOfEnvironment);
+	double x0 = 0.5*(a + b);
+	model.isDividedByZero = false;
+	double valueAtA = getDifferenceOfHeatFlowsWith<Natural>(a);
+	bool isConverged = std::abs(a - b) <= tolerance;
+	while (std::abs(a - b) > tolerance) {
+		x0 = (a + b) / 2;
+		double valueAtX0 = getDifferenceOfHeatFlowsWith<Natural>(x0);
+		if (std::abs(valueAtX0) <= tolerance) {
+			isConverged = true;
+			break;
+		}
+		else if (valueAtX0 * valueAtA < 0) {
+			b = x0;
+			isConverged = true;
+		}
+		else {
+			a = x0;
+			valueAtA = valueAtX0;
+		}
+	}
+	float valueOfResults[OutputData::quantityOfFields];
+	model.getResultsWith<Natural>(static_cast<float>(x0), valueOfResults);
+	double value[OutputData::quantityOfFields];
+	std::copy(valueOfResults, valueOfResults + OutputData::quantityOfFields, value);
+	results.setValuesFrom(value);
+	results.temperatureOnIsolator = x0;
+	results.status = isConverged ? 0u : static_cast<unsigned int>(OutputData::statusNotConverged);
+	if (model.isDividedByZero) {
+		results.status |= OutputData::statusDivisionByZero;
+	}
+	if (!liquid->isInRange(data->meanTemperatureOfLiquid) || !air->isInRange(0.5*(x0 + data->temperatureOfEnvironment))) {
+		results.status |= OutputData::statusExtrapolation;
+	}
+	results.addStatusOfValues();
+}
+/*!
+ * \brief
+ * calculates the difference between heat flow 2 and heat flow 1,
+ * the heat flows are calculated in single precision and subtracted in double precision
+ * \param temperatureOnIsolator value of temperature on isolator
+ * \return value of difference between heat flows
+ */
+double MixedPrecisionSolver::getDifferenceOfHeatFlows(const double &temperatureOnIsolator)
+{
+	switch (data->typeOfNaturalConvection) {
+	case 1:
+		return getDifferenceOfHeatFlowsWith<ChurchillChuNaturalConvection>(temperatureOnIsolator);
+	default:
+		return getDifferenceOfHeatFlowsWith<SimplifiedNaturalConvection>(temperatureOnIsolator);
+	}
+}
+/*!
+ * \brief calculates the difference between heat flow 2 and heat flow 1, see getDifferenceOfHeatFlows
+ * \tparam Natural correlation of natural convection, see ConvectionCorrelation.h
+ * \param temperatureOnIsolator value of temperature on isolator
+ * \return value of difference between heat flows
+ */
+template<class Natural>
+double MixedPrecisionSolver::getDifferenceOfHeatFlowsWith(const double &temperatureOnIsolator)
+{
+	float temperature = static_cast<float>(temperatureOnIsolator);
+	return static_cast<double>(model.getHeatFlow2With<Natural>(temperature))
+		- static_cast<double>(model.getHeatFlow1(temperature));
+}
+/*!
+ * \brief returns the results obtained from solver
+ * \return values of results
+ */
+OutputData * MixedPrecisionSolver::getResults()
+{
+	return &results;
+}
+/*!
+ * \brief compares the results of one case
+ * \param reference results calculated in double precision
+ * \param result results to compare
+ */
+void PrecisionDeviation::add(const OutputData &reference, const OutputData &result)
+{
+	if (reference.status != result.status) {
+		++quantityOfDifferentStatus;
+	}
+	const unsigned int incorrect = OutputData::statusNotANumber | OutputData::statusInfinity
+		| OutputData::statusDivisionByZero | OutputData::statusNotConverged;
+	if ((reference.status | result.status) & incorrect) {
+		++quantityOfSkippedCases;
+		++quantityOfCases;
+		return;
+	}
+	double referenceValue[OutputData::quantityOfFields];
+	double value[OutputData::quantityOfFields];
+	reference.copyValuesTo(referenceValue);
+	result.copyValuesTo(value);
+	for (int i = 0; i < OutputData::quantityOfFields; ++i) {
+		double scale = std::abs(referenceValue[i]);
+		double deviation = scale > 0 ? std::abs(value[i] - referenceValue[i]) / scale : std::abs(value[i]);
+		if (deviation > maximumDeviation[i]) {
+			maximumDeviation[i] = deviation;
+			caseOfMaximumDeviation[i] = quantityOfCases;
+		}
+	}
+	++quantityOfCases;
+}
+/*!
+ * \brief compares the results of batch
+ * \param reference results calculated in double precision
+ * \param results results to compare, in the same order as reference
+ * \return deviation of results
+ * \throw std::invalid_argument if the quantities of results are different
+ */
+PrecisionDeviation PrecisionDeviation::compare(const std::vector<OutputData> &reference, const std::vector<OutputData> &results)
+{
+	if (reference.size() != results.size()) {
+		throw std::invalid_argument("different quantity of results");
+	}
+	PrecisionDeviation deviation{};
+	for (size_t i = 0; i < results.size(); ++i) {
+		deviation.add(reference[i], results[i]);
+	}
+	return deviation;
+}
+/*!
+ * \brief describes the deviation, one line for each results value with the case of maximum deviation
+ * \return text of deviation
+ */
+std::string PrecisionDeviation::toText() const
+{
+	std::ostringstream text;
+	text << "maximum relative deviation from double precision in " << quantityOfCases << " cases";
+	if (quantityOfSkippedCases > 0) {
+		text << ", " << quantityOfSkippedCases << " not compared";
+	}
+	if (quantityOfDifferentStatus > 0) {
+		text << ", " << quantityOfDifferentStatus << " with different status";
+	}
+	text << ":\n";
+	for (int i = 0; i < OutputData::quantityOfFields; ++i) {
+		text << "  " << OutputData::fieldNames[i] << ' ' << maximumDeviation[i]
+			<< " (case " << caseOfMaximumDeviation[i] << ")\n";
+	}
+	return text.str();
+}
@@ -0,0 +1,80 @@
+#pragma once
+#include "InputData.h"
+#include "OutputData.h"
+#include "ThermalProperties.h"
+#include "HeatTransferModel.h"
+#include <string>
+#include <vector>
+/*!
+ * \brief The MixedPrecisionSolver class
+ * solves the heat transfer problem for screening studies where 4-5 significant digits are enough:
+ * the properties of fluids, coefficients and heat flows are calculated in single precision
+ * (HeatTransferModel<float>), the temperature on isolator found by bisection method
+ * and the difference of heat flows are kept in double precision;
+ * the interval is between the temperature of liquid and environment,
+ * the correlation of natural convection is chosen once for the whole solve,
+ * the status flags of results are set as by HeatTransferSolver, the layers are not supported
+ * \author Łukasz Dyraga
+ * \version 1.0
+ */
+class MixedPrecisionSolver
+{
+public:
+	MixedPrecisionSolver(InputData &data, const ThermalProperties &liquid, const ThermalProperties &air);
+	MixedPrecisionSolver(const MixedPrecisionSolver &) = delete;
+	MixedPrecisionSolver& operator=(const MixedPrecisionSolver &) = delete;
+	void runTheSolver(const double &tolerance = 0.001);
+	double getDifferenceOfHeatFlows(const double &temperatureOnIsolator);
+	OutputData* getResults();
+private:
+	template<class Natural>
+	void runTheSolverWith(const double &tolerance);
+	template<class Natural>
+	double getDifferenceOfHeatFlowsWith(const double &temperatureOnIsolator);
+    /*!
+     * \brief stores the input data
+     */
+	InputData *data;
+	const ThermalProperties *liquid;
+	const ThermalProperties *air;
+    /*!
+     * \brief equations of solver in single precision
+     */
+	HeatTransferModel<float> model;
+    /*!
+     * \brief stores the output data (results)
+     */
+	OutputData results;
+};
+/*!
+ * \brief The PrecisionDeviation class
+ * finds the maximum relative deviation of results of batch from the reference results (double precision),
+ * the cases which are not converged, divided by zero or not finite in any of results are not compared
+ */
+class PrecisionDeviation
+{
+public:
+	void add(const OutputData &reference, const OutputData &result);
+	static PrecisionDeviation compare(const std::vector<OutputData> &reference, const std::vector<OutputData> &results);
+	std::string toText() const;
+    /*!
+     * \brief quantity of compared cases
+     */
+	size_t quantityOfCases{ 0 };
+    /*!
+     * \brief quantity of cases which are not compared
+     */
+	size_t quantityOfSkippedCases{ 0 };
+    /*!
+     * \brief quantity of cases which have different status flags
+     */
+	size_t quantityOfDifferentStatus{ 0 };
+    /*!
+     * \brief maximum relative deviation of each results value, the order is the same as in OutputData::fieldNames
+     */
+	double maximumDeviation[OutputData::quantityOfFields]{};
+    /*!
+     * \brief index of case with maximum deviation of each results value
+     */
+	size_t caseOfMaximumDeviation[OutputData::quantityOfFields]{};
+};
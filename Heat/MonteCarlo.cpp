@@ -0,0 +1,283 @@
+#include "MonteCarlo.h"
+#include "HeatTransferSolver.h"
+#include "MathConstants.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <thread>
+
+const int MonteCarlo::maximumQuantityOfDraws;
+/*!
+ * \brief
+ * adds the result of one sample, the results which are not finite, divided by zero or not converged
+ * are skipped (counted only), the extrapolation of properties is accepted
+ * \param result results of sample
+ */
+void MonteCarloAccumulator::add(const OutputData &result)
+{
+	const unsigned int suspectStatus = OutputData::statusNotANumber | OutputData::statusInfinity
+		| OutputData::statusDivisionByZero | OutputData::statusNotConverged;
+	double value[OutputData::quantityOfFields];
+	result.copyValuesTo(value);
+	if ((result.status & suspectStatus) != 0
+		|| !std::all_of(value, value + OutputData::quantityOfFields, [](double v) { return std::isfinite(v); })) {
+		skip();
+		return;
+	}
+	++quantityOfSamples;
+	for (int i = 0; i < OutputData::quantityOfFields; ++i) {
+		double difference = value[i] - mean[i];
+		mean[i] += difference / quantityOfSamples;
+		sumOfSquares[i] += difference * (value[i] - mean[i]);
+		values[i].push_back(value[i]);
+	}
+}
+/*!
+ * \brief counts the sample which is not in statistics
+ */
+void MonteCarloAccumulator::skip()
+{
+	++quantityOfSkippedSamples;
+}
+/*!
+ * \brief merges other accumulator into this one, the other accumulator is emptied
+ * \param other accumulator of other thread
+ */
+void MonteCarloAccumulator::merge(MonteCarloAccumulator &other)
+{
+	quantityOfSkippedSamples += other.quantityOfSkippedSamples;
+	other.quantityOfSkippedSamples = 0;
+	if (other.quantityOfSamples == 0) {
+		return;
+	}
+	double quantity = static_cast<double>(quantityOfSamples + other.quantityOfSamples);
+	for (int i = 0; i < OutputData::quantityOfFields; ++i) {
+		double difference = other.mean[i] - mean[i];
+		mean[i] += difference * other.quantityOfSamples / quantity;
+		sumOfSquares[i] += other.sumOfSquares[i] + difference * difference*quantityOfSamples*other.quantityOfSamples / quantity;
+		values[i].insert(values[i].end(), other.values[i].begin(), other.values[i].end());
+		other.values[i].clear();
+		other.mean[i] = 0;
+		other.sumOfSquares[i] = 0;
+	}
+	quantityOfSamples += other.quantityOfSamples;
+	other.quantityOfSamples = 0;
+}
+/*!
+ * \brief calculates the statistics of collected samples, the order of stored values is changed
+ * \param percentiles calculated percentiles, from 0 to 1
+ * \return statistics
+ */
+MonteCarloResults MonteCarloAccumulator::getResults(const std::vector<double> &percentiles)
+{
+	MonteCarloResults results{};
+	results.quantityOfSamples = quantityOfSamples;
+	results.quantityOfSkippedSamples = quantityOfSkippedSamples;
+	if (quantityOfSamples == 0) {
+		return results;
+	}
+	for (int i = 0; i < OutputData::quantityOfFields; ++i) {
+		FieldStatistics &field = results.fields[i];
+		field.mean = mean[i];
+		field.variance = quantityOfSamples > 1 ? sumOfSquares[i] / (quantityOfSamples - 1) : 0;
+		auto bounds = std::minmax_element(values[i].begin(), values[i].end());
+		field.minimum = *bounds.first;
+		field.maximum = *bounds.second;
+		for (const auto &percentile : percentiles) {
+			size_t position = static_cast<size_t>(std::round(std::min(1.0, std::max(0.0, percentile))*(values[i].size() - 1)));
+			std::nth_element(values[i].begin(), values[i].begin() + position, values[i].end());
+			field.percentiles.push_back(values[i][position]);
+		}
+	}
+	return results;
+}
+/*!
+ * \brief constructor
+ * \param fluids properties of all liquids and air, they have to outlive the object
+ * \param settings distributions and settings of run
+ */
+MonteCarlo::MonteCarlo(const FluidLibrary &fluids, const MonteCarloSettings &settings):
+	fluids{&fluids},settings{settings}
+{
+}
+/*!
+ * \brief calculates the uniform random number from (0,1) which depends only on its counters (SplitMix64 hash)
+ * \param seed seed of run
+ * \param sample index of sample
+ * \param index index of number in sample
+ * \return random number
+ */
+double MonteCarlo::getUniformNumber(const std::uint64_t &seed, const std::uint64_t &sample, const std::uint64_t &index)
+{
+	std::uint64_t z = seed + sample * 0x9E3779B97F4A7C15ULL + (index + 1) * 0xD1B54A32D192ED03ULL;
+	for (int round = 0; round < 2; ++round) {
+		z += 0x9E3779B97F4A7C15ULL;
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+		z ^= z >> 31;
+	}
+	return ((z >> 11) + 0.5) * (1.0 / 9007199254740992.0);
+}
+/*!
+ * \brief checks if the value of input is physical: temperatures, sizes, velocity and conductivity are positive,
+ * emissivity is from 0 to 1
+ * \param input index of input (MonteCarloSettings::UncertainInput)
+ * \param value value of input
+ * \return true if the value is physical
+ */
+bool MonteCarlo::isPhysical(const int &input, const double &value)
+{
+	if (input == MonteCarloSettings::emissivityOfIsolator) {
+		return value >= 0 && value <= 1;
+	}
+	return value > 0 && std::isfinite(value);
+}
+/*!
+ * \brief draws the value of one input
+ * \param distribution distribution of input
+ * \param value value from pipe class
+ * \param sample index of sample
+ * \param index index of draw, the input is drawn again with other index if its value is not physical
+ * \return value of input
+ */
+double MonteCarlo::drawValue(const Distribution &distribution, const double &value, const std::uint64_t &sample,
+	const std::uint64_t &index) const
+{
+	switch (distribution.type) {
+	case Distribution::uniform:
+		return distribution.first + (distribution.second - distribution.first)*getUniformNumber(settings.seed, sample, 2 * index);
+	case Distribution::normal: {
+		double u1 = getUniformNumber(settings.seed, sample, 2 * index);
+		double u2 = getUniformNumber(settings.seed, sample, 2 * index + 1);
+		return distribution.first + distribution.second*sqrt(-2 * log(u1))*cos(2 * numberPi*u2);
+	}
+	case Distribution::triangular: {
+		double u = getUniformNumber(settings.seed, sample, 2 * index);
+		double range = distribution.second - distribution.first;
+		double ratio = (value - distribution.first) / range;
+		if (u < ratio) {
+			return distribution.first + sqrt(u*range*(value - distribution.first));
+		}
+		return distribution.second - sqrt((1 - u)*range*(distribution.second - value));
+	}
+	default:
+		return value;
+	}
+}
+/*!
+ * \brief
+ * draws one sample of input data, the value of input which is not physical is drawn again
+ * (the normal distribution is truncated), at most maximumQuantityOfDraws times
+ * \param sample index of sample
+ * \param data input data of sample, geometry and radiant energy exchange are calculated
+ * \param pipeClass input data of pipe class, the values of constant inputs are taken from it
+ * \return false if a physical value of input was not drawn, the sample has to be skipped
+ */
+bool MonteCarlo::drawSample(const std::uint64_t &sample, InputData &data, const InputData &pipeClass) const
+{
+	double InputData::*const membersOfInputs[MonteCarloSettings::quantityOfUncertainInputs] = {
+		&InputData::innerDiameterOfPipe, &InputData::thicknessOfPipe, &InputData::meanVelocityOfLiquid,
+		&InputData::meanTemperatureOfLiquid, &InputData::thermalConductivityOfIsolator, &InputData::thicknessOfIsolator,
+		&InputData::temperatureOfEnvironment, &InputData::emissivityOfIsolator, &InputData::lengthOfPipe };
+	for (int input = 0; input < MonteCarloSettings::quantityOfUncertainInputs; ++input) {
+		double InputData::*member = membersOfInputs[input];
+		int draw = 0;
+		do {
+			if (draw == maximumQuantityOfDraws) {
+				return false;
+			}
+			data.*member = drawValue(settings.distributions[input], pipeClass.*member, sample,
+				input + static_cast<std::uint64_t>(draw) * MonteCarloSettings::quantityOfUncertainInputs);
+			++draw;
+		} while (settings.distributions[input].type != Distribution::constant && !isPhysical(input, data.*member));
+	}
+	data.calculateTheRemainingData();
+	return true;
+}
+/*!
+ * \brief solves the samples one after another, every solve starts from the previous temperature on isolator
+ * \param pipeClass pipe class
+ * \param begin index of first sample
+ * \param end index after last sample
+ * \param accumulator accumulator of results
+ */
+void MonteCarlo::solveSamples(const BatchCase &pipeClass, const std::uint64_t &begin, const std::uint64_t &end,
+	MonteCarloAccumulator &accumulator) const
+{
+	InputData data{ pipeClass.data };
+	HeatTransferSolver solver{ data, fluids->liquid(pipeClass.typeOfLiquid), fluids->air() };
+	double temperatureOnIsolator = 0.5*(data.meanTemperatureOfLiquid + data.temperatureOfEnvironment);
+	for (std::uint64_t sample = begin; sample < end; ++sample) {
+		if (!drawSample(sample, data, pipeClass.data)) {
+			accumulator.skip();
+			continue;
+		}
+		solver.calculateInitialValues();
+		temperatureOnIsolator = solver.findTemperatureOnIsolator(temperatureOnIsolator, settings.tolerance);
+		solver.setResults(temperatureOnIsolator);
+		accumulator.add(*solver.getResults());
+	}
+}
+/*!
+ * \brief draws and solves the samples of pipe class and calculates the statistics of results
+ * \param pipeClass pipe class, the values of constant inputs are taken from it
+ * \throw std::invalid_argument if the pipe class has layers or unknown liquid, a distribution is wrong,
+ * it is outside the physical range of input or the value of pipe class (mode) is outside its triangular distribution
+ * \return statistics of all fields of results
+ */
+MonteCarloResults MonteCarlo::run(const BatchCase &pipeClass) const
+{
+	if (pipeClass.data.layers.size() > 0) {
+		throw std::invalid_argument("Monte Carlo does not support layers.");
+	}
+	if (pipeClass.typeOfLiquid < 0 || pipeClass.typeOfLiquid >= FluidLibrary::quantityOfLiquids) {
+		throw std::invalid_argument("Unknown type of liquid.");
+	}
+	const InputData &data = pipeClass.data;
+	const double valueOfInput[MonteCarloSettings::quantityOfUncertainInputs] = { data.innerDiameterOfPipe,
+		data.thicknessOfPipe, data.meanVelocityOfLiquid, data.meanTemperatureOfLiquid, data.thermalConductivityOfIsolator,
+		data.thicknessOfIsolator, data.temperatureOfEnvironment, data.emissivityOfIsolator, data.lengthOfPipe };
+	for (int i = 0; i < MonteCarloSettings::quantityOfUncertainInputs; ++i) {
+		const Distribution &distribution = settings.distributions[i];
+		if ((distribution.type == Distribution::uniform || distribution.type == Distribution::triangular)
+			&& !(distribution.second > distribution.first)) {
+			throw std::invalid_argument("Upper value of distribution has to be greater than bottom value.");
+		}
+		if (distribution.type == Distribution::triangular
+			&& (valueOfInput[i] < distribution.first || valueOfInput[i] > distribution.second)) {
+			throw std::invalid_argument("Value of pipe class has to be between bottom and upper value of triangular distribution.");
+		}
+		if (distribution.type == Distribution::normal && distribution.second < 0) {
+			throw std::invalid_argument("Standard deviation can not be negative.");
+		}
+		if ((distribution.type == Distribution::normal && !isPhysical(i, distribution.first))
+			|| ((distribution.type == Distribution::uniform || distribution.type == Distribution::triangular)
+				&& (!(distribution.first >= 0) || !isPhysical(i, distribution.second)))) {
+			throw std::invalid_argument("Distribution has to be in the physical range of input.");
+		}
+	}
+	std::uint64_t quantityOfParts = std::max<std::uint64_t>(1,
+		std::min<std::uint64_t>(settings.quantityOfThreads, settings.quantityOfSamples));
+	std::vector<MonteCarloAccumulator> accumulators(quantityOfParts);
+	if (quantityOfParts == 1) {
+		solveSamples(pipeClass, 0, settings.quantityOfSamples, accumulators[0]);
+	}
+	else {
+		std::vector<std::thread> threads;
+		std::uint64_t partSize = settings.quantityOfSamples / quantityOfParts;
+		std::uint64_t remainder = settings.quantityOfSamples % quantityOfParts;
+		for (std::uint64_t part = 0, begin = 0; part < quantityOfParts; ++part) {
+			std::uint64_t size = partSize + (part < remainder ? 1 : 0);
+			threads.emplace_back(&MonteCarlo::solveSamples, this, std::cref(pipeClass), begin, begin + size,
+				std::ref(accumulators[part]));
+			begin += size;
+		}
+		for (auto &thread : threads) {
+			thread.join();
+		}
+		for (std::uint64_t part = 1; part < quantityOfParts; ++part) {
+			accumulators[0].merge(accumulators[part]);
+		}
+	}
+	return accumulators[0].getResults(settings.percentiles);
+}
@@ -0,0 +1,139 @@
+#pragma once
+#include "BatchRunner.h"
+#include "FluidLibrary.h"
+#include "OutputData.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+/*!
+ * \brief The Distribution class
+ * describes the distribution of one uncertain input value,
+ * uniform: first - bottom value, second - upper value,
+ * normal: first - mean value, second - standard deviation,
+ * triangular: first - bottom value, second - upper value, mode is the value from pipe class,
+ * the values are drawn only from the physical range of input (see MonteCarlo::isPhysical),
+ * the normal distribution is truncated to it
+ */
+class Distribution
+{
+public:
+	enum Type { constant, uniform, normal, triangular };
+	Distribution() = default;
+	Distribution(const Type &type, const double &first, const double &second):
+		type{type},first{first},second{second} {}
+	Type type{ constant };
+	double first{ 0 };
+	double second{ 0 };
+};
+/*!
+ * \brief The MonteCarloSettings class
+ * stores the distributions of uncertain inputs and the settings of Monte Carlo run
+ */
+class MonteCarloSettings
+{
+public:
+    /*!
+     * \brief input values which can be uncertain
+     */
+	enum UncertainInput { innerDiameterOfPipe, thicknessOfPipe, meanVelocityOfLiquid, meanTemperatureOfLiquid,
+		thermalConductivityOfIsolator, thicknessOfIsolator, temperatureOfEnvironment, emissivityOfIsolator,
+		lengthOfPipe, quantityOfUncertainInputs };
+	std::array<Distribution, quantityOfUncertainInputs> distributions{};
+	std::uint64_t quantityOfSamples{ 10000 };
+    /*!
+     * \brief seed of random numbers, the samples do not depend on the quantity of threads
+     */
+	std::uint64_t seed{ 0 };
+	unsigned int quantityOfThreads{ 1 };
+	double tolerance{ 0.001 };
+    /*!
+     * \brief calculated percentiles, from 0 to 1
+     */
+	std::vector<double> percentiles{ 0.05, 0.5, 0.95 };
+};
+/*!
+ * \brief The FieldStatistics class
+ * stores the statistics of one field of OutputData
+ */
+class FieldStatistics
+{
+public:
+	double mean{ 0 };
+	double variance{ 0 };
+	double minimum{ 0 };
+	double maximum{ 0 };
+    /*!
+     * \brief values of percentiles given in settings
+     */
+	std::vector<double> percentiles{};
+};
+/*!
+ * \brief The MonteCarloResults class
+ * stores the statistics of all fields of OutputData, in the order of OutputData::fieldNames
+ */
+class MonteCarloResults
+{
+public:
+	std::uint64_t quantityOfSamples{ 0 };
+    /*!
+     * \brief
+     * quantity of samples which are not in statistics: no physical value of input was drawn
+     * or the results are not finite, divided by zero or not converged
+     */
+	std::uint64_t quantityOfSkippedSamples{ 0 };
+	std::array<FieldStatistics, OutputData::quantityOfFields> fields{};
+};
+/*!
+ * \brief The MonteCarloAccumulator class
+ * collects the results of samples solved by one thread,
+ * accumulators of different threads can be merged
+ */
+class MonteCarloAccumulator
+{
+public:
+	void add(const OutputData &result);
+	void skip();
+	void merge(MonteCarloAccumulator &other);
+	MonteCarloResults getResults(const std::vector<double> &percentiles);
+private:
+	std::uint64_t quantityOfSamples{ 0 };
+	std::uint64_t quantityOfSkippedSamples{ 0 };
+	std::array<double, OutputData::quantityOfFields> mean{};
+    /*!
+     * \brief sum of squares of differences from mean (Welford's algorithm)
+     */
+	std::array<double, OutputData::quantityOfFields> sumOfSquares{};
+	std::array<std::vector<double>, OutputData::quantityOfFields> values{};
+};
+/*!
+ * \brief The MonteCarlo class
+ * propagates the uncertainty of input data to the results: the samples are drawn
+ * from the distributions of inputs and solved by many threads. The random numbers are
+ * counter based (calculated from seed, sample and input index), so every thread draws its own
+ * samples without shared state and the results do not depend on the quantity of threads
+ * \author Łukasz Dyraga
+ * \version 1.0
+ */
+class MonteCarlo
+{
+public:
+	MonteCarlo(const FluidLibrary &fluids, const MonteCarloSettings &settings);
+	MonteCarloResults run(const BatchCase &pipeClass) const;
+	bool drawSample(const std::uint64_t &sample, InputData &data, const InputData &pipeClass) const;
+	static double getUniformNumber(const std::uint64_t &seed, const std::uint64_t &sample, const std::uint64_t &index);
+	static bool isPhysical(const int &input, const double &value);
+private:
+	void solveSamples(const BatchCase &pipeClass, const std::uint64_t &begin, const std::uint64_t &end,
+		MonteCarloAccumulator &accumulator) const;
+	double drawValue(const Distribution &distribution, const double &value, const std::uint64_t &sample,
+		const std::uint64_t &index) const;
+    /*!
+     * \brief maximum quantity of draws of input from truncated normal distribution
+     */
+	static const int maximumQuantityOfDraws{ 100 };
+    /*!
+     * \brief properties of all liquids and air
+     */
+	const FluidLibrary *fluids;
+	MonteCarloSettings settings;
+};
@@ -1,6 +1,22 @@
 #pragma once
 #include <math.h>
 
+/*!
+ * \brief The NaturalConvectionRegime class
+ * stores the parameters of natural convection equation for one regime of flow
+ */
+class NaturalConvectionRegime
+{
+public:
+    /*!
+     * \brief parameter used in natural convection equation
+     */
+	double C;
+    /*!
+     * \brief parameter used in natural convection equation
+     */
+	double A;
+};
 /*!
  * \brief The NaturalConvection class
  * stores the parameters of natural convection
@@ -13,6 +29,41 @@ public:
 	NaturalConvection();
 	~NaturalConvection();
 	void setValueOfAandC(const double productOfGrasshofAndPrandtl);
+	/*!
+	 * \brief
+	 * finds the regime of flow without branches, the index is the quantity of thresholds
+	 * which are not greater than productOfGrAndPr (NaN gives no flow)
+	 * \param productOfGrAndPr product of Grashof number and Prandtl number
+	 * \return index of regime: 0-no flow, 1-laminar, 2-transitional, 3-turbulent flow
+	 */
+	static constexpr int getIndexOfRegime(const double &productOfGrAndPr)
+	{
+		return int(productOfGrAndPr >= thresholds[0]) + int(productOfGrAndPr >= thresholds[1])
+			+ int(productOfGrAndPr >= thresholds[2]);
+	}
+	/*!
+	 * \brief returns the parameters of natural convection depends on productOfGrAndPr
+	 * \param productOfGrAndPr product of Grashof number and Prandtl number
+	 * \return parameters C and A
+	 */
+	static constexpr NaturalConvectionRegime getRegime(const double &productOfGrAndPr)
+	{
+		return regimes[getIndexOfRegime(productOfGrAndPr)];
+	}
+    /*!
+     * \brief quantity of regimes of flow
+     */
+	static constexpr int quantityOfRegimes{ 4 };
+    /*!
+     * \brief the lowest product of Grashof and Prandtl numbers of laminar, transitional and turbulent flow
+     */
+	static constexpr double thresholds[quantityOfRegimes - 1]{ 1e-3, 5e2, 2e7 };
+    /*!
+     * \brief parameters of regimes: no flow, laminar, transitional and turbulent flow
+     */
+	static constexpr NaturalConvectionRegime regimes[quantityOfRegimes]{
+		{ 0.45, 0 }, { 1.18, 0.125 }, { 0.54, 0.25 }, { 0.135, 0.33 }
+	};
     /*!
      * \brief parameter used in natural convection equation
      */
@@ -22,4 +73,3 @@ public:
      */
 	double C;
 };
-
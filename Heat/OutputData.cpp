@@ -1,6 +1,28 @@
 #include "OutputData.h"
+#include <cmath>
 
+const int OutputData::quantityOfFields;
+const char *const OutputData::fieldNames[OutputData::quantityOfFields]{
+	"temperatureOnIsolator",
+	"convectionCoefficient1",
+	"convectionCoefficient2",
+	"radiationCoefficient2",
+	"heatFlowByConvection2",
+	"heatFlowByRadiation2",
+	"heatFlow1",
+	"heatFlow2",
+	"resistanceOfThermalConduction",
+	"resistanceOfThermalPenetration"
+};
 
+const int OutputData::quantityOfStatusFlags;
+const char *const OutputData::statusNames[OutputData::quantityOfStatusFlags]{
+	"not a number",
+	"infinity",
+	"division by zero",
+	"extrapolation of properties",
+	"not converged"
+};
 
 OutputData::OutputData()
 {
@@ -11,3 +33,71 @@ OutputData::~OutputData()
 {
 }
 
+/*!
+ * \brief copies the results values into the array
+ * \param values array with at least quantityOfFields elements, the order is the same as in fieldNames
+ */
+void OutputData::copyValuesTo(double *values) const
+{
+	values[0] = temperatureOnIsolator;
+	values[1] = convectionCoefficient1;
+	values[2] = convectionCoefficient2;
+	values[3] = radiationCoefficient2;
+	values[4] = heatFlowByConvection2;
+	values[5] = heatFlowByRadiation2;
+	values[6] = heatFlow1;
+	values[7] = heatFlow2;
+	values[8] = resistanceOfThermalConduction;
+	values[9] = resistanceOfThermalPenetration;
+}
+/*!
+ * \brief sets the results values from the array
+ * \param values array with at least quantityOfFields elements, the order is the same as in fieldNames
+ */
+void OutputData::setValuesFrom(const double *values)
+{
+	temperatureOnIsolator = values[0];
+	convectionCoefficient1 = values[1];
+	convectionCoefficient2 = values[2];
+	radiationCoefficient2 = values[3];
+	heatFlowByConvection2 = values[4];
+	heatFlowByRadiation2 = values[5];
+	heatFlow1 = values[6];
+	heatFlow2 = values[7];
+	resistanceOfThermalConduction = values[8];
+	resistanceOfThermalPenetration = values[9];
+}
+/*!
+ * \brief sets the not a number and infinity flags of status if any of results values is not finite
+ */
+void OutputData::addStatusOfValues()
+{
+	double values[quantityOfFields];
+	copyValuesTo(values);
+	for (int i = 0; i < quantityOfFields; ++i) {
+		if (std::isnan(values[i])) {
+			status |= statusNotANumber;
+		}
+		else if (std::isinf(values[i])) {
+			status |= statusInfinity;
+		}
+	}
+}
+/*!
+ * \brief describes the status flags
+ * \param status status flags
+ * \return names of set flags separated by comma, empty if no flag is set
+ */
+std::string OutputData::getStatusDescription(const unsigned int &status)
+{
+	std::string description;
+	for (int i = 0; i < quantityOfStatusFlags; ++i) {
+		if (status & (1u << i)) {
+			if (!description.empty()) {
+				description += ", ";
+			}
+			description += statusNames[i];
+		}
+	}
+	return description;
+}
@@ -1,4 +1,5 @@
 #pragma once
+#include <string>
 /*!
  * \brief The OutputData class
  * stores the results values,
@@ -13,6 +14,38 @@ class OutputData
 public:
 	OutputData();
 	~OutputData();
+	void copyValuesTo(double *values) const;
+	void setValuesFrom(const double *values);
+	void addStatusOfValues();
+	static std::string getStatusDescription(const unsigned int &status);
+    /*!
+     * \brief
+     * flags of status, they are set by the solver instead of throwing or displaying warnings,
+     * any flag except extrapolation means the results of case may be incorrect, extrapolation is only noted
+     */
+	enum StatusFlag : unsigned int {
+		statusNotANumber = 1u << 0,
+		statusInfinity = 1u << 1,
+		statusDivisionByZero = 1u << 2,
+		statusExtrapolation = 1u << 3,
+		statusNotConverged = 1u << 4
+	};
+    /*!
+     * \brief quantity of status flags
+     */
+	static const int quantityOfStatusFlags{ 5 };
+    /*!
+     * \brief names of status flags, the i-th name belongs to flag 1 << i
+     */
+	static const char *const statusNames[quantityOfStatusFlags];
+    /*!
+     * \brief quantity of the results values
+     */
+	static const int quantityOfFields{ 10 };
+    /*!
+     * \brief names of the results values in the order used by copyValuesTo
+     */
+	static const char *const fieldNames[quantityOfFields];
 	double resistanceOfThermalConduction;
 	double resistanceOfThermalPenetration;
 	double temperatureOnIsolator;
@@ -23,5 +56,9 @@ public:
 	double heatFlowByRadiation2;
 	double heatFlow2;
 	double heatFlow1;
+    /*!
+     * \brief status flags (StatusFlag) of the results, 0 if nothing suspect was found
+     */
+	unsigned int status{ 0 };
 };
 
@@ -0,0 +1,283 @@
+#include "PipeNetwork.h"
+#include "AxialMarching.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+const size_t PipeNetwork::minimumPipesPerThread;
+/*!
+ * \brief constructor
+ * \param data input data of the pipe
+ * \param fromJunction index of junction at the inlet of pipe
+ * \param toJunction index of junction at the outlet of pipe
+ */
+NetworkPipe::NetworkPipe(const InputData &data, const size_t &fromJunction, const size_t &toJunction):
+	data{data},fromJunction{fromJunction},toJunction{toJunction}
+{
+}
+/*!
+ * \brief constructor
+ * \param fluids properties of all liquids and air, they have to outlive the network
+ */
+PipeNetwork::PipeNetwork(const FluidLibrary &fluids):
+	fluids{&fluids}
+{
+}
+/*!
+ * \brief adds the junction whose temperature is the mixing temperature of pipes which flow into it
+ * \return index of junction
+ */
+size_t PipeNetwork::addJunction()
+{
+	junctions.push_back(NetworkJunction{});
+	pipesIntoJunction.emplace_back();
+	return junctions.size() - 1;
+}
+/*!
+ * \brief adds the junction with fixed temperature
+ * \param temperature temperature of junction
+ * \return index of junction
+ */
+size_t PipeNetwork::addSourceJunction(const double &temperature)
+{
+	NetworkJunction junction{};
+	junction.isSource = true;
+	junction.temperature = temperature;
+	junctions.push_back(junction);
+	pipesIntoJunction.emplace_back();
+	return junctions.size() - 1;
+}
+/*!
+ * \brief adds the pipe between existing junctions
+ * \param pipe pipe to add
+ * \throw std::invalid_argument if the junction does not exist, the liquid is unknown,
+ * the velocity, the length or the quantity of segments is not positive
+ * \return index of pipe
+ */
+size_t PipeNetwork::addPipe(const NetworkPipe &pipe)
+{
+	if (pipe.fromJunction >= junctions.size() || pipe.toJunction >= junctions.size()) {
+		throw std::invalid_argument("Pipe connects junction which does not exist.");
+	}
+	if (pipe.typeOfLiquid < 0 || pipe.typeOfLiquid >= FluidLibrary::quantityOfLiquids) {
+		throw std::invalid_argument("Unknown type of liquid.");
+	}
+	if (!(pipe.data.meanVelocityOfLiquid > 0) || !(pipe.data.lengthOfPipe > 0) || pipe.quantityOfSegments == 0) {
+		throw std::invalid_argument("Velocity, length of pipe and quantity of segments have to be positive.");
+	}
+	pipes.push_back(pipe);
+	pipesIntoJunction[pipe.toJunction].push_back(pipes.size() - 1);
+	return pipes.size() - 1;
+}
+/*!
+ * \brief solves the temperature field of network
+ * \param tolerance value of tolerance used by solver and by iterations of network with loops
+ * \param quantityOfThreads quantity of threads
+ * \param maximumIterations maximum quantity of iterations of network with loops
+ * \throw std::invalid_argument if junction has no source and no pipe flows into it
+ * \throw std::runtime_error if the network with loops does not converge
+ * \return temperatures of junctions, results of every pipe and the total heat flow
+ */
+NetworkResults PipeNetwork::solve(const double &tolerance, const unsigned int &quantityOfThreads,
+	const size_t &maximumIterations) const
+{
+	NetworkResults results;
+	results.temperatureOfJunction.assign(junctions.size(), 0);
+	results.pipes.assign(pipes.size(), PipeResult{});
+	double temperatureOfSources = 0;
+	size_t quantityOfSources = 0;
+	for (size_t i = 0; i < junctions.size(); ++i) {
+		if (junctions[i].isSource) {
+			results.temperatureOfJunction[i] = junctions[i].temperature;
+			temperatureOfSources += junctions[i].temperature;
+			++quantityOfSources;
+		}
+		else if (pipesIntoJunction[i].empty()) {
+			throw std::invalid_argument("Junction " + std::to_string(i) + " has no source.");
+		}
+	}
+	std::vector<size_t> levelOfPipe;
+	size_t quantityOfLevels = 0;
+	if (sortTopologically(levelOfPipe, quantityOfLevels)) {
+		std::vector<size_t> beginOfLevel(quantityOfLevels + 1, 0);
+		for (size_t level : levelOfPipe) {
+			++beginOfLevel[level + 1];
+		}
+		for (size_t level = 0; level < quantityOfLevels; ++level) {
+			beginOfLevel[level + 1] += beginOfLevel[level];
+		}
+		std::vector<size_t> orderOfPipes(pipes.size());
+		std::vector<size_t> position(beginOfLevel.begin(), beginOfLevel.end() - 1);
+		for (size_t i = 0; i < pipes.size(); ++i) {
+			orderOfPipes[position[levelOfPipe[i]]++] = i;
+		}
+		std::vector<char> isJunctionSolved(junctions.size(), 0);
+		for (size_t level = 0; level < quantityOfLevels; ++level) {
+			for (size_t i = beginOfLevel[level]; i < beginOfLevel[level + 1]; ++i) {
+				size_t junction = pipes[orderOfPipes[i]].fromJunction;
+				if (!junctions[junction].isSource && !isJunctionSolved[junction]) {
+					results.temperatureOfJunction[junction] = getMixingTemperature(junction, results);
+					isJunctionSolved[junction] = 1;
+				}
+			}
+			solvePipes(orderOfPipes.data() + beginOfLevel[level], beginOfLevel[level + 1] - beginOfLevel[level],
+				results, tolerance, quantityOfThreads);
+		}
+		for (size_t i = 0; i < junctions.size(); ++i) {
+			if (!junctions[i].isSource && !isJunctionSolved[i]) {
+				results.temperatureOfJunction[i] = getMixingTemperature(i, results);
+			}
+		}
+		results.quantityOfIterations = 1;
+	}
+	else {
+		if (quantityOfSources == 0) {
+			throw std::invalid_argument("Network has no source junction.");
+		}
+		for (size_t i = 0; i < junctions.size(); ++i) {
+			if (!junctions[i].isSource) {
+				results.temperatureOfJunction[i] = temperatureOfSources / quantityOfSources;
+			}
+		}
+		std::vector<size_t> orderOfPipes(pipes.size());
+		for (size_t i = 0; i < pipes.size(); ++i) {
+			orderOfPipes[i] = i;
+		}
+		double maximumChange = 0;
+		do {
+			if (results.quantityOfIterations == maximumIterations) {
+				throw std::runtime_error("Temperatures of network did not converge.");
+			}
+			solvePipes(orderOfPipes.data(), pipes.size(), results, tolerance, quantityOfThreads);
+			maximumChange = 0;
+			for (size_t i = 0; i < junctions.size(); ++i) {
+				if (!junctions[i].isSource) {
+					double temperature = getMixingTemperature(i, results);
+					maximumChange = std::max(maximumChange, std::abs(temperature - results.temperatureOfJunction[i]));
+					results.temperatureOfJunction[i] = temperature;
+				}
+			}
+			++results.quantityOfIterations;
+		} while (maximumChange > tolerance);
+	}
+	results.totalHeatFlow = 0;
+	for (const auto &pipe : results.pipes) {
+		results.totalHeatFlow += pipe.heatFlow;
+	}
+	return results;
+}
+/*!
+ * \brief
+ * sorts the junctions topologically (Kahn's algorithm), the level of junction
+ * is the length of the longest path from the junction without inflow
+ * \param levelOfPipe it is set to the level of inlet junction of every pipe
+ * \param quantityOfLevels it is set to the quantity of levels
+ * \return false if the network has loops
+ */
+bool PipeNetwork::sortTopologically(std::vector<size_t> &levelOfPipe, size_t &quantityOfLevels) const
+{
+	std::vector<size_t> quantityOfInflows(junctions.size(), 0);
+	std::vector<std::vector<size_t>> pipesFromJunction(junctions.size());
+	for (size_t i = 0; i < pipes.size(); ++i) {
+		pipesFromJunction[pipes[i].fromJunction].push_back(i);
+		++quantityOfInflows[pipes[i].toJunction];
+	}
+	std::vector<size_t> levelOfJunction(junctions.size(), 0);
+	std::vector<size_t> queue;
+	queue.reserve(junctions.size());
+	for (size_t i = 0; i < junctions.size(); ++i) {
+		if (quantityOfInflows[i] == 0) {
+			queue.push_back(i);
+		}
+	}
+	for (size_t i = 0; i < queue.size(); ++i) {
+		size_t junction = queue[i];
+		for (size_t pipe : pipesFromJunction[junction]) {
+			size_t next = pipes[pipe].toJunction;
+			levelOfJunction[next] = std::max(levelOfJunction[next], levelOfJunction[junction] + 1);
+			if (--quantityOfInflows[next] == 0) {
+				queue.push_back(next);
+			}
+		}
+	}
+	if (queue.size() != junctions.size()) {
+		return false;
+	}
+	levelOfPipe.resize(pipes.size());
+	quantityOfLevels = 0;
+	for (size_t i = 0; i < pipes.size(); ++i) {
+		levelOfPipe[i] = levelOfJunction[pipes[i].fromJunction];
+		quantityOfLevels = std::max(quantityOfLevels, levelOfPipe[i] + 1);
+	}
+	return true;
+}
+/*!
+ * \brief solves the pipes, if there are enough pipes they are divided between threads
+ * \param indexes indexes of pipes
+ * \param quantityOfPipes quantity of pipes
+ * \param results results of network, the temperatures of inlet junctions have to be set
+ * \param tolerance value of tolerance used by solver
+ * \param quantityOfThreads maximum quantity of threads
+ */
+void PipeNetwork::solvePipes(const size_t *indexes, const size_t &quantityOfPipes, NetworkResults &results,
+	const double &tolerance, const unsigned int &quantityOfThreads) const
+{
+	size_t quantityOfParts = std::min<size_t>(quantityOfThreads, quantityOfPipes / minimumPipesPerThread);
+	if (quantityOfParts <= 1) {
+		for (size_t i = 0; i < quantityOfPipes; ++i) {
+			solvePipe(indexes[i], results, tolerance);
+		}
+		return;
+	}
+	std::vector<std::thread> threads;
+	size_t partSize = quantityOfPipes / quantityOfParts;
+	size_t remainder = quantityOfPipes % quantityOfParts;
+	for (size_t part = 0, begin = 0; part < quantityOfParts; ++part) {
+		size_t size = partSize + (part < remainder ? 1 : 0);
+		threads.emplace_back([this, indexes, begin, size, &results, &tolerance]() {
+			for (size_t i = begin; i < begin + size; ++i) {
+				solvePipe(indexes[i], results, tolerance);
+			}
+		});
+		begin += size;
+	}
+	for (auto &thread : threads) {
+		thread.join();
+	}
+}
+/*!
+ * \brief solves one pipe by axial marching from the temperature of its inlet junction
+ * \param index index of pipe
+ * \param results results of network, the results of pipe are set
+ * \param tolerance value of tolerance used by solver
+ */
+void PipeNetwork::solvePipe(const size_t &index, NetworkResults &results, const double &tolerance) const
+{
+	const NetworkPipe &pipe = pipes[index];
+	PipeResult &result = results.pipes[index];
+	InputData data{ pipe.data };
+	data.meanTemperatureOfLiquid = results.temperatureOfJunction[pipe.fromJunction];
+	AxialMarching marching{ data, fluids->liquid(pipe.typeOfLiquid), fluids->air() };
+	result.inletTemperature = data.meanTemperatureOfLiquid;
+	result.outletTemperature = marching.getOutletTemperature(result.inletTemperature, pipe.quantityOfSegments,
+		result.heatFlow, tolerance);
+	result.heatCapacityFlow = marching.getHeatCapacityFlow(result.outletTemperature);
+}
+/*!
+ * \brief calculates the mixing temperature of pipes which flow into junction
+ * \param junction index of junction
+ * \param results results of network, the pipes which flow into junction have to be solved
+ * \return mixing temperature weighted by the heat capacity flow
+ */
+double PipeNetwork::getMixingTemperature(const size_t &junction, const NetworkResults &results) const
+{
+	double heatCapacityFlow = 0;
+	double enthalpyFlow = 0;
+	for (size_t pipe : pipesIntoJunction[junction]) {
+		heatCapacityFlow += results.pipes[pipe].heatCapacityFlow;
+		enthalpyFlow += results.pipes[pipe].heatCapacityFlow*results.pipes[pipe].outletTemperature;
+	}
+	return heatCapacityFlow > 0 ? enthalpyFlow / heatCapacityFlow : 0;
+}
@@ -0,0 +1,131 @@
+#pragma once
+#include "InputData.h"
+#include "FluidLibrary.h"
+#include <vector>
+/*!
+ * \brief The NetworkPipe class
+ * stores one pipe of network, the liquid flows from junction "from" to junction "to",
+ * the mean temperature of liquid in input data is not used (it is the temperature of inlet junction),
+ * the forced convection values and emissivity have to be set in input data
+ */
+class NetworkPipe
+{
+public:
+	NetworkPipe() = default;
+	explicit NetworkPipe(const InputData &data, const size_t &fromJunction = 0, const size_t &toJunction = 0);
+    /*!
+     * \brief input data of the pipe
+     */
+	InputData data;
+    /*!
+     * \brief index of liquid, see FluidLibrary
+     */
+	int typeOfLiquid{ 0 };
+    /*!
+     * \brief index of junction at the inlet of pipe
+     */
+	size_t fromJunction{ 0 };
+    /*!
+     * \brief index of junction at the outlet of pipe
+     */
+	size_t toJunction{ 0 };
+    /*!
+     * \brief quantity of segments used by axial marching
+     */
+	size_t quantityOfSegments{ 1 };
+};
+/*!
+ * \brief The NetworkJunction class
+ * stores one junction of network, the temperature of source junction is fixed,
+ * the temperature of other junctions is the mixing temperature of pipes which flow into it
+ */
+class NetworkJunction
+{
+public:
+    /*!
+     * \brief true if the temperature of junction is fixed (e.g. heat plant)
+     */
+	bool isSource{ false };
+    /*!
+     * \brief temperature of source junction
+     */
+	double temperature{ 0 };
+};
+/*!
+ * \brief The PipeResult class
+ * stores the results of one pipe of network
+ */
+class PipeResult
+{
+public:
+	double inletTemperature{ 0 };
+	double outletTemperature{ 0 };
+    /*!
+     * \brief heat flow lost by the pipe [W]
+     */
+	double heatFlow{ 0 };
+    /*!
+     * \brief heat capacity flow of liquid at the outlet [W/K]
+     */
+	double heatCapacityFlow{ 0 };
+};
+/*!
+ * \brief The NetworkResults class
+ * stores the results of network
+ */
+class NetworkResults
+{
+public:
+	std::vector<double> temperatureOfJunction;
+	std::vector<PipeResult> pipes;
+    /*!
+     * \brief heat flow lost by all pipes [W]
+     */
+	double totalHeatFlow{ 0 };
+    /*!
+     * \brief quantity of iterations, 1 if network has no loops
+     */
+	size_t quantityOfIterations{ 0 };
+};
+/*!
+ * \brief The PipeNetwork class
+ * solves the temperature field of branched network of pipes,
+ * every pipe is solved by axial marching from the temperature of its inlet junction
+ * and the temperature of junction is the mixing temperature of pipes which flow into it
+ * (weighted by the heat capacity flow).
+ * The junctions are sorted topologically and solved level after level,
+ * the pipes of one level are independent so they are solved by many threads,
+ * if the network has loops the whole network is iterated until the temperatures converge
+ * \author Łukasz Dyraga
+ * \version 1.0
+ */
+class PipeNetwork
+{
+public:
+	explicit PipeNetwork(const FluidLibrary &fluids);
+	size_t addJunction();
+	size_t addSourceJunction(const double &temperature);
+	size_t addPipe(const NetworkPipe &pipe);
+	NetworkResults solve(const double &tolerance = 0.001, const unsigned int &quantityOfThreads = 1,
+		const size_t &maximumIterations = 200) const;
+	/*!
+	 * \brief minimum quantity of pipes solved by one thread, smaller levels are solved by the calling thread
+	 */
+	static const size_t minimumPipesPerThread{ 256 };
+private:
+	bool sortTopologically(std::vector<size_t> &levelOfPipe, size_t &quantityOfLevels) const;
+	void solvePipe(const size_t &index, NetworkResults &results, const double &tolerance) const;
+	void solvePipes(const size_t *indexes, const size_t &quantityOfPipes, NetworkResults &results,
+		const double &tolerance, const unsigned int &quantityOfThreads) const;
+	double getMixingTemperature(const size_t &junction, const NetworkResults &results) const;
+    /*!
+     * \brief properties of all liquids and air
+     */
+	const FluidLibrary *fluids;
+	std::vector<NetworkJunction> junctions;
+	std::vector<NetworkPipe> pipes;
+    /*!
+     * \brief indexes of pipes which flow into junction
+     */
+	std::vector<std::vector<size_t>> pipesIntoJunction;
+};
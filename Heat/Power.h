@@ -0,0 +1,80 @@
+#pragma once
+#include <math.h>
+/*!
+ * \brief
+ * calculates the power with integer exponent known at compile time,
+ * the power is expanded to multiplications (exponentiation by squaring),
+ * the number type is any type with multiplication (double, float or Dual)
+ * \param base value of base
+ * \return value of exponentiation
+ */
+template<unsigned int Exponent, class T>
+inline T getPowerOf(const T &base)
+{
+	return Exponent == 0 ? T{ 1.0 } : (Exponent % 2 == 1 ? base : T{ 1.0 }) * getPowerOf<Exponent / 2>(base*base);
+}
+/*!
+ * \brief checks whether the root of degree is calculated by square and cube roots (its factors are 2 and 3 only)
+ */
+constexpr bool isDegreeOfRootKernel(const unsigned int degree)
+{
+	return degree == 1 || (degree != 0 && ((degree % 2 == 0 && isDegreeOfRootKernel(degree / 2))
+		|| (degree % 3 == 0 && isDegreeOfRootKernel(degree / 3))));
+}
+/*!
+ * \brief
+ * root of degree known at compile time expanded to square and cube roots,
+ * the degree has the factors 2 and 3 only, see isDegreeOfRootKernel
+ */
+template<unsigned int Degree, bool IsEven = Degree % 2 == 0>
+class Root
+{
+public:
+	template<class T>
+	static T of(const T &base) { return Root<Degree / 3>::of(cbrt(base)); }
+};
+template<unsigned int Degree>
+class Root<Degree, true>
+{
+public:
+	template<class T>
+	static T of(const T &base) { return Root<Degree / 2>::of(sqrt(base)); }
+};
+template<>
+class Root<1, false>
+{
+public:
+	template<class T>
+	static T of(const T &base) { return base; }
+};
+/*!
+ * \brief
+ * exponent of correlation Numerator/Denominator known at compile time (natural or forced convection),
+ * the power is calculated by square and cube roots and multiplications
+ * if the factors of Denominator are 2 and 3 only (e.g. 1/8, 1/4, 1/3, 9/16 or 8/27),
+ * the other exponents (e.g. 0.8 or 0.4) by pow which is the generic fallback
+ */
+template<unsigned int Numerator, unsigned int Denominator, bool HasRootKernel = isDegreeOfRootKernel(Denominator)>
+class Exponent
+{
+public:
+	/*!
+	 * \brief value of exponent
+	 */
+	static constexpr double value{ double(Numerator) / Denominator };
+	/*!
+	 * \brief calculates the power with this exponent
+	 * \param base value of base, it is not negative
+	 * \return value of exponentiation
+	 */
+	template<class T>
+	static T getPowerOf(const T &base) { return ::getPowerOf<Numerator>(Root<Denominator>::of(base)); }
+};
+template<unsigned int Numerator, unsigned int Denominator>
+class Exponent<Numerator, Denominator, false>
+{
+public:
+	static constexpr double value{ double(Numerator) / Denominator };
+	template<class T>
+	static T getPowerOf(const T &base) { return pow(base, double(Numerator) / Denominator); }
+};
@@ -0,0 +1,158 @@
+#include "ResultCache.h"
+#include <algorithm>
+#include <cstring>
+
+const size_t ResultCache::memoryOfEntry = sizeof(Entry) + 4 * sizeof(void*) + sizeof(CacheKey) +
+	sizeof(std::list<Entry>::iterator) + 3 * sizeof(void*);
+/*!
+ * \brief compares the canonical values of keys
+ */
+bool CacheKey::operator==(const CacheKey &other) const
+{
+	return hash == other.hash && quantityOfValues == other.quantityOfValues &&
+		std::memcmp(value.data(), other.value.data(), sizeof(double)*quantityOfValues) == 0;
+}
+/*!
+ * \brief constructor
+ * \param memoryLimit maximum memory used by entries [bytes], 0 disables the cache
+ * \param quantityOfShards quantity of shards, more shards means less waiting for locks
+ */
+ResultCache::ResultCache(const size_t &memoryLimit, const int &quantityOfShards):
+	capacityOfShard{memoryLimit / memoryOfEntry / std::max(quantityOfShards, 1)},hits{0},misses{0},evictions{0}
+{
+	if (capacityOfShard == 0) {
+		return;
+	}
+	for (int i = 0; i < std::max(quantityOfShards, 1); ++i) {
+		shards.emplace_back(new Shard{});
+	}
+}
+/*!
+ * \brief
+ * creates the key of case: the input values, the type of natural convection and the layers,
+ * the values are canonical (-0 is 0) and hashed (FNV-1a)
+ * \param batchCase case
+ * \return key
+ */
+CacheKey ResultCache::makeKey(const BatchCase &batchCase)
+{
+	CacheKey key{};
+	const InputData &data = batchCase.data;
+	const double value[BatchRunner::quantityOfInputValues]{ data.innerDiameterOfPipe, data.thicknessOfPipe,
+		data.meanVelocityOfLiquid, data.meanTemperatureOfLiquid, static_cast<double>(batchCase.typeOfLiquid),
+		static_cast<double>(batchCase.typeOfForcedConvection), data.thermalConductivityOfIsolator,
+		data.thicknessOfIsolator, data.temperatureOfEnvironment, data.emissivityOfIsolator, data.lengthOfPipe };
+	std::copy(value, value + BatchRunner::quantityOfInputValues, key.value.begin());
+	key.quantityOfValues = BatchRunner::quantityOfInputValues;
+	key.value[key.quantityOfValues++] = data.typeOfNaturalConvection;
+	for (int i = 0; i < data.layers.size(); ++i) {
+		key.value[key.quantityOfValues++] = data.layers[i].thickness;
+		key.value[key.quantityOfValues++] = data.layers[i].thermalConductivity;
+	}
+	std::uint64_t hash = 14695981039346656037ULL;
+	for (int i = 0; i < key.quantityOfValues; ++i) {
+		if (key.value[i] == 0) {
+			key.value[i] = 0;
+		}
+		std::uint64_t bits;
+		std::memcpy(&bits, &key.value[i], sizeof(bits));
+		for (int byte = 0; byte < 8; ++byte) {
+			hash ^= (bits >> (8 * byte)) & 0xFF;
+			hash *= 1099511628211ULL;
+		}
+	}
+	key.hash = hash;
+	return key;
+}
+/*!
+ * \brief returns the shard which stores the key
+ */
+ResultCache::Shard& ResultCache::getShard(const CacheKey &key)
+{
+	return *shards[(key.hash >> 32) % shards.size()];
+}
+/*!
+ * \brief finds the results of case, the found entry becomes the most recently used
+ * \param key key of case
+ * \param result found results
+ * \return true if the results were found
+ */
+bool ResultCache::find(const CacheKey &key, OutputData &result)
+{
+	if (shards.empty()) {
+		return false;
+	}
+	Shard &shard = getShard(key);
+	{
+		std::lock_guard<std::mutex> guard{ shard.lock };
+		auto found = shard.index.find(key);
+		if (found != shard.index.end()) {
+			shard.entries.splice(shard.entries.begin(), shard.entries, found->second);
+			result = found->second->result;
+			hits.fetch_add(1, std::memory_order_relaxed);
+			return true;
+		}
+	}
+	misses.fetch_add(1, std::memory_order_relaxed);
+	return false;
+}
+/*!
+ * \brief inserts the results of case, the least recently used entry is removed if shard is full
+ * \param key key of case
+ * \param result results of case
+ */
+void ResultCache::insert(const CacheKey &key, const OutputData &result)
+{
+	if (shards.empty()) {
+		return;
+	}
+	Shard &shard = getShard(key);
+	std::lock_guard<std::mutex> guard{ shard.lock };
+	auto found = shard.index.find(key);
+	if (found != shard.index.end()) {
+		found->second->result = result;
+		shard.entries.splice(shard.entries.begin(), shard.entries, found->second);
+		return;
+	}
+	if (shard.entries.size() >= capacityOfShard) {
+		shard.index.erase(shard.entries.back().key);
+		shard.entries.pop_back();
+		evictions.fetch_add(1, std::memory_order_relaxed);
+	}
+	shard.entries.push_front(Entry{ key, result });
+	shard.index.emplace(key, shard.entries.begin());
+}
+/*!
+ * \brief removes all entries, the statistics are kept
+ */
+void ResultCache::clear()
+{
+	for (auto &shard : shards) {
+		std::lock_guard<std::mutex> guard{ shard->lock };
+		shard->index.clear();
+		shard->entries.clear();
+	}
+}
+/*!
+ * \brief returns the statistics of cache
+ */
+CacheStatistics ResultCache::getStatistics() const
+{
+	CacheStatistics statistics{};
+	statistics.hits = hits.load(std::memory_order_relaxed);
+	statistics.misses = misses.load(std::memory_order_relaxed);
+	statistics.evictions = evictions.load(std::memory_order_relaxed);
+	for (const auto &shard : shards) {
+		std::lock_guard<std::mutex> guard{ shard->lock };
+		statistics.quantityOfEntries += shard->entries.size();
+	}
+	statistics.memoryUsage = statistics.quantityOfEntries*memoryOfEntry;
+	return statistics;
+}
+/*!
+ * \brief returns false if the memory limit is too small for any entry
+ */
+bool ResultCache::isEnabled() const
+{
+	return !shards.empty();
+}
@@ -0,0 +1,97 @@
+#pragma once
+#include "BatchRunner.h"
+#include "OutputData.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+/*!
+ * \brief The CacheKey class
+ * canonical values of case: input values in the order of BatchRunner::inputNames
+ * (types of liquid, forced convection and emissivity included) followed by the type of natural convection
+ * and the layers
+ */
+class CacheKey
+{
+public:
+	bool operator==(const CacheKey &other) const;
+	std::array<double, BatchRunner::quantityOfInputValues + 1 + 2 * LayerStack::maximumQuantityOfLayers> value{};
+	int quantityOfValues{ 0 };
+	std::uint64_t hash{ 0 };
+};
+/*!
+ * \brief The CacheStatistics class
+ * stores the statistics of result cache
+ */
+class CacheStatistics
+{
+public:
+	std::uint64_t hits{ 0 };
+	std::uint64_t misses{ 0 };
+	std::uint64_t evictions{ 0 };
+	std::uint64_t quantityOfEntries{ 0 };
+    /*!
+     * \brief estimated memory used by entries [bytes]
+     */
+	std::uint64_t memoryUsage{ 0 };
+};
+/*!
+ * \brief The ResultCache class
+ * thread-safe cache of results with least recently used eviction,
+ * the entries are divided into shards (chosen by hash of key) which have their own locks,
+ * the memory limit is divided equally between shards
+ * \author Łukasz Dyraga
+ * \version 1.0
+ */
+class ResultCache
+{
+public:
+	explicit ResultCache(const size_t &memoryLimit, const int &quantityOfShards = 16);
+	ResultCache(const ResultCache &) = delete;
+	ResultCache& operator=(const ResultCache &) = delete;
+	static CacheKey makeKey(const BatchCase &batchCase);
+	bool find(const CacheKey &key, OutputData &result);
+	void insert(const CacheKey &key, const OutputData &result);
+	void clear();
+	CacheStatistics getStatistics() const;
+	bool isEnabled() const;
+    /*!
+     * \brief estimated memory used by one entry (key, results, list and map nodes) [bytes]
+     */
+	static const size_t memoryOfEntry;
+private:
+	class Entry
+	{
+	public:
+		CacheKey key;
+		OutputData result;
+	};
+	class KeyHash
+	{
+	public:
+		size_t operator()(const CacheKey &key) const { return static_cast<size_t>(key.hash); }
+	};
+	class Shard
+	{
+	public:
+		std::mutex lock;
+        /*!
+         * \brief entries from the most recently used
+         */
+		std::list<Entry> entries;
+		std::unordered_map<CacheKey, std::list<Entry>::iterator, KeyHash> index;
+	};
+	Shard& getShard(const CacheKey &key);
+	std::vector<std::unique_ptr<Shard>> shards;
+    /*!
+     * \brief maximum quantity of entries in one shard
+     */
+	size_t capacityOfShard;
+	std::atomic<std::uint64_t> hits;
+	std::atomic<std::uint64_t> misses;
+	std::atomic<std::uint64_t> evictions;
+};
@@ -0,0 +1,321 @@
+#include "ResultRing.h"
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+const int RingHeader::maximumQuantityOfConsumers;
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2 && ATOMIC_INT_LOCK_FREE == 2,
+	"atomics in shared memory have to be lock-free");
+
+namespace {
+/*!
+ * \brief version of ring buffer
+ */
+const std::uint32_t versionOfRing = 2;
+/*!
+ * \brief returns the name of shared memory, it has to start with '/'
+ */
+std::string getNameOfSharedMemory(const std::string &name)
+{
+	return name.empty() || name[0] != '/' ? "/" + name : name;
+}
+/*!
+ * \brief time between the attempts of consumer to open the shared memory which is not created yet
+ */
+const std::chrono::milliseconds intervalOfWaiting{ 10 };
+}
+
+/*!
+ * \brief constructor, creates the shared memory of ring buffer
+ * \param name name of shared memory, the consumers open it by the same name
+ * \param capacity quantity of slots, it is rounded up to the power of 2
+ * \param policy policy used when the ring buffer is full
+ * \throw std::runtime_error if the shared memory can not be created
+ */
+ResultRing::ResultRing(const std::string &name, const std::uint64_t &capacity, const RingPolicy &policy):
+	name{getNameOfSharedMemory(name)},memory{nullptr},sizeOfMemory{0},header{nullptr},slots{nullptr},
+	quantityOfDroppedRecords{0},cachedMinimumReadIndex{0},cachedQuantityOfRegistrations{0}
+{
+	std::uint64_t roundedCapacity = 1;
+	while (roundedCapacity < capacity) {
+		roundedCapacity *= 2;
+	}
+	sizeOfMemory = sizeof(RingHeader) + roundedCapacity * sizeof(RingSlot);
+	int file = shm_open(this->name.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if (file < 0) {
+		throw std::runtime_error("couldn't create shared memory " + this->name + ": " + std::strerror(errno));
+	}
+	if (ftruncate(file, static_cast<off_t>(sizeOfMemory)) != 0) {
+		std::string text = "couldn't resize shared memory " + this->name + ": " + std::strerror(errno);
+		::close(file);
+		shm_unlink(this->name.c_str());
+		throw std::runtime_error(text);
+	}
+	void *address = mmap(nullptr, sizeOfMemory, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+	::close(file);
+	if (address == MAP_FAILED) {
+		shm_unlink(this->name.c_str());
+		throw std::runtime_error("couldn't map shared memory " + this->name + ": " + std::strerror(errno));
+	}
+	memory = static_cast<char*>(address);
+	header = new (memory) RingHeader{};
+	slots = reinterpret_cast<RingSlot*>(memory + sizeof(RingHeader));
+	for (std::uint64_t i = 0; i < roundedCapacity; ++i) {
+		new (&slots[i]) RingSlot{};
+	}
+	std::memcpy(header->magic, "HTRS", 4);
+	header->sizeOfSlot = sizeof(RingSlot);
+	header->policy = policy;
+	header->capacity = roundedCapacity;
+	std::atomic_thread_fence(std::memory_order_release);
+	header->version = versionOfRing;//written last, the consumers do not open the ring buffer before
+}
+/*!
+ * \brief destructor, closes the ring buffer and removes the shared memory, the consumers keep their mappings
+ */
+ResultRing::~ResultRing()
+{
+	close();
+	munmap(memory, sizeOfMemory);
+	shm_unlink(name.c_str());
+}
+/*!
+ * \brief
+ * publishes the results of case, the record is written into the next slot
+ * and then the sequence of slot and the write index are set,
+ * if the ring buffer is full the policy decides what happens,
+ * the consumers are scanned (and checked if their processes exist) only when the ring buffer
+ * is full for the cached read index of the slowest consumer or a new consumer registered
+ * \param caseId index of case
+ * \param result results of case
+ * \return false if the record was dropped
+ */
+bool ResultRing::publish(const std::uint64_t &caseId, const OutputData &result)
+{
+	const std::uint64_t index = header->writeIndex.load(std::memory_order_relaxed);
+	if (header->policy != RingPolicy::overwriteOldest) {
+		const std::uint32_t quantityOfRegistrations = header->quantityOfRegistrations.load(std::memory_order_acquire);
+		if (quantityOfRegistrations != cachedQuantityOfRegistrations) {
+			cachedQuantityOfRegistrations = quantityOfRegistrations;
+			cachedMinimumReadIndex = getMinimumReadIndex();
+		}
+		while (index - cachedMinimumReadIndex >= header->capacity) {
+			cachedMinimumReadIndex = getMinimumReadIndex();
+			if (index - cachedMinimumReadIndex < header->capacity) {
+				break;
+			}
+			if (header->policy == RingPolicy::dropNewest) {
+				++quantityOfDroppedRecords;
+				return false;
+			}
+			std::this_thread::yield();
+		}
+	}
+	RingSlot &slot = slots[index & (header->capacity - 1)];
+	slot.sequence.store(0, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	slot.record.caseId = caseId;
+	slot.record.result.setFrom(result);
+	slot.sequence.store(index + 1, std::memory_order_release);
+	header->writeIndex.store(index + 1, std::memory_order_release);
+	return true;
+}
+/*!
+ * \brief marks the end of publishing, the consumers finish after reading the remaining records
+ */
+void ResultRing::close()
+{
+	header->isClosed.store(1, std::memory_order_release);
+}
+/*!
+ * \brief returns the quantity of records dropped because the ring buffer was full (RingPolicy::dropNewest)
+ * \return quantity of records
+ */
+std::uint64_t ResultRing::getQuantityOfDroppedRecords() const
+{
+	return quantityOfDroppedRecords;
+}
+/*!
+ * \brief returns the policy by its name: block, drop or overwrite
+ * \param name name of policy
+ * \throw std::invalid_argument if the name is unknown
+ * \return policy
+ */
+RingPolicy ResultRing::getPolicy(const std::string &name)
+{
+	if (name == "block") {
+		return RingPolicy::block;
+	}
+	if (name == "drop") {
+		return RingPolicy::dropNewest;
+	}
+	if (name == "overwrite") {
+		return RingPolicy::overwriteOldest;
+	}
+	throw std::invalid_argument("unknown policy of stream " + name);
+}
+/*!
+ * \brief
+ * finds the read index of the slowest active consumer,
+ * the consumers which process does not exist anymore are deactivated
+ * \return read index, the write index if there is no consumer
+ */
+std::uint64_t ResultRing::getMinimumReadIndex()
+{
+	std::uint64_t minimum = header->writeIndex.load(std::memory_order_relaxed);
+	for (auto &consumer : header->consumers) {
+		if (consumer.isActive.load(std::memory_order_acquire) != 1) {
+			continue;
+		}
+		if (kill(consumer.process.load(std::memory_order_relaxed), 0) != 0 && errno == ESRCH) {
+			consumer.isActive.store(0, std::memory_order_release);
+			continue;
+		}
+		std::uint64_t readIndex = consumer.readIndex.load(std::memory_order_acquire);
+		if (readIndex < minimum) {
+			minimum = readIndex;
+		}
+	}
+	return minimum;
+}
+/*!
+ * \brief
+ * constructor, opens the shared memory of ring buffer and registers the consumer,
+ * if the consumer is started before the producer it waits until the shared memory is created and initialized
+ * \param name name of shared memory given to ResultRing
+ * \param waitingTime maximum time of waiting for the producer, 0 if the shared memory has to exist
+ * \throw std::runtime_error if the shared memory can not be opened, it is not a ring buffer
+ * or there are too many consumers
+ */
+ResultRingReader::ResultRingReader(const std::string &name, const std::chrono::milliseconds &waitingTime):
+	memory{nullptr},sizeOfMemory{0},header{nullptr},slots{nullptr},consumer{nullptr},readIndex{0},quantityOfLostRecords{0}
+{
+	const std::string nameOfMemory = getNameOfSharedMemory(name);
+	const auto endOfWaiting = std::chrono::steady_clock::now() + waitingTime;
+	while (true) {
+		const bool canWait = std::chrono::steady_clock::now() < endOfWaiting;
+		int file = shm_open(nameOfMemory.c_str(), O_RDWR, 0);
+		if (file < 0) {
+			const int error = errno;
+			if (error == ENOENT && canWait) {
+				std::this_thread::sleep_for(intervalOfWaiting);
+				continue;
+			}
+			throw std::runtime_error("couldn't open shared memory " + nameOfMemory + ": " + std::strerror(error));
+		}
+		struct stat status {};
+		if (fstat(file, &status) != 0 || static_cast<size_t>(status.st_size) < sizeof(RingHeader)) {
+			::close(file);
+			if (canWait) {//the producer did not resize it yet
+				std::this_thread::sleep_for(intervalOfWaiting);
+				continue;
+			}
+			throw std::runtime_error(nameOfMemory + " is not a stream of results");
+		}
+		sizeOfMemory = static_cast<size_t>(status.st_size);
+		void *address = mmap(nullptr, sizeOfMemory, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+		::close(file);
+		if (address == MAP_FAILED) {
+			throw std::runtime_error("couldn't map shared memory " + nameOfMemory + ": " + std::strerror(errno));
+		}
+		memory = static_cast<char*>(address);
+		header = reinterpret_cast<RingHeader*>(memory);
+		if (header->version == 0 && canWait) {//the producer did not initialize it yet
+			munmap(memory, sizeOfMemory);
+			std::this_thread::sleep_for(intervalOfWaiting);
+			continue;
+		}
+		std::atomic_thread_fence(std::memory_order_acquire);
+		break;
+	}
+	slots = reinterpret_cast<RingSlot*>(memory + sizeof(RingHeader));
+	if (std::memcmp(header->magic, "HTRS", 4) != 0 || header->version != versionOfRing
+		|| header->sizeOfSlot != sizeof(RingSlot) || sizeOfMemory != sizeof(RingHeader) + header->capacity * sizeof(RingSlot)) {
+		munmap(memory, sizeOfMemory);
+		throw std::runtime_error(nameOfMemory + " is not a stream of results");
+	}
+	std::uint64_t writeIndex = header->writeIndex.load(std::memory_order_acquire);
+	readIndex = writeIndex > header->capacity ? writeIndex - header->capacity : 0;
+	for (auto &candidate : header->consumers) {
+		std::uint32_t isActive = 0;
+		if (candidate.isActive.load(std::memory_order_relaxed) == 0
+			&& candidate.isActive.compare_exchange_strong(isActive, 2)) {
+			candidate.process.store(static_cast<std::int32_t>(getpid()), std::memory_order_relaxed);
+			candidate.readIndex.store(readIndex, std::memory_order_relaxed);
+			candidate.isActive.store(1, std::memory_order_release);
+			header->quantityOfRegistrations.fetch_add(1, std::memory_order_acq_rel);
+			consumer = &candidate;
+			break;
+		}
+	}
+	if (consumer == nullptr) {
+		munmap(memory, sizeOfMemory);
+		throw std::runtime_error("too many consumers of " + nameOfMemory);
+	}
+}
+/*!
+ * \brief destructor, unregisters the consumer
+ */
+ResultRingReader::~ResultRingReader()
+{
+	consumer->isActive.store(0, std::memory_order_release);
+	munmap(memory, sizeOfMemory);
+}
+/*!
+ * \brief
+ * reads the next record, the records overwritten before they were read are skipped
+ * and counted as lost (RingPolicy::overwriteOldest)
+ * \param record read record
+ * \return false if there is no new record
+ */
+bool ResultRingReader::read(StreamRecord &record)
+{
+	const std::uint64_t capacity = header->capacity;
+	while (true) {
+		std::uint64_t writeIndex = header->writeIndex.load(std::memory_order_acquire);
+		if (readIndex >= writeIndex) {
+			return false;
+		}
+		RingSlot &slot = slots[readIndex & (capacity - 1)];
+		if (slot.sequence.load(std::memory_order_acquire) == readIndex + 1) {
+			record = slot.record;
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if (slot.sequence.load(std::memory_order_relaxed) == readIndex + 1) {
+				++readIndex;
+				consumer->readIndex.store(readIndex, std::memory_order_release);
+				return true;
+			}
+		}
+		//the slot was overwritten, the reading continues from the oldest record (it is read again if it is written now)
+		writeIndex = header->writeIndex.load(std::memory_order_acquire);
+		std::uint64_t oldestIndex = writeIndex > capacity ? writeIndex - capacity : 0;
+		if (oldestIndex > readIndex) {
+			quantityOfLostRecords += oldestIndex - readIndex;
+			readIndex = oldestIndex;
+		}
+	}
+}
+/*!
+ * \brief checks if the producer closed the ring buffer and all records were read
+ * \return true if there will be no more records
+ */
+bool ResultRingReader::isFinished() const
+{
+	return header->isClosed.load(std::memory_order_acquire) != 0
+		&& readIndex >= header->writeIndex.load(std::memory_order_acquire);
+}
+/*!
+ * \brief returns the quantity of records overwritten before they were read
+ * \return quantity of records
+ */
+std::uint64_t ResultRingReader::getQuantityOfLostRecords() const
+{
+	return quantityOfLostRecords;
+}
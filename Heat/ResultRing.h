@@ -0,0 +1,144 @@
+#pragma once
+#include "Checkpoint.h"
+#include "OutputData.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+/*!
+ * \brief The StreamRecord class
+ * record of ring buffer: index of case and its results
+ */
+class StreamRecord
+{
+public:
+	std::uint64_t caseId;
+	ResultRecord result;
+};
+/*!
+ * \brief policies of producer when the slowest consumer did not read the oldest record of full ring buffer
+ */
+enum class RingPolicy : std::uint32_t {
+	block,//the producer waits for consumers (back-pressure)
+	dropNewest,//the new record is not published
+	overwriteOldest//the oldest record is overwritten, the consumer which did not read it loses it
+};
+/*!
+ * \brief The RingConsumer class
+ * position of consumer in ring buffer, every consumer reads all records
+ */
+class alignas(64) RingConsumer
+{
+public:
+	std::atomic<std::uint32_t> isActive;
+	std::atomic<std::int32_t> process;
+	std::atomic<std::uint64_t> readIndex;
+};
+/*!
+ * \brief The RingSlot class
+ * slot of ring buffer, sequence is index of record + 1 when the record is written, 0 while it is written
+ */
+class RingSlot
+{
+public:
+	std::atomic<std::uint64_t> sequence;
+	StreamRecord record;
+};
+/*!
+ * \brief The RingHeader class
+ * header of shared memory of ring buffer, it is followed by capacity slots
+ */
+class RingHeader
+{
+public:
+    /*!
+     * \brief maximum quantity of consumers which read at once
+     */
+	static const int maximumQuantityOfConsumers{ 16 };
+	char magic[4];
+	std::uint32_t version;
+	std::uint32_t sizeOfSlot;
+	RingPolicy policy;
+	std::uint64_t capacity;
+	std::atomic<std::uint32_t> isClosed;
+    /*!
+     * \brief incremented by every consumer which registers, the producer reads the consumers again when it changes
+     */
+	std::atomic<std::uint32_t> quantityOfRegistrations;
+    /*!
+     * \brief quantity of published records, index of the next record
+     */
+	alignas(64) std::atomic<std::uint64_t> writeIndex;
+	RingConsumer consumers[maximumQuantityOfConsumers];
+};
+/*!
+ * \brief The ResultRing class
+ * lock-free ring buffer in POSIX shared memory which publishes the results of batch run
+ * to consumer processes (ResultRingReader) while the cases are solved, there is one producer and many consumers.
+ * The consumers read the records from shared memory without system calls,
+ * the record which was overwritten while it was read is recognized by the sequence of slot.
+ * The shared memory is removed by destructor
+ * \author Łukasz Dyraga
+ * \version 1.0
+ */
+class ResultRing
+{
+public:
+	ResultRing(const std::string &name, const std::uint64_t &capacity, const RingPolicy &policy);
+	ResultRing(const ResultRing &) = delete;
+	ResultRing& operator=(const ResultRing &) = delete;
+	~ResultRing();
+	bool publish(const std::uint64_t &caseId, const OutputData &result);
+	void close();
+	std::uint64_t getQuantityOfDroppedRecords() const;
+	static RingPolicy getPolicy(const std::string &name);
+private:
+	std::uint64_t getMinimumReadIndex();
+	std::string name;
+	char *memory;
+	size_t sizeOfMemory;
+	RingHeader *header;
+	RingSlot *slots;
+	std::uint64_t quantityOfDroppedRecords;
+    /*!
+     * \brief
+     * read index of the slowest consumer found by the last scan of consumers,
+     * the consumers only move forward, so the ring buffer is not full while the write index is less than capacity ahead of it
+     */
+	std::uint64_t cachedMinimumReadIndex;
+    /*!
+     * \brief quantity of registrations of consumers seen by the last scan of consumers
+     */
+	std::uint32_t cachedQuantityOfRegistrations;
+};
+/*!
+ * \brief The ResultRingReader class
+ * consumer of ResultRing, it starts from the oldest record which is still in ring buffer,
+ * it may be created before the producer and wait for the shared memory
+ */
+class ResultRingReader
+{
+public:
+	explicit ResultRingReader(const std::string &name,
+		const std::chrono::milliseconds &waitingTime = std::chrono::milliseconds{ 0 });
+	ResultRingReader(const ResultRingReader &) = delete;
+	ResultRingReader& operator=(const ResultRingReader &) = delete;
+	~ResultRingReader();
+	bool read(StreamRecord &record);
+	bool isFinished() const;
+	std::uint64_t getQuantityOfLostRecords() const;
+private:
+	char *memory;
+	size_t sizeOfMemory;
+	RingHeader *header;
+	RingSlot *slots;
+	RingConsumer *consumer;
+    /*!
+     * \brief index of the next record to read
+     */
+	std::uint64_t readIndex;
+    /*!
+     * \brief quantity of records overwritten before they were read
+     */
+	std::uint64_t quantityOfLostRecords;
+};
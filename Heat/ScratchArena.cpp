@@ -0,0 +1,92 @@
+#include "ScratchArena.h"
+#include <cstdint>
+
+const size_t ScratchArena::defaultCapacity;
+
+/*!
+ * \brief constructor, allocates the buffer
+ * \param capacity capacity of buffer [bytes]
+ */
+ScratchArena::ScratchArena(const size_t &capacity):
+	buffer{new char[capacity]},capacity{capacity},used{0},extraBlocks{},usedOfExtraBlocks{0},maximumUsedMemory{0}
+{
+}
+/*!
+ * \brief takes the memory from buffer, or from new extra block if the buffer is full
+ * \param size quantity of bytes
+ * \param alignment alignment of memory, power of 2
+ * \return address of memory, valid until reset or the end of Scope
+ */
+void* ScratchArena::allocate(const size_t &size, const size_t &alignment)
+{
+	std::uintptr_t address = reinterpret_cast<std::uintptr_t>(buffer.get()) + used;
+	size_t padding = (alignment - address % alignment) % alignment;
+	if (used + padding + size <= capacity) {
+		used += padding + size;
+		return buffer.get() + used - size;
+	}
+	extraBlocks.emplace_back(new char[size + alignment]);
+	usedOfExtraBlocks += size + alignment;
+	if (getUsedMemory() > maximumUsedMemory) {
+		maximumUsedMemory = getUsedMemory();
+	}
+	address = reinterpret_cast<std::uintptr_t>(extraBlocks.back().get());
+	padding = (alignment - address % alignment) % alignment;
+	return extraBlocks.back().get() + padding;
+}
+/*!
+ * \brief releases all memory, if extra blocks were used since the last reset the buffer is enlarged to hold them next time
+ */
+void ScratchArena::reset()
+{
+	extraBlocks.clear();
+	usedOfExtraBlocks = 0;
+	if (maximumUsedMemory > capacity) {
+		capacity = maximumUsedMemory;
+		buffer.reset(new char[capacity]);
+	}
+	maximumUsedMemory = 0;
+	used = 0;
+}
+/*!
+ * \brief returns the quantity of used bytes (buffer and extra blocks)
+ * \return used memory [bytes]
+ */
+size_t ScratchArena::getUsedMemory() const
+{
+	return used + usedOfExtraBlocks;
+}
+/*!
+ * \brief returns the capacity of buffer
+ * \return capacity [bytes]
+ */
+size_t ScratchArena::getCapacity() const
+{
+	return capacity;
+}
+/*!
+ * \brief returns the arena of current thread
+ * \return arena
+ */
+ScratchArena& ScratchArena::local()
+{
+	thread_local ScratchArena arena{};
+	return arena;
+}
+/*!
+ * \brief remembers the used memory of arena
+ * \param arena arena
+ */
+ScratchArena::Scope::Scope(ScratchArena &arena):
+	arena{&arena},used{arena.used},quantityOfExtraBlocks{arena.extraBlocks.size()},usedOfExtraBlocks{arena.usedOfExtraBlocks}
+{
+}
+/*!
+ * \brief releases the memory taken since the constructor
+ */
+ScratchArena::Scope::~Scope()
+{
+	arena->used = used;
+	arena->extraBlocks.resize(quantityOfExtraBlocks);
+	arena->usedOfExtraBlocks = usedOfExtraBlocks;
+}
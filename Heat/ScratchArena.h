@@ -0,0 +1,79 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <vector>
+/*!
+ * \brief The ScratchArena class
+ * monotonic arena for scratch memory of batch runs: the memory is taken by moving the position in buffer
+ * and is released all at once by reset (at the beginning of each chunk) or by Scope.
+ * When the buffer is full the memory is taken from extra heap blocks and the next reset enlarges the buffer,
+ * so after the first chunks the arena does not use the heap.
+ * Every thread has its own arena (local()), so the threads do not contend on the allocator.
+ * Only trivially destructible objects can be kept in arena, their destructors are not called
+ * \author Łukasz Dyraga
+ * \version 1.0
+ */
+class ScratchArena
+{
+public:
+	explicit ScratchArena(const size_t &capacity = defaultCapacity);
+	ScratchArena(const ScratchArena &) = delete;
+	ScratchArena& operator=(const ScratchArena &) = delete;
+	void* allocate(const size_t &size, const size_t &alignment = alignof(std::max_align_t));
+	template<class T>
+	T* allocateArray(const size_t &quantity);
+	void reset();
+	size_t getUsedMemory() const;
+	size_t getCapacity() const;
+	static ScratchArena& local();
+    /*!
+     * \brief capacity of buffer of new arena [bytes]
+     */
+	static const size_t defaultCapacity{ 64 * 1024 };
+	/*!
+	 * \brief The Scope class
+	 * releases the memory taken from arena during its lifetime, used by functions which are called outside of chunks
+	 */
+	class Scope
+	{
+	public:
+		explicit Scope(ScratchArena &arena);
+		Scope(const Scope &) = delete;
+		Scope& operator=(const Scope &) = delete;
+		~Scope();
+	private:
+		ScratchArena *arena;
+		size_t used;
+		size_t quantityOfExtraBlocks;
+		size_t usedOfExtraBlocks;
+	};
+private:
+	std::unique_ptr<char[]> buffer;
+	size_t capacity;
+    /*!
+     * \brief used bytes of buffer
+     */
+	size_t used;
+    /*!
+     * \brief blocks taken from heap when the buffer was full
+     */
+	std::vector<std::unique_ptr<char[]>> extraBlocks;
+    /*!
+     * \brief sum of sizes of extra blocks
+     */
+	size_t usedOfExtraBlocks;
+    /*!
+     * \brief the greatest used memory since the last reset
+     */
+	size_t maximumUsedMemory;
+};
+/*!
+ * \brief takes memory for array from arena, the elements are not initialized
+ * \param quantity quantity of elements
+ * \return address of first element
+ */
+template<class T>
+T* ScratchArena::allocateArray(const size_t &quantity)
+{
+	return static_cast<T*>(allocate(sizeof(T)*quantity, alignof(T)));
+}
@@ -0,0 +1,89 @@
+#include "Sensitivity.h"
+#include "HeatTransferModel.h"
+#include "HeatTransferSolver.h"
+#include <stdexcept>
+
+const char *const Sensitivity::inputNames[Sensitivity::quantityOfInputs] = {
+	"innerDiameterOfPipe", "thicknessOfPipe", "meanVelocityOfLiquid", "meanTemperatureOfLiquid",
+	"thermalConductivityOfIsolator", "thicknessOfIsolator", "temperatureOfEnvironment", "emissivityOfIsolator",
+	"lengthOfPipe"
+};
+/*!
+ * \brief constructor
+ * \param liquid properties of liquid, they have to outlive the object
+ * \param air properties of air, they have to outlive the object
+ * \param tolerance tolerance used by solver
+ */
+Sensitivity::Sensitivity(const ThermalProperties &liquid, const ThermalProperties &air, const double &tolerance):
+	liquid{&liquid},air{&air},tolerance{tolerance}
+{
+}
+/*!
+ * \brief solves the case and calculates the derivatives of results
+ * \param data input data
+ * \throw std::invalid_argument if the layers are set
+ * \return results and Jacobian matrix
+ */
+SensitivityResults Sensitivity::calculate(const InputData &data) const
+{
+	if (data.layers.size() > 0) {
+		throw std::invalid_argument("Sensitivity does not support layers.");
+	}
+	SensitivityResults sensitivity{};
+	InputData solvedData{ data };
+	HeatTransferSolver solver{ solvedData, *liquid, *air };
+	double temperatureOnIsolator = solver.findTemperatureOnIsolator(
+		0.5*(data.meanTemperatureOfLiquid + data.temperatureOfEnvironment), tolerance);
+	solver.setResults(temperatureOnIsolator);
+	sensitivity.results = *solver.getResults();
+	switch (data.typeOfNaturalConvection) {
+	case 1:
+		calculateDerivativesWith<ChurchillChuNaturalConvection>(data, temperatureOnIsolator, sensitivity);
+		break;
+	default:
+		calculateDerivativesWith<SimplifiedNaturalConvection>(data, temperatureOnIsolator, sensitivity);
+		break;
+	}
+	return sensitivity;
+}
+/*!
+ * \brief
+ * calculates the derivatives of results by dual numbers in the solved temperature on isolator, see calculate,
+ * the correlation of natural convection is chosen once for all evaluations of model
+ * \tparam Natural correlation of natural convection, see ConvectionCorrelation.h
+ * \param data input data
+ * \param temperatureOnIsolator solved temperature on isolator
+ * \param sensitivity results, the Jacobian matrix is set
+ */
+template<class Natural>
+void Sensitivity::calculateDerivativesWith(const InputData &data, const double &temperatureOnIsolator,
+	SensitivityResults &sensitivity) const
+{
+	//the last variable is temperature on isolator
+	typedef Dual<quantityOfInputs + 1> Number;
+	HeatTransferModel<Number> model{ data, *liquid, *air };
+	Number *input[quantityOfInputs] = { &model.innerDiameterOfPipe, &model.thicknessOfPipe,
+		&model.meanVelocityOfLiquid, &model.meanTemperatureOfLiquid, &model.thermalConductivityOfIsolator,
+		&model.thicknessOfIsolator, &model.temperatureOfEnvironment, &model.emissivityOfIsolator, &model.lengthOfPipe };
+	for (int i = 0; i < quantityOfInputs; ++i) {
+		*input[i] = Number::variable(input[i]->value, i);
+	}
+	model.calculateTheRemainingData();
+	model.calculateInitialValues();
+	Number difference = model.template getDifferenceOfHeatFlowsWith<Natural>(
+		Number::variable(temperatureOnIsolator, quantityOfInputs));
+	double derivativeOfTemperature = difference.derivative[quantityOfInputs];
+	Number temperature{ temperatureOnIsolator };
+	if (derivativeOfTemperature != 0) {
+		for (int i = 0; i < quantityOfInputs; ++i) {
+			temperature.derivative[i] = -difference.derivative[i] / derivativeOfTemperature;
+		}
+	}
+	Number values[OutputData::quantityOfFields];
+	model.template getResultsWith<Natural>(temperature, values);
+	for (int field = 0; field < OutputData::quantityOfFields; ++field) {
+		for (int i = 0; i < quantityOfInputs; ++i) {
+			sensitivity.jacobian[field][i] = values[field].derivative[i];
+		}
+	}
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include "InputData.h"
+#include "OutputData.h"
+#include "ThermalProperties.h"
+#include <array>
+
+class SensitivityResults;
+/*!
+ * \brief The Sensitivity class
+ * calculates the derivatives of all results with respect to all continuous input values in one pass:
+ * forward-mode automatic differentiation (dual numbers) is used on the equations of model,
+ * the derivative of temperature on isolator is taken from the converged heat balance
+ * (implicit function theorem: dT/dp = -(df/dp)/(df/dT) where f is difference of heat flows).
+ * The types of liquid, forced convection and emissivity are discrete so they are not differentiated,
+ * the emissivity value is used instead; the layers are not supported
+ * \author Łukasz Dyraga
+ * \version 1.0
+ */
+class Sensitivity
+{
+public:
+    /*!
+     * \brief input values with respect to which the results are differentiated
+     */
+	enum Input { innerDiameterOfPipe, thicknessOfPipe, meanVelocityOfLiquid, meanTemperatureOfLiquid,
+		thermalConductivityOfIsolator, thicknessOfIsolator, temperatureOfEnvironment, emissivityOfIsolator,
+		lengthOfPipe, quantityOfInputs };
+    /*!
+     * \brief names of input values in the order of Input
+     */
+	static const char *const inputNames[quantityOfInputs];
+	Sensitivity(const ThermalProperties &liquid, const ThermalProperties &air, const double &tolerance = 1e-9);
+	SensitivityResults calculate(const InputData &data) const;
+private:
+	template<class Natural>
+	void calculateDerivativesWith(const InputData &data, const double &temperatureOnIsolator,
+		SensitivityResults &sensitivity) const;
+	const ThermalProperties *liquid;
+	const ThermalProperties *air;
+    /*!
+     * \brief tolerance used by solver
+     */
+	double tolerance;
+};
+/*!
+ * \brief The SensitivityResults class
+ * stores the results and the Jacobian matrix: jacobian[field][input] is the derivative
+ * of OutputData field (order of OutputData::fieldNames) with respect to input (order of Sensitivity::Input)
+ */
+class SensitivityResults
+{
+public:
+	OutputData results{};
+	std::array<std::array<double, Sensitivity::quantityOfInputs>, OutputData::quantityOfFields> jacobian{};
+};
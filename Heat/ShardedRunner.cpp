@@ -0,0 +1,286 @@
+#include "ShardedRunner.h"
+#include "TraceRecorder.h"
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <deque>
+#include <poll.h>
+#include <stdexcept>
+#include <string>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+/*!
+ * \brief report of worker: solved chunk and whether all its cases were solved
+ */
+class ChunkReport
+{
+public:
+	std::uint64_t chunk;
+	std::uint32_t isSolved;
+};
+/*!
+ * \brief writes all bytes into the socket
+ * \return false if the socket was closed
+ */
+bool sendAll(int connection, const void *data, size_t size)
+{
+	const char *bytes = static_cast<const char*>(data);
+	while (size > 0) {
+		ssize_t sent = send(connection, bytes, size, MSG_NOSIGNAL);
+		if (sent < 0 && errno == EINTR) {
+			continue;
+		}
+		if (sent <= 0) {
+			return false;
+		}
+		bytes += sent;
+		size -= static_cast<size_t>(sent);
+	}
+	return true;
+}
+/*!
+ * \brief reads size bytes from the socket
+ * \return false if the socket was closed before all bytes were read
+ */
+bool receiveAll(int connection, void *data, size_t size)
+{
+	char *bytes = static_cast<char*>(data);
+	while (size > 0) {
+		ssize_t received = recv(connection, bytes, size, 0);
+		if (received < 0 && errno == EINTR) {
+			continue;
+		}
+		if (received <= 0) {
+			return false;
+		}
+		bytes += received;
+		size -= static_cast<size_t>(received);
+	}
+	return true;
+}
+/*!
+ * \brief waits for the end of process
+ * \param process identifier of process
+ */
+void reap(const int &process)
+{
+	while (waitpid(process, nullptr, 0) < 0 && errno == EINTR) {
+	}
+}
+}
+
+/*!
+ * \brief constructor
+ * \param runner runner which solves the cases in workers
+ * \param results results of run shared with the workers, they have to outlive the object
+ * \param quantityOfProcesses quantity of workers
+ */
+ShardedRunner::ShardedRunner(const BatchRunner &runner, CheckpointFile &results, const int &quantityOfProcesses):
+	runner{&runner},results{&results},quantityOfProcesses{std::max(quantityOfProcesses, 1)},quantityOfRepeatedChunks{0}
+{
+}
+/*!
+ * \brief
+ * solves the cases which are not committed in the results, the chunks are committed by the coordinator
+ * when their workers report them as solved
+ * \param cases all cases of run
+ * \throw std::invalid_argument if the quantity of cases is different from the results
+ * \throw std::runtime_error if the worker can not be started or the chunk failed maximumQuantityOfAttempts times
+ * \return results of all cases
+ */
+std::vector<OutputData> ShardedRunner::solve(std::vector<BatchCase> &cases)
+{
+	HEAT_TRACE_SCOPE("solve in processes", "batch");
+	if (cases.size() != results->getQuantityOfCases()) {
+		throw std::invalid_argument("different quantity of cases than in results");
+	}
+	ChunkProgress progress{ *results };
+	std::deque<std::uint64_t> waitingChunks;
+	for (std::uint64_t chunk = 0; chunk < progress.getQuantityOfChunks(); ++chunk) {
+		waitingChunks.push_back(chunk);
+	}
+	std::vector<int> attempts(progress.getQuantityOfChunks(), 0);
+	std::vector<ShardedWorker> workers;
+	try {
+		const size_t quantityOfWorkers = std::min(static_cast<size_t>(quantityOfProcesses), waitingChunks.size());
+		while (workers.size() < quantityOfWorkers) {
+			workers.push_back(startWorker(cases, progress, workers));
+		}
+		std::vector<pollfd> connections;
+		std::vector<ShardedWorker*> busyWorkers;
+		while (true) {
+			connections.clear();
+			busyWorkers.clear();
+			for (auto &worker : workers) {
+				if (!worker.isBusy && !waitingChunks.empty()) {
+					worker.chunk = waitingChunks.front();
+					waitingChunks.pop_front();
+					worker.isBusy = true;
+					sendAll(worker.connection, &worker.chunk, sizeof(worker.chunk));//the crash is found by receiving
+				}
+				if (worker.isBusy) {
+					connections.push_back(pollfd{ worker.connection, POLLIN, 0 });
+					busyWorkers.push_back(&worker);
+				}
+			}
+			if (busyWorkers.empty()) {
+				break;
+			}
+			if (poll(connections.data(), connections.size(), -1) < 0) {
+				if (errno == EINTR) {
+					continue;
+				}
+				throw std::runtime_error(std::string("couldn't wait for workers: ") + std::strerror(errno));
+			}
+			for (size_t i = 0; i < busyWorkers.size(); ++i) {
+				if (connections[i].revents == 0) {
+					continue;
+				}
+				ShardedWorker &worker = *busyWorkers[i];
+				ChunkReport report{};
+				const bool isReported = receiveAll(worker.connection, &report, sizeof(report));
+				const std::uint64_t chunk = worker.chunk;
+				worker.isBusy = false;
+				if (!isReported) {//the worker crashed, it is replaced
+					close(worker.connection);
+					worker.connection = -1;
+					reap(worker.process);
+					worker.process = -1;
+					worker = startWorker(cases, progress, workers);
+				}
+				if (isReported && report.isSolved != 0) {
+					progress.complete(chunk);
+					continue;
+				}
+				if (++attempts[chunk] >= maximumQuantityOfAttempts) {
+					throw std::runtime_error("workers of cases " + std::to_string(progress.getBeginOf(chunk)) + "-"
+						+ std::to_string(progress.getEndOf(chunk) - 1) + " failed " + std::to_string(attempts[chunk])
+						+ " times");
+				}
+				++quantityOfRepeatedChunks;
+				waitingChunks.push_front(chunk);
+			}
+		}
+	}
+	catch (...) {
+		stopWorkers(workers);
+		throw;
+	}
+	for (auto &worker : workers) {//the workers finish after the end of their sockets
+		close(worker.connection);
+		worker.connection = -1;
+	}
+	for (auto &worker : workers) {
+		reap(worker.process);
+		worker.process = -1;
+	}
+	return results->getResults();
+}
+/*!
+ * \brief returns the quantity of chunks which were solved again after the failure of worker
+ * \return quantity of chunks
+ */
+std::uint64_t ShardedRunner::getQuantityOfRepeatedChunks() const
+{
+	return quantityOfRepeatedChunks;
+}
+/*!
+ * \brief solves the cases of chunk in worker and writes their results into shared memory
+ * \param cases all cases of run
+ * \param begin index of first case of chunk
+ * \param end index after the last case of chunk
+ */
+void ShardedRunner::solveChunk(std::vector<BatchCase> &cases, const std::uint64_t &begin, const std::uint64_t &end) const
+{
+	OutputData result{};
+	for (std::uint64_t i = begin; i < end; ++i) {
+		runner->solveCase(cases[i], result);
+		results->setResult(i, result);
+	}
+}
+/*!
+ * \brief starts the worker which solves the chunks received through its socket until the socket is closed
+ * \param cases all cases of run
+ * \param progress chunks of run
+ * \param workers other workers, their sockets are closed in the new worker, so they see the end of their sockets
+ * \throw std::runtime_error if the worker can not be started
+ * \return started worker
+ */
+ShardedWorker ShardedRunner::startWorker(std::vector<BatchCase> &cases, const ChunkProgress &progress,
+	const std::vector<ShardedWorker> &workers) const
+{
+	int sockets[2];
+	if (socketpair(AF_UNIX, SOCK_STREAM, 0, sockets) < 0) {
+		throw std::runtime_error(std::string("couldn't start worker: ") + std::strerror(errno));
+	}
+	pid_t process = fork();
+	if (process == 0) {
+		close(sockets[0]);
+		for (const auto &worker : workers) {
+			if (worker.connection >= 0) {
+				close(worker.connection);
+			}
+		}
+		solveChunks(sockets[1], cases, progress);
+		_exit(EXIT_SUCCESS);
+	}
+	const int error = errno;
+	close(sockets[1]);
+	if (process < 0) {
+		close(sockets[0]);
+		throw std::runtime_error(std::string("couldn't start worker: ") + std::strerror(error));
+	}
+	ShardedWorker worker{};
+	worker.process = process;
+	worker.connection = sockets[0];
+	return worker;
+}
+/*!
+ * \brief solves the chunks received from coordinator and reports them (loop of worker)
+ * \param connection socket of worker
+ * \param cases all cases of run
+ * \param progress chunks of run
+ */
+void ShardedRunner::solveChunks(const int &connection, std::vector<BatchCase> &cases, const ChunkProgress &progress) const
+{
+	ChunkReport report{};
+	while (receiveAll(connection, &report.chunk, sizeof(report.chunk))) {
+		try {
+			solveChunk(cases, progress.getBeginOf(report.chunk), progress.getEndOf(report.chunk));
+			report.isSolved = 1;
+		}
+		catch (...) {
+			report.isSolved = 0;
+		}
+		if (!sendAll(connection, &report, sizeof(report))) {
+			return;
+		}
+	}
+}
+/*!
+ * \brief kills the workers and waits for their end
+ * \param workers workers, they are closed and reaped
+ */
+void ShardedRunner::stopWorkers(std::vector<ShardedWorker> &workers) const
+{
+	for (auto &worker : workers) {
+		if (worker.process > 0) {
+			kill(worker.process, SIGKILL);
+		}
+		if (worker.connection >= 0) {
+			close(worker.connection);
+			worker.connection = -1;
+		}
+	}
+	for (auto &worker : workers) {
+		if (worker.process > 0) {
+			reap(worker.process);
+			worker.process = -1;
+		}
+	}
+}
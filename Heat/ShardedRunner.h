@@ -0,0 +1,64 @@
+#pragma once
+#include "BatchRunner.h"
+#include "Checkpoint.h"
+#include <cstdint>
+#include <vector>
+/*!
+ * \brief The ShardedWorker class
+ * worker process of ShardedRunner and the socket through which it gets the chunks and reports them
+ */
+class ShardedWorker
+{
+public:
+    /*!
+     * \brief identifier of process, -1 after the worker was reaped
+     */
+	int process{ -1 };
+    /*!
+     * \brief socket of coordinator connected with worker, -1 after it was closed
+     */
+	int connection{ -1 };
+    /*!
+     * \brief chunk which is solved by worker
+     */
+	std::uint64_t chunk{ 0 };
+	bool isBusy{ false };
+};
+/*!
+ * \brief The ShardedRunner class
+ * solves the batch in many worker processes on one host: the coordinator forks quantityOfProcesses workers once
+ * and sends them the chunks of cases (see ChunkProgress) through their sockets, the idle worker gets the next chunk.
+ * The workers inherit the loaded cases and write the results directly into the shared mapping of CheckpointFile
+ * at the offsets of their cases, so the results do not have to be merged. The chunk which failed or whose worker
+ * crashed is given to the next idle worker (the crashed worker is replaced),
+ * the run is stopped when the same chunk failed maximumQuantityOfAttempts times (POSIX only)
+ * \author Łukasz Dyraga
+ * \version 1.0
+ */
+class ShardedRunner
+{
+public:
+	ShardedRunner(const BatchRunner &runner, CheckpointFile &results, const int &quantityOfProcesses);
+	std::vector<OutputData> solve(std::vector<BatchCase> &cases);
+	std::uint64_t getQuantityOfRepeatedChunks() const;
+    /*!
+     * \brief quantity of attempts to solve one chunk
+     */
+	int maximumQuantityOfAttempts{ 3 };
+private:
+	ShardedWorker startWorker(std::vector<BatchCase> &cases, const ChunkProgress &progress,
+		const std::vector<ShardedWorker> &workers) const;
+	void solveChunks(const int &connection, std::vector<BatchCase> &cases, const ChunkProgress &progress) const;
+	void solveChunk(std::vector<BatchCase> &cases, const std::uint64_t &begin, const std::uint64_t &end) const;
+	void stopWorkers(std::vector<ShardedWorker> &workers) const;
+	const BatchRunner *runner;
+    /*!
+     * \brief results of all cases in memory shared with the workers
+     */
+	CheckpointFile *results;
+	int quantityOfProcesses;
+    /*!
+     * \brief quantity of chunks which were solved again after the failure of worker
+     */
+	std::uint64_t quantityOfRepeatedChunks;
+};
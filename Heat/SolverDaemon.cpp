@@ -0,0 +1,508 @@
+#include "SolverDaemon.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <cerrno>
+#include <csignal>
+#include <cstdlib>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+
+namespace {
+/*!
+ * \brief descriptor of listening socket, used by stop()
+ */
+volatile std::sig_atomic_t listeningSocket = -1;
+/*!
+ * \brief true after stop() was called
+ */
+volatile std::sig_atomic_t isStopped = 0;
+/*!
+ * \brief writes all bytes into the connection
+ * \return false if the connection was closed
+ */
+bool sendAll(int connection, const char *data, size_t size)
+{
+	while (size > 0) {
+		ssize_t sent = send(connection, data, size, MSG_NOSIGNAL);
+		if (sent < 0 && errno == EINTR) {
+			continue;
+		}
+		if (sent <= 0) {
+			return false;
+		}
+		data += sent;
+		size -= static_cast<size_t>(sent);
+	}
+	return true;
+}
+/*!
+ * \brief reads the next part of data from connection and appends it to buffer
+ * \return false if the connection was closed
+ */
+bool receiveMore(int connection, std::string &buffer)
+{
+	char part[4096];
+	ssize_t received;
+	do {
+		received = recv(connection, part, sizeof(part), 0);
+	} while (received < 0 && errno == EINTR);
+	if (received <= 0) {
+		return false;
+	}
+	buffer.append(part, static_cast<size_t>(received));
+	return true;
+}
+/*!
+ * \brief skips the white signs in text
+ */
+void skipWhiteSigns(const std::string &text, size_t &i)
+{
+	while (i < text.size() && (text[i] == ' ' || text[i] == '\t' || text[i] == '\r' || text[i] == '\n')) {
+		++i;
+	}
+}
+/*!
+ * \brief reads the flat JSON object with number values
+ * \param text JSON text
+ * \param value values ordered as names
+ * \param isSet true for every found name
+ * \throw std::invalid_argument if text is not an object of numbers
+ */
+void readJsonObject(const std::string &text, double *value, bool *isSet)
+{
+	size_t i = 0;
+	skipWhiteSigns(text, i);
+	if (i >= text.size() || text[i] != '{') {
+		throw std::invalid_argument("request is not a JSON object");
+	}
+	++i;
+	skipWhiteSigns(text, i);
+	if (i < text.size() && text[i] == '}') {
+		return;
+	}
+	while (i < text.size()) {
+		if (text[i] != '"') {
+			throw std::invalid_argument("expected name in quotes");
+		}
+		size_t end = text.find('"', i + 1);
+		if (end == std::string::npos) {
+			throw std::invalid_argument("unterminated name");
+		}
+		std::string name = text.substr(i + 1, end - i - 1);
+		i = end + 1;
+		skipWhiteSigns(text, i);
+		if (i >= text.size() || text[i] != ':') {
+			throw std::invalid_argument("expected ':' after \"" + name + "\"");
+		}
+		++i;
+		skipWhiteSigns(text, i);
+		const char *begin = text.c_str() + i;
+		char *numberEnd = nullptr;
+		double number = std::strtod(begin, &numberEnd);
+		if (numberEnd == begin) {
+			throw std::invalid_argument("value of \"" + name + "\" is not a number");
+		}
+		i += static_cast<size_t>(numberEnd - begin);
+		for (int j = 0; j < BatchRunner::quantityOfInputValues; ++j) {
+			if (name == BatchRunner::inputNames[j]) {
+				value[j] = number;
+				isSet[j] = true;
+			}
+		}
+		skipWhiteSigns(text, i);
+		if (i < text.size() && text[i] == ',') {
+			++i;
+			skipWhiteSigns(text, i);
+		}
+		else if (i < text.size() && text[i] == '}') {
+			return;
+		}
+		else {
+			throw std::invalid_argument("expected ',' or '}'");
+		}
+	}
+	throw std::invalid_argument("unterminated JSON object");
+}
+/*!
+ * \brief escapes the text which is written as JSON string
+ */
+std::string escapeJson(const std::string &text)
+{
+	std::string escaped;
+	for (char sign : text) {
+		if (sign == '"' || sign == '\\') {
+			escaped += '\\';
+		}
+		if (static_cast<unsigned char>(sign) >= 0x20) {
+			escaped += sign;
+		}
+	}
+	return escaped;
+}
+/*!
+ * \brief handler of SIGINT and SIGTERM
+ */
+void handleStopSignal(int)
+{
+	SolverDaemon::stop();
+}
+}
+/*!
+ * \brief constructor
+ * \param fluids properties of all liquids and air, they have to outlive the daemon
+ * \param options options used for every case (tolerance, type of liquid or forced convection)
+ */
+SolverDaemon::SolverDaemon(const FluidLibrary &fluids, const BatchOptions &options):
+	runner{fluids, options},cache{options.cacheMemoryLimit}
+{
+}
+/*!
+ * \brief solves the case or takes its results from cache
+ * \param batchCase case to solve
+ * \param result results of case
+ */
+void SolverDaemon::solveCase(BatchCase &batchCase, OutputData &result) const
+{
+	if (!cache.isEnabled()) {
+		runner.solveCase(batchCase, result);
+		return;
+	}
+	CacheKey key = ResultCache::makeKey(batchCase);
+	if (!cache.find(key, result)) {
+		runner.solveCase(batchCase, result);
+		cache.insert(key, result);
+	}
+}
+/*!
+ * \brief returns the statistics of result cache
+ */
+CacheStatistics SolverDaemon::getCacheStatistics() const
+{
+	return cache.getStatistics();
+}
+/*!
+ * \brief listens on the address and serves the connections until stop() is called (SIGINT, SIGTERM)
+ * \param address path of Unix domain socket or "tcp:PORT" for localhost TCP
+ * \throw std::runtime_error if the socket can not be opened
+ */
+void SolverDaemon::run(const std::string &address)
+{
+	int socketDescriptor = openSocket(address);
+	listeningSocket = socketDescriptor;
+	isStopped = 0;
+	struct sigaction action {};
+	action.sa_handler = handleStopSignal;
+	sigemptyset(&action.sa_mask);
+	sigaction(SIGINT, &action, nullptr);
+	sigaction(SIGTERM, &action, nullptr);
+	std::signal(SIGPIPE, SIG_IGN);
+	while (!isStopped && waitForFreeConnection()) {
+		int connection = accept(socketDescriptor, nullptr, nullptr);
+		if (connection < 0) {
+			if (errno == EINTR || errno == ECONNABORTED) {
+				continue;
+			}
+			break;
+		}
+		if (socketPath.empty()) {
+			int flag = 1;
+			setsockopt(connection, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+		}
+		std::lock_guard<std::mutex> guard(connectionsLock);
+		connections.emplace_back();
+		connections.back().socket = connection;
+		connections.back().thread = std::thread(&SolverDaemon::serveAndFinish, this, &connections.back());
+	}
+	stopConnections();
+	close(socketDescriptor);
+	listeningSocket = -1;
+	if (!socketPath.empty()) {
+		unlink(socketPath.c_str());
+	}
+}
+/*!
+ * \brief serves the connection in its thread and marks it as finished
+ * \param connection connection from the list of connections
+ */
+void SolverDaemon::serveAndFinish(DaemonConnection *connection)
+{
+	try {
+		serveConnection(connection->socket);
+	}
+	catch (std::exception &) {
+		//e.g. the buffer of connection could not be allocated, only this connection is closed
+	}
+	{
+		std::lock_guard<std::mutex> guard(connectionsLock);
+		connection->isFinished = true;
+	}
+	isConnectionFinished.notify_one();
+}
+/*!
+ * \brief waits until less than maximumQuantityOfConnections connections are served
+ * \return false if the daemon was stopped while waiting
+ */
+bool SolverDaemon::waitForFreeConnection()
+{
+	std::unique_lock<std::mutex> guard(connectionsLock);
+	while (true) {
+		joinFinishedConnections();
+		if (connections.size() < std::max<size_t>(maximumQuantityOfConnections, 1)) {
+			return true;
+		}
+		if (isStopped) {
+			return false;
+		}
+		//the signal handler can not notify, so the stop is checked periodically
+		isConnectionFinished.wait_for(guard, std::chrono::milliseconds(100));
+	}
+}
+/*!
+ * \brief joins the threads of finished connections and closes their sockets, connectionsLock has to be locked
+ */
+void SolverDaemon::joinFinishedConnections()
+{
+	for (auto connection = connections.begin(); connection != connections.end();) {
+		if (!connection->isFinished) {
+			++connection;
+			continue;
+		}
+		connection->thread.join();
+		close(connection->socket);
+		connection = connections.erase(connection);
+	}
+}
+/*!
+ * \brief shuts down the open connections, so their threads stop waiting for requests, and joins all threads
+ */
+void SolverDaemon::stopConnections()
+{
+	std::list<DaemonConnection> stoppedConnections;
+	{
+		std::lock_guard<std::mutex> guard(connectionsLock);
+		for (auto &connection : connections) {
+			if (!connection.isFinished) {
+				shutdown(connection.socket, SHUT_RDWR);
+			}
+		}
+		stoppedConnections.splice(stoppedConnections.end(), connections);
+	}
+	for (auto &connection : stoppedConnections) {
+		connection.thread.join();
+		close(connection.socket);
+	}
+}
+/*!
+ * \brief opens the listening socket
+ * \param address path of Unix domain socket or "tcp:PORT" for localhost TCP
+ * \throw std::runtime_error if the socket can not be opened
+ * \return descriptor of socket
+ */
+int SolverDaemon::openSocket(const std::string &address)
+{
+	int socketDescriptor = -1;
+	if (address.compare(0, 4, "tcp:") == 0) {
+		int port = std::atoi(address.c_str() + 4);
+		if (port <= 0 || port > 65535) {
+			throw std::runtime_error("wrong TCP port " + address.substr(4));
+		}
+		socketDescriptor = socket(AF_INET, SOCK_STREAM, 0);
+		int flag = 1;
+		setsockopt(socketDescriptor, SOL_SOCKET, SO_REUSEADDR, &flag, sizeof(flag));
+		sockaddr_in socketAddress{};
+		socketAddress.sin_family = AF_INET;
+		socketAddress.sin_port = htons(static_cast<uint16_t>(port));
+		socketAddress.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+		if (socketDescriptor < 0 ||
+			bind(socketDescriptor, reinterpret_cast<sockaddr*>(&socketAddress), sizeof(socketAddress)) < 0) {
+			std::string text = "couldn't listen on " + address + ": " + std::strerror(errno);
+			if (socketDescriptor >= 0) { close(socketDescriptor); }
+			throw std::runtime_error(text);
+		}
+	}
+	else {
+		sockaddr_un socketAddress{};
+		if (address.empty() || address.size() >= sizeof(socketAddress.sun_path)) {
+			throw std::runtime_error("wrong path of socket " + address);
+		}
+		socketAddress.sun_family = AF_UNIX;
+		std::strcpy(socketAddress.sun_path, address.c_str());
+		unlink(address.c_str());
+		socketDescriptor = socket(AF_UNIX, SOCK_STREAM, 0);
+		if (socketDescriptor < 0 ||
+			bind(socketDescriptor, reinterpret_cast<sockaddr*>(&socketAddress), sizeof(socketAddress)) < 0) {
+			std::string text = "couldn't listen on " + address + ": " + std::strerror(errno);
+			if (socketDescriptor >= 0) { close(socketDescriptor); }
+			throw std::runtime_error(text);
+		}
+		socketPath = address;
+	}
+	if (listen(socketDescriptor, SOMAXCONN) < 0) {
+		std::string text = "couldn't listen on " + address + ": " + std::strerror(errno);
+		close(socketDescriptor);
+		throw std::runtime_error(text);
+	}
+	return socketDescriptor;
+}
+/*!
+ * \brief stops the daemon, it can be called from signal handler
+ */
+void SolverDaemon::stop()
+{
+	isStopped = 1;
+	if (listeningSocket >= 0) {
+		shutdown(listeningSocket, SHUT_RDWR);
+	}
+}
+/*!
+ * \brief serves the requests of connection until it is closed, the protocol is chosen by the first byte
+ * \param connection descriptor of connected socket, it is not closed
+ */
+void SolverDaemon::serveConnection(int connection) const
+{
+	std::string buffer;
+	if (receiveMore(connection, buffer)) {
+		size_t firstSign = buffer.find_first_not_of(" \t\r\n");
+		if (firstSign != std::string::npos && buffer[firstSign] == '{') {
+			serveJson(connection, buffer);
+		}
+		else {
+			serveBinary(connection, buffer);
+		}
+	}
+}
+/*!
+ * \brief serves the line-delimited JSON requests, the too long request is answered with error and the connection is closed
+ * \param connection descriptor of connected socket
+ * \param buffer data already received
+ */
+void SolverDaemon::serveJson(int connection, std::string buffer) const
+{
+	size_t begin = 0;
+	do {
+		size_t end;
+		while ((end = buffer.find('\n', begin)) != std::string::npos) {
+			std::string request = buffer.substr(begin, end - begin);
+			begin = end + 1;
+			if (request.find_first_not_of(" \t\r") == std::string::npos) {
+				continue;
+			}
+			std::string response = answerJsonRequest(request);
+			response += '\n';
+			if (!sendAll(connection, response.data(), response.size())) {
+				return;
+			}
+		}
+		buffer.erase(0, begin);
+		begin = 0;
+		if (buffer.size() > maximumLengthOfJsonRequest) {
+			const std::string response = "{\"error\":\"request is longer than "
+				+ std::to_string(maximumLengthOfJsonRequest) + " bytes\"}\n";
+			sendAll(connection, response.data(), response.size());
+			shutdown(connection, SHUT_RDWR);
+			return;
+		}
+	} while (receiveMore(connection, buffer));
+}
+/*!
+ * \brief solves the case from one JSON request
+ * \param request JSON object with values named as BatchRunner::inputNames
+ * \return JSON object with results (null for the values which are not finite) or with error
+ */
+std::string SolverDaemon::answerJsonRequest(const std::string &request) const
+{
+	auto start = std::chrono::steady_clock::now();
+	double value[BatchRunner::quantityOfInputValues]{};
+	bool isSet[BatchRunner::quantityOfInputValues]{};
+	std::ostringstream response;
+	try {
+		readJsonObject(request, value, isSet);
+		for (int i = 0; i < BatchRunner::quantityOfInputValues; ++i) {
+			if (!isSet[i]) {
+				throw std::invalid_argument(std::string("missing \"") + BatchRunner::inputNames[i] + "\"");
+			}
+		}
+		BatchCase batchCase = runner.makeCase(value);
+		OutputData result;
+		solveCase(batchCase, result);
+		double resultValue[OutputData::quantityOfFields];
+		result.copyValuesTo(resultValue);
+		double latency = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+		response.precision(std::numeric_limits<double>::max_digits10);
+		response << '{';
+		for (int i = 0; i < OutputData::quantityOfFields; ++i) {
+			response << '"' << OutputData::fieldNames[i] << "\":";
+			if (std::isfinite(resultValue[i])) {
+				response << resultValue[i] << ',';
+			}
+			else {
+				response << "null,";
+			}
+		}
+		response << "\"status\":" << result.status << ',';
+		response << "\"latencyMicroseconds\":" << latency << '}';
+	}
+	catch (std::exception &error) {
+		response.str("");
+		response << "{\"error\":\"" << escapeJson(error.what()) << "\"}";
+	}
+	return response.str();
+}
+/*!
+ * \brief serves the length-prefixed binary requests
+ * \param connection descriptor of connected socket
+ * \param buffer data already received
+ */
+void SolverDaemon::serveBinary(int connection, std::string buffer) const
+{
+	const std::uint32_t requestSize = BatchRunner::quantityOfInputValues * sizeof(double);
+	const std::uint32_t responseSize = sizeof(DaemonBinaryResponse);
+	char message[sizeof(std::uint32_t) + sizeof(DaemonBinaryResponse)];
+	size_t begin = 0;
+	do {
+		while (buffer.size() - begin >= sizeof(std::uint32_t)) {
+			std::uint32_t size;
+			std::memcpy(&size, buffer.data() + begin, sizeof(size));
+			if (size != requestSize) {
+				return;//unknown message, the connection is closed
+			}
+			if (buffer.size() - begin < sizeof(size) + size) {
+				break;
+			}
+			auto start = std::chrono::steady_clock::now();
+			double value[BatchRunner::quantityOfInputValues];
+			std::memcpy(value, buffer.data() + begin + sizeof(size), requestSize);
+			begin += sizeof(size) + size;
+			DaemonBinaryResponse response{};
+			try {
+				BatchCase batchCase = runner.makeCase(value);
+				OutputData result;
+				solveCase(batchCase, result);
+				result.copyValuesTo(response.value);
+				response.statusOfResults = result.status;
+			}
+			catch (std::exception &) {
+				response.status = 1;
+			}
+			response.latencyMicroseconds =
+				std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+			std::memcpy(message, &responseSize, sizeof(responseSize));
+			std::memcpy(message + sizeof(responseSize), &response, sizeof(response));
+			if (!sendAll(connection, message, sizeof(message))) {
+				return;
+			}
+		}
+		buffer.erase(0, begin);
+		begin = 0;
+	} while (receiveMore(connection, buffer));
+}
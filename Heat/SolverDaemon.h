@@ -0,0 +1,100 @@
+#pragma once
+#include "BatchRunner.h"
+#include "ResultCache.h"
+#include <condition_variable>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <thread>
+/*!
+ * \brief The DaemonConnection class
+ * connected socket and the thread which serves it, the socket is closed after the thread is joined
+ */
+class DaemonConnection
+{
+public:
+	int socket{ -1 };
+	std::thread thread;
+	bool isFinished{ false };
+};
+/*!
+ * \brief The SolverDaemon class
+ * long-running server which keeps the properties of fluids loaded
+ * and solves the cases sent through Unix domain socket or localhost TCP,
+ * every connection is served by its own thread, at most maximumQuantityOfConnections at once
+ * (the next connections wait in the backlog of socket). When the daemon is stopped the open connections
+ * are shut down and their threads are joined before run() returns.
+ * The protocol is chosen by the first byte of connection:
+ * '{' means line-delimited JSON, the request is an object with numbers named as BatchRunner::inputNames,
+ * the response is an object with numbers named as OutputData::fieldNames (null if the value is not finite,
+ * see "status"), "latencyMicroseconds" or an object with "error" text, the connection is closed
+ * if the line of request is longer than maximumLengthOfJsonRequest;
+ * otherwise the binary protocol is used, every message starts with the 32-bit size of payload,
+ * the request payload is BatchRunner::quantityOfInputValues doubles in the order of line of input,
+ * the response payload is DaemonBinaryResponse.
+ * If the cache memory limit is set the results of repeated cases are taken from ResultCache
+ * \author Łukasz Dyraga
+ * \version 1.0
+ */
+class SolverDaemon
+{
+public:
+	SolverDaemon(const FluidLibrary &fluids, const BatchOptions &options);
+	SolverDaemon(const SolverDaemon &) = delete;
+	SolverDaemon& operator=(const SolverDaemon &) = delete;
+	void run(const std::string &address);
+	void serveConnection(int connection) const;
+	std::string answerJsonRequest(const std::string &request) const;
+	static void stop();
+	CacheStatistics getCacheStatistics() const;
+    /*!
+     * \brief maximum quantity of connections served at once
+     */
+	size_t maximumQuantityOfConnections{ 64 };
+    /*!
+     * \brief maximum length of line of JSON request
+     */
+	size_t maximumLengthOfJsonRequest{ 65536 };
+private:
+	void serveAndFinish(DaemonConnection *connection);
+	bool waitForFreeConnection();
+	void joinFinishedConnections();
+	void stopConnections();
+	void solveCase(BatchCase &batchCase, OutputData &result) const;
+	int openSocket(const std::string &address);
+	void serveJson(int connection, std::string buffer) const;
+	void serveBinary(int connection, std::string buffer) const;
+    /*!
+     * \brief solves the cases
+     */
+	BatchRunner runner;
+    /*!
+     * \brief results of recently solved cases
+     */
+	mutable ResultCache cache;
+    /*!
+     * \brief path of Unix domain socket, empty when TCP is used
+     */
+	std::string socketPath;
+    /*!
+     * \brief connections which are served or finished but not joined yet
+     */
+	std::list<DaemonConnection> connections;
+	std::mutex connectionsLock;
+	std::condition_variable isConnectionFinished;
+};
+/*!
+ * \brief The DaemonBinaryResponse class
+ * payload of response in binary protocol,
+ * status is 0 if the case was solved, otherwise values are not set,
+ * statusOfResults holds the status flags of results (see OutputData::StatusFlag)
+ */
+class DaemonBinaryResponse
+{
+public:
+	std::uint32_t status{ 0 };
+	std::uint32_t statusOfResults{ 0 };
+	double latencyMicroseconds{ 0 };
+	double value[OutputData::quantityOfFields]{};
+};
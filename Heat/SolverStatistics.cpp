@@ -0,0 +1,82 @@
+#include "SolverStatistics.h"
+#include <algorithm>
+#include <sstream>
+
+/*!
+ * \brief adds the statistics of other solves, the maximum is the greater one
+ * \param other statistics
+ * \return this statistics
+ */
+SolverStatistics& SolverStatistics::operator+=(const SolverStatistics &other)
+{
+	quantityOfSolves += other.quantityOfSolves;
+	intervalEvaluations += other.intervalEvaluations;
+	rootIterations += other.rootIterations;
+	maximumRootIterations = std::max(maximumRootIterations, other.maximumRootIterations);
+	residualEvaluations += other.residualEvaluations;
+	liquidPropertyLookups += other.liquidPropertyLookups;
+	airPropertyLookups += other.airPropertyLookups;
+	for (int i = 0; i < 4; ++i) {
+		regimeSelections[i] += other.regimeSelections[i];
+	}
+	timeOfInitialValues += other.timeOfInitialValues;
+	timeOfBracketing += other.timeOfBracketing;
+	timeOfRootFinding += other.timeOfRootFinding;
+	timeOfResults += other.timeOfResults;
+	return *this;
+}
+/*!
+ * \brief calculates the statistics collected between two moments
+ * \param other earlier statistics of the same thread
+ * \return difference, the maximum is taken from this statistics
+ */
+SolverStatistics SolverStatistics::operator-(const SolverStatistics &other) const
+{
+	SolverStatistics difference{ *this };
+	difference.quantityOfSolves -= other.quantityOfSolves;
+	difference.intervalEvaluations -= other.intervalEvaluations;
+	difference.rootIterations -= other.rootIterations;
+	difference.residualEvaluations -= other.residualEvaluations;
+	difference.liquidPropertyLookups -= other.liquidPropertyLookups;
+	difference.airPropertyLookups -= other.airPropertyLookups;
+	for (int i = 0; i < 4; ++i) {
+		difference.regimeSelections[i] -= other.regimeSelections[i];
+	}
+	difference.timeOfInitialValues -= other.timeOfInitialValues;
+	difference.timeOfBracketing -= other.timeOfBracketing;
+	difference.timeOfRootFinding -= other.timeOfRootFinding;
+	difference.timeOfResults -= other.timeOfResults;
+	return difference;
+}
+/*!
+ * \brief writes the statistics as JSON object
+ * \return JSON text
+ */
+std::string SolverStatistics::toJson() const
+{
+	std::ostringstream json;
+	json << "{\"quantityOfSolves\":" << quantityOfSolves
+		<< ",\"intervalEvaluations\":" << intervalEvaluations
+		<< ",\"rootIterations\":" << rootIterations
+		<< ",\"maximumRootIterations\":" << maximumRootIterations
+		<< ",\"residualEvaluations\":" << residualEvaluations
+		<< ",\"liquidPropertyLookups\":" << liquidPropertyLookups
+		<< ",\"airPropertyLookups\":" << airPropertyLookups
+		<< ",\"regimeSelections\":{\"noFlow\":" << regimeSelections[0]
+		<< ",\"laminar\":" << regimeSelections[1]
+		<< ",\"transitional\":" << regimeSelections[2]
+		<< ",\"turbulent\":" << regimeSelections[3]
+		<< "},\"timeOfPhases\":{\"initialValues\":" << timeOfInitialValues
+		<< ",\"bracketing\":" << timeOfBracketing
+		<< ",\"rootFinding\":" << timeOfRootFinding
+		<< ",\"results\":" << timeOfResults << "}}";
+	return json.str();
+}
+/*!
+ * \brief returns the statistics of current thread
+ */
+SolverStatistics& SolverStatistics::local()
+{
+	thread_local SolverStatistics statistics{};
+	return statistics;
+}
@@ -0,0 +1,82 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <string>
+/*!
+ * \brief The SolverStatistics class
+ * stores the counters and timers of solver, they are collected only when the program
+ * is built with HEAT_INSTRUMENTATION defined, otherwise the macros below are removed by preprocessor.
+ * Every thread counts into its own statistics (local()), solver and batch runner take the differences
+ * \author Łukasz Dyraga
+ * \version 1.0
+ */
+class SolverStatistics
+{
+public:
+	SolverStatistics& operator+=(const SolverStatistics &other);
+	SolverStatistics operator-(const SolverStatistics &other) const;
+	std::string toJson() const;
+	static SolverStatistics& local();
+    /*!
+     * \brief quantity of finished solves
+     */
+	std::uint64_t quantityOfSolves{ 0 };
+    /*!
+     * \brief evaluations of function during search of interval (getIntervalValues)
+     */
+	std::uint64_t intervalEvaluations{ 0 };
+    /*!
+     * \brief iterations of bisection and secant methods
+     */
+	std::uint64_t rootIterations{ 0 };
+    /*!
+     * \brief maximum quantity of root iterations of one solve, it is not subtracted by operator-
+     */
+	std::uint64_t maximumRootIterations{ 0 };
+    /*!
+     * \brief evaluations of difference of heat flows
+     */
+	std::uint64_t residualEvaluations{ 0 };
+	std::uint64_t liquidPropertyLookups{ 0 };
+	std::uint64_t airPropertyLookups{ 0 };
+    /*!
+     * \brief selections of natural convection regime: no flow, laminar, transitional, turbulent
+     */
+	std::uint64_t regimeSelections[4]{};
+    /*!
+     * \brief time of phases [s]
+     */
+	double timeOfInitialValues{ 0 };
+	double timeOfBracketing{ 0 };
+	double timeOfRootFinding{ 0 };
+	double timeOfResults{ 0 };
+};
+/*!
+ * \brief The ScopedPhaseTimer class
+ * adds the time of its life to the timer of phase
+ */
+class ScopedPhaseTimer
+{
+public:
+	explicit ScopedPhaseTimer(double &timeOfPhase):
+		timeOfPhase{timeOfPhase},start{std::chrono::steady_clock::now()} {}
+	~ScopedPhaseTimer()
+	{
+		timeOfPhase += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	}
+	ScopedPhaseTimer(const ScopedPhaseTimer &) = delete;
+	ScopedPhaseTimer& operator=(const ScopedPhaseTimer &) = delete;
+private:
+	double &timeOfPhase;
+	std::chrono::steady_clock::time_point start;
+};
+
+#ifdef HEAT_INSTRUMENTATION
+#define HEAT_COUNT(counter) (++SolverStatistics::local().counter)
+#define HEAT_COUNT_MANY(counter, quantity) (SolverStatistics::local().counter += (quantity))
+#define HEAT_TIME_PHASE(phase) ScopedPhaseTimer heatPhaseTimer{ SolverStatistics::local().phase }
+#else
+#define HEAT_COUNT(counter) ((void)0)
+#define HEAT_COUNT_MANY(counter, quantity) ((void)0)
+#define HEAT_TIME_PHASE(phase) ((void)0)
+#endif
@@ -0,0 +1,326 @@
+#include "SurrogateModel.h"
+#include "HeatTransferSolver.h"
+#include "MonteCarlo.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+/*!
+ * \brief returns the input value of case in the order of BatchRunner::inputNames
+ */
+double getInputValue(const BatchCase &batchCase, const int &input)
+{
+	const InputData &data = batchCase.data;
+	const double value[BatchRunner::quantityOfInputValues]{ data.innerDiameterOfPipe, data.thicknessOfPipe,
+		data.meanVelocityOfLiquid, data.meanTemperatureOfLiquid, static_cast<double>(batchCase.typeOfLiquid),
+		static_cast<double>(batchCase.typeOfForcedConvection), data.thermalConductivityOfIsolator,
+		data.thicknessOfIsolator, data.temperatureOfEnvironment, static_cast<double>(batchCase.typeOfEmissivity),
+		data.lengthOfPipe };
+	return value[input];
+}
+/*!
+ * \brief checks if input value is continuous (it is not type of liquid, forced convection or emissivity)
+ */
+bool isContinuousInput(const int &input)
+{
+	return input >= 0 && input < BatchRunner::quantityOfInputValues && input != 4 && input != 5 && input != 9;
+}
+}
+
+const int SurrogateModel::maximumQuantityOfAxes;
+/*!
+ * \brief constructor
+ * \param fluids properties of all liquids and air, they have to outlive the model
+ */
+SurrogateModel::SurrogateModel(const FluidLibrary &fluids):
+	fluids{&fluids}
+{
+}
+/*!
+ * \brief creates the case with base values and values of axes
+ * \param point values of axes
+ * \return case
+ */
+BatchCase SurrogateModel::makeCase(const double *point) const
+{
+	double value[BatchRunner::quantityOfInputValues];
+	std::copy(baseValues.begin(), baseValues.end(), value);
+	for (size_t i = 0; i < axes.size(); ++i) {
+		value[axes[i].input] = point[i];
+	}
+	return BatchRunner{ *fluids, BatchOptions{} }.makeCase(value);
+}
+/*!
+ * \brief solves the points of table, along the last axis every solve starts from the previous one
+ * \param begin index of first point
+ * \param end index after last point
+ * \param tolerance tolerance used by solver
+ */
+void SurrogateModel::solvePoints(const size_t &begin, const size_t &end, const double &tolerance)
+{
+	double point[maximumQuantityOfAxes];
+	double temperatureOnIsolator = 0;
+	for (size_t index = begin; index < end; ++index) {
+		size_t rest = index;
+		bool isFirstOnLastAxis = false;
+		for (int i = static_cast<int>(axes.size()) - 1; i >= 0; --i) {
+			int position = static_cast<int>(rest % axes[i].quantityOfPoints);
+			rest /= axes[i].quantityOfPoints;
+			point[i] = axes[i].bottom + (axes[i].upper - axes[i].bottom)*position / (axes[i].quantityOfPoints - 1);
+			if (i == static_cast<int>(axes.size()) - 1) {
+				isFirstOnLastAxis = position == 0;
+			}
+		}
+		BatchCase batchCase = makeCase(point);
+		HeatTransferSolver solver{ batchCase.data, fluids->liquid(batchCase.typeOfLiquid), fluids->air() };
+		if (isFirstOnLastAxis || index == begin) {
+			temperatureOnIsolator = 0.5*(batchCase.data.meanTemperatureOfLiquid + batchCase.data.temperatureOfEnvironment);
+		}
+		temperatureOnIsolator = solver.findTemperatureOnIsolator(temperatureOnIsolator, tolerance);
+		solver.setResults(temperatureOnIsolator);
+		solver.getResults()->copyValuesTo(&table[index*OutputData::quantityOfFields]);
+	}
+}
+/*!
+ * \brief solves the points of table and estimates the error of interpolation
+ * \param baseCase case which stores the values of inputs which are not axes
+ * \param axes axes of table, the continuous inputs only
+ * \param tolerance tolerance used by solver
+ * \param quantityOfThreads quantity of threads which solve the points
+ * \param quantityOfValidationPoints quantity of random points where the error is checked
+ * \throw std::invalid_argument if axis is wrong, base case has layers or its types are unknown
+ * \throw std::exception thrown while the points were solved (rethrown after all threads finished)
+ */
+void SurrogateModel::build(const BatchCase &baseCase, const std::vector<SurrogateAxis> &axes, const double &tolerance,
+	const unsigned int &quantityOfThreads, const int &quantityOfValidationPoints)
+{
+	if (axes.empty() || axes.size() > static_cast<size_t>(maximumQuantityOfAxes)) {
+		throw std::invalid_argument("Quantity of axes has to be from 1 to " + std::to_string(maximumQuantityOfAxes) + ".");
+	}
+	if (baseCase.data.layers.size() > 0) {
+		throw std::invalid_argument("Surrogate model does not support layers.");
+	}
+	size_t quantityOfPoints = 1;
+	for (const auto &axis : axes) {
+		if (!isContinuousInput(axis.input) || axis.quantityOfPoints < 2 || !(axis.upper > axis.bottom)) {
+			throw std::invalid_argument("Axis has to be continuous input with at least 2 points and upper value greater than bottom.");
+		}
+		quantityOfPoints *= axis.quantityOfPoints;
+	}
+	for (int i = 0; i < BatchRunner::quantityOfInputValues; ++i) {
+		baseValues[i] = getInputValue(baseCase, i);
+	}
+	this->axes = axes;
+	this->tolerance = tolerance;
+	table.clear();
+	double bottomPoint[maximumQuantityOfAxes];
+	for (size_t i = 0; i < axes.size(); ++i) {
+		bottomPoint[i] = axes[i].bottom;
+	}
+	fluids->liquid(makeCase(bottomPoint).typeOfLiquid);//the types of base case are checked before the threads start
+	table.assign(quantityOfPoints*OutputData::quantityOfFields, 0);
+	size_t quantityOfParts = std::max<size_t>(1, std::min<size_t>(quantityOfThreads, quantityOfPoints));
+	std::mutex errorLock;
+	std::exception_ptr error{};
+	auto solvePart = [&](size_t begin, size_t end) {
+		try {
+			solvePoints(begin, end, tolerance);
+		}
+		catch (...) {
+			std::lock_guard<std::mutex> lock(errorLock);
+			error = std::current_exception();
+		}
+	};
+	std::vector<std::thread> threads;
+	size_t partSize = quantityOfPoints / quantityOfParts;
+	size_t remainder = quantityOfPoints % quantityOfParts;
+	for (size_t part = 0, begin = 0; part < quantityOfParts; ++part) {
+		size_t size = partSize + (part < remainder ? 1 : 0);
+		threads.emplace_back(solvePart, begin, begin + size);
+		begin += size;
+	}
+	for (auto &thread : threads) {
+		thread.join();
+	}
+	if (error) {
+		table.clear();
+		std::rethrow_exception(error);
+	}
+	errors.fill(0);
+	for (int sample = 0; sample < quantityOfValidationPoints; ++sample) {
+		double point[maximumQuantityOfAxes];
+		for (size_t i = 0; i < axes.size(); ++i) {
+			point[i] = axes[i].bottom + (axes[i].upper - axes[i].bottom)*MonteCarlo::getUniformNumber(0, sample, i);
+		}
+		BatchCase batchCase = makeCase(point);
+		HeatTransferSolver solver{ batchCase.data, fluids->liquid(batchCase.typeOfLiquid), fluids->air() };
+		solver.runTheSolverFrom(0.5*(batchCase.data.meanTemperatureOfLiquid + batchCase.data.temperatureOfEnvironment), tolerance);
+		OutputData approximation{};
+		interpolate(point, approximation);
+		double exact[OutputData::quantityOfFields], approximate[OutputData::quantityOfFields];
+		solver.getResults()->copyValuesTo(exact);
+		approximation.copyValuesTo(approximate);
+		for (int field = 0; field < OutputData::quantityOfFields; ++field) {
+			double error = std::abs(approximate[field] - exact[field]) / std::max(std::abs(exact[field]), 1e-12);
+			errors[field] = std::max(errors[field], error);
+		}
+	}
+}
+/*!
+ * \brief calculates the results by multilinear interpolation of table
+ * \param point values of axes in the order of axes
+ * \param result interpolated results
+ * \return false if the point is outside of table (result is not changed)
+ */
+bool SurrogateModel::interpolate(const double *point, OutputData &result) const
+{
+	if (table.empty()) {
+		return false;
+	}
+	const int quantityOfAxes = static_cast<int>(axes.size());
+	size_t lowerIndex[maximumQuantityOfAxes], stride[maximumQuantityOfAxes];
+	double weight[maximumQuantityOfAxes];
+	size_t currentStride = 1;
+	for (int i = quantityOfAxes - 1; i >= 0; --i) {
+		const SurrogateAxis &axis = axes[i];
+		if (!(point[i] >= axis.bottom && point[i] <= axis.upper)) {
+			return false;
+		}
+		double position = (point[i] - axis.bottom) / (axis.upper - axis.bottom)*(axis.quantityOfPoints - 1);
+		size_t lower = std::min(static_cast<size_t>(position), static_cast<size_t>(axis.quantityOfPoints - 2));
+		lowerIndex[i] = lower;
+		weight[i] = position - lower;
+		stride[i] = currentStride;
+		currentStride *= axis.quantityOfPoints;
+	}
+	double value[OutputData::quantityOfFields]{};
+	for (int corner = 0; corner < (1 << quantityOfAxes); ++corner) {
+		double cornerWeight = 1;
+		size_t index = 0;
+		for (int i = 0; i < quantityOfAxes; ++i) {
+			bool isUpper = (corner >> i) & 1;
+			cornerWeight *= isUpper ? weight[i] : 1 - weight[i];
+			index += (lowerIndex[i] + (isUpper ? 1 : 0))*stride[i];
+		}
+		const double *values = &table[index*OutputData::quantityOfFields];
+		for (int field = 0; field < OutputData::quantityOfFields; ++field) {
+			value[field] += cornerWeight * values[field];
+		}
+	}
+	result.setValuesFrom(value);
+	return true;
+}
+/*!
+ * \brief
+ * calculates the results of case using table, the case is solved by HeatTransferSolver with the tolerance of build
+ * if it is outside of table, the values which are not axes differ from base case or the error is too large
+ * \param query case
+ * \param errorBudget maximum relative error which can be accepted
+ * \param isSolved if not null it is set to true when the solver was used
+ * \return results
+ */
+OutputData SurrogateModel::evaluate(const BatchCase &query, const double &errorBudget, bool *isSolved) const
+{
+	OutputData result{};
+	bool isTrusted = !table.empty() && getErrorEstimate() <= errorBudget && query.data.layers.size() == 0;
+	double point[maximumQuantityOfAxes];
+	for (int i = 0; i < BatchRunner::quantityOfInputValues && isTrusted; ++i) {
+		auto axis = std::find_if(axes.begin(), axes.end(), [i](const SurrogateAxis &axis) { return axis.input == i; });
+		if (axis == axes.end()) {
+			isTrusted = getInputValue(query, i) == baseValues[i];
+		}
+		else {
+			point[axis - axes.begin()] = getInputValue(query, i);
+		}
+	}
+	if (isTrusted && interpolate(point, result)) {
+		if (isSolved != nullptr) { *isSolved = false; }
+		return result;
+	}
+	InputData data{ query.data };
+	HeatTransferSolver solver{ data, fluids->liquid(query.typeOfLiquid), fluids->air() };
+	solver.runTheSolver(tolerance);
+	if (isSolved != nullptr) { *isSolved = true; }
+	return *solver.getResults();
+}
+/*!
+ * \brief returns the maximum relative error of all fields found during build
+ */
+double SurrogateModel::getErrorEstimate() const
+{
+	return *std::max_element(errors.begin(), errors.end());
+}
+/*!
+ * \brief returns the maximum relative error of every field found during build
+ */
+const std::array<double, OutputData::quantityOfFields>& SurrogateModel::getErrorsOfFields() const
+{
+	return errors;
+}
+/*!
+ * \brief saves the model in binary file format (see SurrogateFileHeader)
+ * \param output output stream opened in binary mode
+ */
+void SurrogateModel::save(std::ostream &output) const
+{
+	SurrogateFileHeader header{};
+	header.quantityOfAxes = static_cast<std::uint32_t>(axes.size());
+	header.tolerance = tolerance;
+	output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	output.write(reinterpret_cast<const char*>(baseValues.data()), sizeof(double)*baseValues.size());
+	for (const auto &axis : axes) {
+		std::int32_t values[2]{ axis.input, axis.quantityOfPoints };
+		double interval[2]{ axis.bottom, axis.upper };
+		output.write(reinterpret_cast<const char*>(values), sizeof(values));
+		output.write(reinterpret_cast<const char*>(interval), sizeof(interval));
+	}
+	output.write(reinterpret_cast<const char*>(errors.data()), sizeof(double)*errors.size());
+	output.write(reinterpret_cast<const char*>(table.data()), sizeof(double)*table.size());
+}
+/*!
+ * \brief loads the model saved by save
+ * \param input input stream opened in binary mode
+ * \throw std::runtime_error if the file is corrupted
+ */
+void SurrogateModel::load(std::istream &input)
+{
+	SurrogateFileHeader header{}, expected{};
+	if (!input.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+		std::memcmp(header.magic, expected.magic, sizeof(header.magic)) != 0 || header.version != expected.version ||
+		header.quantityOfFields != expected.quantityOfFields || header.quantityOfAxes == 0 ||
+		header.quantityOfAxes > static_cast<std::uint32_t>(maximumQuantityOfAxes) || !(header.tolerance > 0)) {
+		throw std::runtime_error("File is not a surrogate model.");
+	}
+	std::array<double, BatchRunner::quantityOfInputValues> loadedBaseValues{};
+	std::vector<SurrogateAxis> loadedAxes(header.quantityOfAxes);
+	input.read(reinterpret_cast<char*>(loadedBaseValues.data()), sizeof(double)*loadedBaseValues.size());
+	size_t quantityOfPoints = 1;
+	for (auto &axis : loadedAxes) {
+		std::int32_t values[2];
+		double interval[2];
+		input.read(reinterpret_cast<char*>(values), sizeof(values));
+		input.read(reinterpret_cast<char*>(interval), sizeof(interval));
+		axis = SurrogateAxis{ values[0], interval[0], interval[1], values[1] };
+		if (!input || !isContinuousInput(axis.input) || axis.quantityOfPoints < 2 || !(axis.upper > axis.bottom)) {
+			throw std::runtime_error("Surrogate model file is corrupted.");
+		}
+		quantityOfPoints *= axis.quantityOfPoints;
+	}
+	std::array<double, OutputData::quantityOfFields> loadedErrors{};
+	std::vector<double> loadedTable(quantityOfPoints*OutputData::quantityOfFields);
+	input.read(reinterpret_cast<char*>(loadedErrors.data()), sizeof(double)*loadedErrors.size());
+	input.read(reinterpret_cast<char*>(loadedTable.data()), sizeof(double)*loadedTable.size());
+	if (!input) {
+		throw std::runtime_error("Surrogate model file is corrupted.");
+	}
+	baseValues = loadedBaseValues;
+	axes = std::move(loadedAxes);
+	tolerance = header.tolerance;
+	errors = loadedErrors;
+	table = std::move(loadedTable);
+}
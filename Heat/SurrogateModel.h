@@ -0,0 +1,81 @@
+#pragma once
+#include "BatchRunner.h"
+#include "FluidLibrary.h"
+#include "OutputData.h"
+#include <array>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <vector>
+/*!
+ * \brief The SurrogateAxis class
+ * describes one axis of the table: the input value (index of BatchRunner::inputNames)
+ * and the evenly spaced points on it
+ */
+class SurrogateAxis
+{
+public:
+	int input;
+	double bottom;
+	double upper;
+	int quantityOfPoints;
+};
+/*!
+ * \brief The SurrogateFileHeader class
+ * header of the surrogate model file with the tolerance of build, after the header: the base case (BatchRunner::quantityOfInputValues doubles),
+ * the axes, the estimated errors (OutputData::quantityOfFields doubles) and the table of results
+ */
+class SurrogateFileHeader
+{
+public:
+	char magic[4]{ 'H','T','R','S' };
+	std::uint32_t version{ 2 };
+	std::uint32_t quantityOfFields{ OutputData::quantityOfFields };
+	std::uint32_t quantityOfAxes{ 0 };
+	double tolerance{ 0.001 };
+};
+/*!
+ * \brief The SurrogateModel class
+ * precomputed table of results over the hypercube of input values (the other inputs are taken from base case),
+ * the results between the points are calculated by multilinear interpolation.
+ * The error of interpolation is estimated during build by comparison with the solver at random points,
+ * the queries outside the table, with other base values or with too large error are solved by HeatTransferSolver
+ * with the tolerance of build
+ * \author Łukasz Dyraga
+ * \version 1.0
+ */
+class SurrogateModel
+{
+public:
+	explicit SurrogateModel(const FluidLibrary &fluids);
+	void build(const BatchCase &baseCase, const std::vector<SurrogateAxis> &axes, const double &tolerance = 0.001,
+		const unsigned int &quantityOfThreads = 1, const int &quantityOfValidationPoints = 1000);
+	void save(std::ostream &output) const;
+	void load(std::istream &input);
+	bool interpolate(const double *point, OutputData &result) const;
+	OutputData evaluate(const BatchCase &query, const double &errorBudget, bool *isSolved = nullptr) const;
+	double getErrorEstimate() const;
+	const std::array<double, OutputData::quantityOfFields>& getErrorsOfFields() const;
+    /*!
+     * \brief maximum quantity of axes of table
+     */
+	static const int maximumQuantityOfAxes{ 6 };
+private:
+	void solvePoints(const size_t &begin, const size_t &end, const double &tolerance);
+	BatchCase makeCase(const double *point) const;
+	const FluidLibrary *fluids;
+	std::array<double, BatchRunner::quantityOfInputValues> baseValues{};
+	std::vector<SurrogateAxis> axes;
+    /*!
+     * \brief tolerance of solver used by build, the queries which are not interpolated are solved with it
+     */
+	double tolerance{ 0.001 };
+    /*!
+     * \brief maximum relative error of every field found during build
+     */
+	std::array<double, OutputData::quantityOfFields> errors{};
+    /*!
+     * \brief results in points of table, OutputData::quantityOfFields values for every point, the last axis changes the fastest
+     */
+	std::vector<double> table;
+};
@@ -6,6 +6,7 @@
 ThermalProperties::ThermalProperties(std::string file_path):
 	file_path{file_path}
 {
+	HEAT_TRACE_SCOPE("load properties", "io");
 	openFile();
 }
 /*!
@@ -82,6 +83,15 @@ double ThermalProperties::valueAt(const double & temperature, const PropertyType
 		return interpolation.calculate(temperature, this->temperature, prandtlNumber);;
 	}
 }
+/*!
+ * \brief checks if the temperature is covered by the table, otherwise the properties are extrapolated
+ * \param temperature value of temperature
+ * \return true if the temperature is between the first and the last temperature of table
+ */
+bool ThermalProperties::isInRange(const double &temperature)const
+{
+	return !this->temperature.empty() && temperature >= this->temperature.front() && temperature <= this->temperature.back();
+}
 /*!
  * \brief displays all data using iostream library, this function is used for tests
  */
@@ -127,9 +137,7 @@ void ThermalProperties::openFile()
         //assert(false); //visual studio
         //below, qt
         std::string text="Couldn't open file which stores properties, "+file_path;
-        QMessageBox::critical(nullptr,"file corrupted",
-                              QString::fromStdString(text));
-       exit(EXIT_FAILURE);
+        showCriticalError("file corrupted", text);
 	}
 }
 /*!
@@ -205,14 +213,27 @@ void ThermalProperties::insertLoadedValue(std::string number, int typeOfData)
     }
     catch (std::invalid_argument) {
         std::string text="Data in "+file_path+" are corrupted.";
-        QMessageBox::critical(nullptr,"Error while loading data",
-                              QString::fromStdString(text));
-        exit(EXIT_FAILURE);
+        showCriticalError("Error while loading data", text);
     }
     catch(std::out_of_range){
         std::string text="Data in "+file_path+" are too long for double type.";
-        QMessageBox::critical(nullptr,"Error while loading data",
-                              QString::fromStdString(text));
-        exit(EXIT_FAILURE);
+        showCriticalError("Error while loading data", text);
     }
 }
+/*!
+ * \brief
+ * displays critical error and closes the application,
+ * the error is written on standard error stream when built without GUI
+ * \param title title of the error
+ * \param text description of the error
+ */
+void ThermalProperties::showCriticalError(const std::string &title, const std::string &text)
+{
+#ifndef HEAT_NO_GUI
+	QMessageBox::critical(nullptr, QString::fromStdString(title),
+		QString::fromStdString(text));
+#else
+	std::cerr << title << ": " << text << std::endl;
+#endif
+	exit(EXIT_FAILURE);
+}
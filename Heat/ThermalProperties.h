@@ -1,10 +1,13 @@
 #pragma once
 #include <string>
 #include "Interpolation.h"
+#include "TraceRecorder.h"
 #include <vector>
 #include <fstream>
 #include <assert.h>
+#ifndef HEAT_NO_GUI
 #include <QMessageBox>
+#endif
 /*!
  * \brief The PropertyType enum
  * class stores the properties which is used in ThermalProperties class
@@ -25,6 +28,7 @@ public:
     ~ThermalProperties();
 	ThermalProperties(const std::string file_path);
     double valueAt(const double &temperature, PropertyType type)const;
+    bool isInRange(const double &temperature)const;
 	void displayAllData();
     /*!
      * \brief stores the values of temperature
@@ -66,6 +70,7 @@ private:
 	void getLoadedData();
 	void insertLoadedValue(std::string number, int typeOfData );
 	void display(std::vector<double> data, std::string header);
+	void showCriticalError(const std::string &title, const std::string &text);
 };
 
  
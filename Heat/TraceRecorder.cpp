@@ -0,0 +1,165 @@
+#include "TraceRecorder.h"
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+std::atomic<bool> TraceRecorder::isRecording{ false };
+
+namespace {
+/*!
+ * \brief The TraceEvent class
+ * one complete event of trace
+ */
+class TraceEvent
+{
+public:
+	const char *name;
+	const char *category;
+	double start;
+	double duration;
+};
+/*!
+ * \brief The ThreadBuffer class
+ * events of one thread, only the owner thread appends them
+ */
+class ThreadBuffer
+{
+public:
+	explicit ThreadBuffer(const int &threadIndex): threadIndex{threadIndex} { events.reserve(4096); }
+	int threadIndex;
+	std::vector<TraceEvent> events;
+};
+/*!
+ * \brief The TraceState class
+ * buffers of all threads, they are kept after the end of thread until the file is written
+ */
+class TraceState
+{
+public:
+	std::mutex lock;
+	std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+	std::string filePath;
+	bool isExitHandlerRegistered{ false };
+	std::chrono::steady_clock::time_point beginning{ std::chrono::steady_clock::now() };
+};
+TraceState& getState()
+{
+	static TraceState *state = new TraceState{};
+	return *state;
+}
+/*!
+ * \brief returns the buffer of current thread, the buffer is registered at the first event of thread
+ */
+ThreadBuffer& getThreadBuffer()
+{
+	thread_local std::shared_ptr<ThreadBuffer> buffer;
+	if (!buffer) {
+		TraceState &state = getState();
+		std::lock_guard<std::mutex> guard{ state.lock };
+		buffer = std::make_shared<ThreadBuffer>(static_cast<int>(state.buffers.size()) + 1);
+		state.buffers.push_back(buffer);
+	}
+	return *buffer;
+}
+/*!
+ * \brief writes the text as JSON string
+ */
+void writeJsonString(std::ostream &output, const char *text)
+{
+	output << '"';
+	for (const char *sign = text; *sign != '\0'; ++sign) {
+		if (*sign == '"' || *sign == '\\') {
+			output << '\\';
+		}
+		output << *sign;
+	}
+	output << '"';
+}
+void stopAtExit()
+{
+	TraceRecorder::stop();
+}
+}
+/*!
+ * \brief starts the recording of events, the previous events are removed
+ * \param filePath path of trace file written by stop() or at exit
+ */
+void TraceRecorder::start(const std::string &filePath)
+{
+	TraceState &state = getState();
+	{
+		std::lock_guard<std::mutex> guard{ state.lock };
+		for (auto &buffer : state.buffers) {
+			buffer->events.clear();
+		}
+		state.filePath = filePath;
+		if (!state.isExitHandlerRegistered) {
+			std::atexit(stopAtExit);
+			state.isExitHandlerRegistered = true;
+		}
+	}
+	isRecording.store(true, std::memory_order_release);
+}
+/*!
+ * \brief
+ * stops the recording and writes the trace file,
+ * it has to be called when the traced threads do not record events
+ * \return false if the file could not be written or tracing was not started
+ */
+bool TraceRecorder::stop()
+{
+	if (!isRecording.exchange(false)) {
+		return false;
+	}
+	TraceState &state = getState();
+	std::lock_guard<std::mutex> guard{ state.lock };
+	std::ofstream file(state.filePath);
+	if (!file.is_open()) {
+		return false;
+	}
+	file.precision(3);
+	file << std::fixed << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+	bool isFirst = true;
+	for (const auto &buffer : state.buffers) {
+		if (buffer->events.empty()) {
+			continue;
+		}
+		file << (isFirst ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->threadIndex
+			<< ",\"args\":{\"name\":\"thread " << buffer->threadIndex << "\"}}";
+		isFirst = false;
+		for (const auto &event : buffer->events) {
+			file << ",\n{\"name\":";
+			writeJsonString(file, event.name);
+			file << ",\"cat\":";
+			writeJsonString(file, event.category);
+			file << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->threadIndex << ",\"ts\":" << event.start
+				<< ",\"dur\":" << event.duration << '}';
+		}
+		buffer->events.clear();
+	}
+	file << "\n]}\n";
+	return static_cast<bool>(file);
+}
+/*!
+ * \brief adds the complete event to the buffer of current thread
+ * \param name name of event (string literal)
+ * \param category category of event (string literal)
+ * \param start time of beginning [us]
+ * \param duration duration [us]
+ */
+void TraceRecorder::addEvent(const char *name, const char *category, const double &start, const double &duration)
+{
+	if (!isEnabled()) {
+		return;
+	}
+	getThreadBuffer().events.push_back(TraceEvent{ name, category, start, duration });
+}
+/*!
+ * \brief returns the time since the start of program [us]
+ */
+double TraceRecorder::getTime()
+{
+	return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - getState().beginning).count();
+}
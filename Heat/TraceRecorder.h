@@ -0,0 +1,63 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <string>
+/*!
+ * \brief The TraceRecorder class
+ * records the scoped events of all threads and writes them as Chrome/Perfetto trace JSON file
+ * (chrome://tracing, ui.perfetto.dev). Every thread appends events to its own buffer without locks,
+ * the file is written by stop() or at the exit of program. When tracing is not started
+ * every traced scope costs one check of isEnabled() and the test of null name in its destructor
+ * \author Łukasz Dyraga
+ * \version 1.0
+ */
+class TraceRecorder
+{
+public:
+	static void start(const std::string &filePath);
+	static bool stop();
+    /*!
+     * \brief returns true if the events are recorded
+     */
+	static bool isEnabled() { return isRecording.load(std::memory_order_relaxed); }
+	static void addEvent(const char *name, const char *category, const double &start, const double &duration);
+	static double getTime();
+private:
+	static std::atomic<bool> isRecording;
+};
+/*!
+ * \brief The TraceScope class
+ * records the event which lasts as long as the object, name and category have to be string literals
+ */
+class TraceScope
+{
+public:
+	TraceScope(const char *name, const char *category):
+		name{nullptr},category{category},start{0}
+	{
+		if (TraceRecorder::isEnabled()) {
+			this->name = name;
+			start = TraceRecorder::getTime();
+		}
+	}
+	~TraceScope()
+	{
+		if (name != nullptr) {
+			TraceRecorder::addEvent(name, category, start, TraceRecorder::getTime() - start);
+		}
+	}
+	TraceScope(const TraceScope &) = delete;
+	TraceScope& operator=(const TraceScope &) = delete;
+private:
+    /*!
+     * \brief name of event, null if tracing was not enabled, so the destructor does not check isEnabled() again
+     */
+	const char *name;
+	const char *category;
+    /*!
+     * \brief time of beginning [us]
+     */
+	double start;
+};
+
+#define HEAT_TRACE_SCOPE(name, category) TraceScope heatTraceScope{ name, category }
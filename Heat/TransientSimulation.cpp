@@ -0,0 +1,236 @@
+#include "TransientSimulation.h"
+#include "AxialMarching.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+/*!
+ * \brief constructor
+ * \param data input data of the whole pipe, the mean temperature of liquid is the inlet temperature
+ * \param liquid properties of liquid, they have to outlive the object
+ * \param air properties of air, they have to outlive the object
+ * \throw std::invalid_argument if the length of pipe is not positive
+ */
+TransientSimulation::TransientSimulation(const InputData &data, const ThermalProperties &liquid,
+	const ThermalProperties &air):
+	segmentData{getDataPerMeter(data)},solver{segmentData, liquid, air},liquid{&liquid},air{&air},
+	inletTemperature{data.meanTemperatureOfLiquid},lengthOfPipe{data.lengthOfPipe},
+	nominalVelocityOfLiquid{data.meanVelocityOfLiquid},velocityOfLiquid{data.meanVelocityOfLiquid},lengthOfSegment{0},
+	isFactorizationValid{false},quantityOfFactorizations{0}
+{
+	if (!(data.lengthOfPipe > 0)) {
+		throw std::invalid_argument("Length of pipe has to be positive.");
+	}
+}
+/*!
+ * \brief copies the input data and sets the length of one meter
+ * \param data input data of the whole pipe
+ * \return input data of one meter of pipe
+ */
+InputData TransientSimulation::getDataPerMeter(const InputData &data)
+{
+	InputData dataPerMeter{data};
+	dataPerMeter.lengthOfPipe = 1;
+	return dataPerMeter;
+}
+/*!
+ * \brief runs the simulation
+ * \param settings settings of simulation
+ * \throw std::invalid_argument if the quantity of segments or the time step is not positive
+ * \return samples of state, time to freeze and the final temperatures
+ */
+TransientResults TransientSimulation::run(const TransientSettings &settings)
+{
+	if (settings.quantityOfSegments == 0 || !(settings.timeStep > 0) || settings.stepsBetweenSamples == 0) {
+		throw std::invalid_argument("Quantity of segments, time step and steps between samples have to be positive.");
+	}
+	velocityOfLiquid = nominalVelocityOfLiquid;
+	lengthOfSegment = lengthOfPipe / settings.quantityOfSegments;
+	setInitialState(settings);
+	TransientResults results;
+	results.samples.push_back(getSample(0));
+	size_t quantityOfSteps = static_cast<size_t>(std::ceil(settings.simulationTime / settings.timeStep));
+	double time = 0;
+	for (size_t i = 1; i <= quantityOfSteps; ++i) {
+		if (velocityOfLiquid > 0 && settings.shutdownTime >= 0 && time >= settings.shutdownTime) {
+			velocityOfLiquid = 0;
+			for (size_t segment = 0; segment < settings.quantityOfSegments; ++segment) {
+				updateCoefficients(segment, settings);
+			}
+		}
+		step(settings);
+		time = i * settings.timeStep;
+		if (results.timeToFreeze < 0 &&
+			*std::min_element(temperatureOfLiquid.begin(), temperatureOfLiquid.end()) <= settings.freezingTemperature) {
+			results.timeToFreeze = time;
+		}
+		if (i % settings.stepsBetweenSamples == 0 || i == quantityOfSteps) {
+			results.samples.push_back(getSample(time));
+		}
+	}
+	results.temperatureOfLiquid = temperatureOfLiquid;
+	results.temperatureOnIsolator = temperatureOnIsolator;
+	results.quantityOfFactorizations = quantityOfFactorizations;
+	return results;
+}
+/*!
+ * \brief sets the initial temperatures and coefficients of all segments
+ * \param settings settings of simulation
+ */
+void TransientSimulation::setInitialState(const TransientSettings &settings)
+{
+	const size_t size = settings.quantityOfSegments;
+	for (std::vector<double> *values : { &updatedTemperatureOfLiquid, &updatedTemperatureOnIsolator,
+		&heatCapacityOfLiquid, &heatCapacityFlow, &axialConductance, &innerConductance, &heatCapacityOfIsolator,
+		&outerConductance, &lowerDiagonal, &modifiedUpperDiagonal, &inverseOfPivot, &isolatorConstant,
+		&isolatorFactor, &rightHandSide }) {
+		values->assign(size, 0);
+	}
+	if (settings.isStartedFromSteadyState && velocityOfLiquid > 0) {
+		InputData data{ segmentData };
+		data.lengthOfPipe = lengthOfPipe;
+		data.meanTemperatureOfLiquid = inletTemperature;
+		AxialMarching marching{ data, *liquid, *air };
+		AxialProfile profile = marching.march(size);
+		temperatureOfLiquid.resize(size);
+		for (size_t i = 0; i < size; ++i) {
+			temperatureOfLiquid[i] = 0.5*(profile.temperatureOfLiquid[i] + profile.temperatureOfLiquid[i + 1]);
+		}
+		temperatureOnIsolator = profile.temperatureOnIsolator;
+	}
+	else {
+		double temperature = settings.isStartedFromSteadyState ? inletTemperature : settings.initialTemperature;
+		temperatureOfLiquid.assign(size, temperature);
+		temperatureOnIsolator.assign(size, temperature);
+	}
+	for (size_t i = 0; i < size; ++i) {
+		updateCoefficients(i, settings);
+	}
+}
+/*!
+ * \brief
+ * calculates the coefficients of segment for its current temperatures,
+ * the Nusselt number of laminar flow (3.66) is the lower limit of heat transfer between liquid and wall,
+ * it is used alone if the liquid does not flow (the input data keeps the nominal velocity)
+ * \param segment index of segment
+ * \param settings settings of simulation
+ */
+void TransientSimulation::updateCoefficients(const size_t &segment, const TransientSettings &settings)
+{
+	const double minimumNusseltNumber = 3.66;
+	const double PI = segmentData.PI;
+	double temperature = temperatureOfLiquid[segment];
+	segmentData.meanTemperatureOfLiquid = temperature;
+	solver.calculateInitialValues();
+	const OutputData *coefficients = solver.getResults();
+	double conductivity = liquid->valueAt(temperature, PropertyType::conductivity);
+	double viscosity = liquid->valueAt(temperature, PropertyType::viscosity);
+	double prandtl = liquid->valueAt(temperature, PropertyType::prandtl);
+	double innerDiameter = segmentData.innerDiameterOfPipe;
+	double convectionCoefficient = minimumNusseltNumber * conductivity / innerDiameter;
+	if (velocityOfLiquid > 0) {
+		convectionCoefficient = std::max(coefficients->convectionCoefficient1, convectionCoefficient);
+	}
+	double resistanceOfThermalPenetration = 1.0 / (convectionCoefficient*PI*innerDiameter);
+	double areaOfLiquid = 0.25*PI*innerDiameter*innerDiameter;
+	double areaOfWall = 0.25*PI*(segmentData.outerDiameterOfPipe*segmentData.outerDiameterOfPipe -
+		innerDiameter * innerDiameter);
+	double areaOfIsolator = 0.25*PI*(segmentData.overallDiameterOfPipe*segmentData.overallDiameterOfPipe -
+		segmentData.outerDiameterOfPipe*segmentData.outerDiameterOfPipe);
+	double heatCapacityPerVolume = prandtl * conductivity / viscosity;
+	heatCapacityOfLiquid[segment] = heatCapacityPerVolume * areaOfLiquid + settings.heatCapacityOfPipeWall*areaOfWall;
+	heatCapacityFlow[segment] = heatCapacityPerVolume * areaOfLiquid*velocityOfLiquid;
+	axialConductance[segment] = conductivity * areaOfLiquid / (lengthOfSegment*lengthOfSegment);
+	innerConductance[segment] = 1.0 / (resistanceOfThermalPenetration + coefficients->resistanceOfThermalConduction);
+	heatCapacityOfIsolator[segment] = settings.heatCapacityOfIsolator*areaOfIsolator;
+	double surfaceTemperature = temperatureOnIsolator[segment];
+	outerConductance[segment] = PI * segmentData.overallDiameterOfPipe*
+		(solver.getConvectionCeofficient2(surfaceTemperature) + solver.getRadiationCoefficient2(surfaceTemperature));
+	updatedTemperatureOfLiquid[segment] = temperature;
+	updatedTemperatureOnIsolator[segment] = surfaceTemperature;
+	isFactorizationValid = false;
+}
+/*!
+ * \brief
+ * eliminates the isolator nodes and factorizes the tridiagonal matrix of liquid nodes
+ * (Thomas algorithm), the factorization depends only on the coefficients
+ * \param settings settings of simulation
+ */
+void TransientSimulation::factorize(const TransientSettings &settings)
+{
+	const size_t size = temperatureOfLiquid.size();
+	const bool isFlowing = velocityOfLiquid > 0;
+	double previousModifiedUpper = 0;
+	for (size_t i = 0; i < size; ++i) {
+		double capacityOfIsolator = heatCapacityOfIsolator[i] / settings.timeStep;
+		isolatorFactor[i] = innerConductance[i] / (capacityOfIsolator + innerConductance[i] + outerConductance[i]);
+		double flow = heatCapacityFlow[i] / lengthOfSegment;
+		bool hasPrevious = i > 0 || isFlowing;
+		bool hasNext = i + 1 < size;
+		double diagonal = heatCapacityOfLiquid[i] / settings.timeStep + flow +
+			axialConductance[i] * ((hasPrevious ? 1 : 0) + (hasNext ? 1 : 0)) +
+			innerConductance[i] * (1 - isolatorFactor[i]);
+		lowerDiagonal[i] = i > 0 ? -(flow + axialConductance[i]) : 0;
+		double upper = hasNext ? -axialConductance[i] : 0;
+		double pivot = diagonal - lowerDiagonal[i] * previousModifiedUpper;
+		inverseOfPivot[i] = 1.0 / pivot;
+		modifiedUpperDiagonal[i] = upper * inverseOfPivot[i];
+		previousModifiedUpper = modifiedUpperDiagonal[i];
+	}
+	isFactorizationValid = true;
+	++quantityOfFactorizations;
+}
+/*!
+ * \brief makes one implicit time step, the factorization is reused if the coefficients did not change
+ * \param settings settings of simulation
+ */
+void TransientSimulation::step(const TransientSettings &settings)
+{
+	if (!isFactorizationValid) {
+		factorize(settings);
+	}
+	const size_t size = temperatureOfLiquid.size();
+	const double temperatureOfEnvironment = segmentData.temperatureOfEnvironment;
+	for (size_t i = 0; i < size; ++i) {
+		double capacityOfIsolator = heatCapacityOfIsolator[i] / settings.timeStep;
+		isolatorConstant[i] = (capacityOfIsolator*temperatureOnIsolator[i] + outerConductance[i] * temperatureOfEnvironment) /
+			(capacityOfIsolator + innerConductance[i] + outerConductance[i]);
+		rightHandSide[i] = heatCapacityOfLiquid[i] / settings.timeStep*temperatureOfLiquid[i] +
+			innerConductance[i] * isolatorConstant[i];
+	}
+	if (velocityOfLiquid > 0) {
+		rightHandSide[0] += (heatCapacityFlow[0] / lengthOfSegment + axialConductance[0])*inletTemperature;
+	}
+	rightHandSide[0] *= inverseOfPivot[0];
+	for (size_t i = 1; i < size; ++i) {
+		rightHandSide[i] = (rightHandSide[i] - lowerDiagonal[i] * rightHandSide[i - 1])*inverseOfPivot[i];
+	}
+	temperatureOfLiquid[size - 1] = rightHandSide[size - 1];
+	for (size_t i = size - 1; i-- > 0;) {
+		temperatureOfLiquid[i] = rightHandSide[i] - modifiedUpperDiagonal[i] * temperatureOfLiquid[i + 1];
+	}
+	for (size_t i = 0; i < size; ++i) {
+		temperatureOnIsolator[i] = isolatorConstant[i] + isolatorFactor[i] * temperatureOfLiquid[i];
+		if (std::abs(temperatureOfLiquid[i] - updatedTemperatureOfLiquid[i]) > settings.temperatureChangeForUpdate ||
+			std::abs(temperatureOnIsolator[i] - updatedTemperatureOnIsolator[i]) > settings.temperatureChangeForUpdate) {
+			updateCoefficients(i, settings);
+		}
+	}
+}
+/*!
+ * \brief returns the current state of pipe
+ * \param time current time
+ * \return state of pipe
+ */
+TransientSample TransientSimulation::getSample(const double &time) const
+{
+	TransientSample sample;
+	sample.time = time;
+	sample.outletTemperatureOfLiquid = temperatureOfLiquid.back();
+	sample.minimumTemperatureOfLiquid = *std::min_element(temperatureOfLiquid.begin(), temperatureOfLiquid.end());
+	sample.heatFlow = 0;
+	for (size_t i = 0; i < temperatureOnIsolator.size(); ++i) {
+		sample.heatFlow += outerConductance[i] * (temperatureOnIsolator[i] - segmentData.temperatureOfEnvironment)*
+			lengthOfSegment;
+	}
+	return sample;
+}
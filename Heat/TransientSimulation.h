@@ -0,0 +1,180 @@
+#pragma once
+#include "InputData.h"
+#include "ThermalProperties.h"
+#include "HeatTransferSolver.h"
+#include <vector>
+/*!
+ * \brief The TransientSettings class
+ * stores the settings of transient simulation
+ */
+class TransientSettings
+{
+public:
+    /*!
+     * \brief quantity of axial segments of pipe
+     */
+	size_t quantityOfSegments{ 100 };
+    /*!
+     * \brief time step [s]
+     */
+	double timeStep{ 60 };
+    /*!
+     * \brief simulated time [s]
+     */
+	double simulationTime{ 86400 };
+    /*!
+     * \brief time of pump shutdown [s], after it the liquid does not flow, negative means never
+     */
+	double shutdownTime{ -1 };
+    /*!
+     * \brief true if the simulation starts from steady state (axial marching),
+     * otherwise the liquid and isolator have initialTemperature (warm-up)
+     */
+	bool isStartedFromSteadyState{ true };
+    /*!
+     * \brief initial temperature of liquid and isolator if the simulation does not start from steady state [K]
+     */
+	double initialTemperature{ 0 };
+    /*!
+     * \brief temperature for which the time to freeze is reported [K]
+     */
+	double freezingTemperature{ 273.15 };
+    /*!
+     * \brief heat capacity of isolator per volume (density multiplied by specific heat) [J/(m^3 K)]
+     */
+	double heatCapacityOfIsolator{ 8.4e4 };
+    /*!
+     * \brief heat capacity of pipe wall per volume, the wall has the temperature of liquid [J/(m^3 K)]
+     */
+	double heatCapacityOfPipeWall{ 3.9e6 };
+    /*!
+     * \brief change of temperature of segment after which its coefficients are calculated again [K]
+     */
+	double temperatureChangeForUpdate{ 0.5 };
+    /*!
+     * \brief quantity of time steps between the saved samples
+     */
+	size_t stepsBetweenSamples{ 60 };
+};
+/*!
+ * \brief The TransientSample class
+ * stores the state of pipe at one moment
+ */
+class TransientSample
+{
+public:
+	double time{ 0 };
+	double outletTemperatureOfLiquid{ 0 };
+	double minimumTemperatureOfLiquid{ 0 };
+    /*!
+     * \brief heat flow lost to the environment by the whole pipe [W]
+     */
+	double heatFlow{ 0 };
+};
+/*!
+ * \brief The TransientResults class
+ * stores the results of transient simulation
+ */
+class TransientResults
+{
+public:
+	std::vector<TransientSample> samples;
+    /*!
+     * \brief time after which the liquid in any segment reaches the freezing temperature, negative if never [s]
+     */
+	double timeToFreeze{ -1 };
+    /*!
+     * \brief temperature of liquid in every segment at the end of simulation
+     */
+	std::vector<double> temperatureOfLiquid;
+    /*!
+     * \brief temperature on isolator in every segment at the end of simulation
+     */
+	std::vector<double> temperatureOnIsolator;
+    /*!
+     * \brief quantity of factorizations of the matrix, the factorization is reused while the coefficients do not change
+     */
+	size_t quantityOfFactorizations{ 0 };
+};
+/*!
+ * \brief The TransientSimulation class
+ * integrates the temperature of liquid and isolator along the pipe over time,
+ * every segment has the node of liquid (with the pipe wall) and the node of isolator surface,
+ * they are connected by the resistances of steady model (thermal penetration and conduction).
+ * The implicit Euler method is used: the isolator nodes are eliminated and the liquid nodes
+ * (upwind flow and axial conduction) give the tridiagonal matrix solved by Thomas algorithm.
+ * The coefficients (properties, heat transfer coefficients) of segment are calculated again only
+ * when its temperature changes more than TransientSettings::temperatureChangeForUpdate,
+ * so the factorization of matrix is reused by many steps.
+ * The latent heat of freezing is not modelled.
+ * \author Łukasz Dyraga
+ * \version 1.0
+ */
+class TransientSimulation
+{
+public:
+	TransientSimulation(const InputData &data, const ThermalProperties &liquid, const ThermalProperties &air);
+	TransientResults run(const TransientSettings &settings);
+private:
+	static InputData getDataPerMeter(const InputData &data);
+	void setInitialState(const TransientSettings &settings);
+	void updateCoefficients(const size_t &segment, const TransientSettings &settings);
+	void factorize(const TransientSettings &settings);
+	void step(const TransientSettings &settings);
+	TransientSample getSample(const double &time) const;
+    /*!
+     * \brief input data of one meter of pipe, used for the coefficients of segment
+     */
+	InputData segmentData;
+    /*!
+     * \brief solver used for the heat transfer coefficients of segments
+     */
+	HeatTransferSolver solver;
+    /*!
+     * \brief properties of liquid which flows through pipe
+     */
+	const ThermalProperties *liquid;
+    /*!
+     * \brief properties of air
+     */
+	const ThermalProperties *air;
+    /*!
+     * \brief temperature of liquid which flows into the pipe
+     */
+	double inletTemperature;
+	double lengthOfPipe;
+    /*!
+     * \brief velocity of liquid given in input data, every run starts with it
+     */
+	const double nominalVelocityOfLiquid;
+    /*!
+     * \brief current velocity of liquid, 0 after the pump shutdown
+     */
+	double velocityOfLiquid;
+	double lengthOfSegment;
+    /*!
+     * \brief state of segments
+     */
+	std::vector<double> temperatureOfLiquid, temperatureOnIsolator;
+    /*!
+     * \brief temperature of liquid and isolator for which the coefficients of segment were calculated
+     */
+	std::vector<double> updatedTemperatureOfLiquid, updatedTemperatureOnIsolator;
+    /*!
+     * \brief coefficients of segments (per meter): heat capacity of liquid and wall, heat capacity flow,
+     * axial conductance, conductance between liquid and isolator surface, heat capacity of isolator,
+     * conductance between isolator surface and environment
+     */
+	std::vector<double> heatCapacityOfLiquid, heatCapacityFlow, axialConductance, innerConductance,
+		heatCapacityOfIsolator, outerConductance;
+    /*!
+     * \brief factorization of tridiagonal matrix: lower diagonal, modified upper diagonal, inverse of pivots
+     */
+	std::vector<double> lowerDiagonal, modifiedUpperDiagonal, inverseOfPivot;
+    /*!
+     * \brief temporary values of isolator nodes and right hand side
+     */
+	std::vector<double> isolatorConstant, isolatorFactor, rightHandSide;
+	bool isFactorizationValid;
+	size_t quantityOfFactorizations;
+};
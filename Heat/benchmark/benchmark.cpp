@@ -0,0 +1,155 @@
+#include "FluidLibrary.h"
+#include "HeatTransferSolver.h"
+#include "InputData.h"
+#include "Interpolation.h"
+#include "NaturalConvection.h"
+#include "ThermalProperties.h"
+#ifdef QT_CORE_LIB
+#include "xmlwriter.h"
+#include <QDir>
+#endif
+#include <benchmark/benchmark.h>
+#include <string>
+/*!
+ * \brief directory which stores the properties of fluids
+ */
+const std::string dataDirectory{"fluids_properties/"};
+/*!
+ * \brief returns the properties of fluids loaded once for all benchmarks
+ */
+const FluidLibrary& getFluids(){
+    static const FluidLibrary fluids{dataDirectory};
+    return fluids;
+}
+/*!
+ * \brief returns the table of fluid: 0-air, 1..5 liquids in the order of FluidLibrary
+ */
+const ThermalProperties& getTable(const int &index){
+    return index==0 ? getFluids().air() : getFluids().liquid(index-1);
+}
+/*!
+ * \brief returns the name of file of fluid table
+ */
+std::string getNameOfTable(const int &index){
+    return index==0 ? std::string{"air.txt"} : std::string{FluidLibrary::fileNamesOfLiquids[index-1]};
+}
+/*!
+ * \brief sets the input data of the test case (water, low viscosity, high emissivity)
+ */
+void setTestData(InputData &data){
+    data.innerDiameterOfPipe=0.08;
+    data.thicknessOfPipe=0.004;
+    data.meanVelocityOfLiquid=1;
+    data.meanTemperatureOfLiquid=413;
+    data.thermalConductivityOfIsolator=0.093;
+    data.thicknessOfIsolator=0.03;
+    data.temperatureOfEnvironment=286;
+    data.lengthOfPipe=1;
+    data.setForcedConvectionConstValues(0);
+    data.setEmissivityOfIsolator(2);
+    data.calculateTheRemainingData();
+}
+/*!
+ * \brief Lagrange interpolation for every shipped table, the argument is the index of table
+ */
+void interpolationCalculate(benchmark::State &state){
+    const ThermalProperties &table=getTable(static_cast<int>(state.range(0)));
+    Interpolation interpolation;
+    const double bottom=table.temperature.front();
+    const double step=(table.temperature.back()-bottom)/64;
+    int i=0;
+    for(auto _ : state){
+        double temperature=bottom+step*(i++&63);
+        benchmark::DoNotOptimize(interpolation.calculate(temperature,table.temperature,table.thermalConductivity));
+    }
+    state.SetLabel(getNameOfTable(static_cast<int>(state.range(0)))+", "+
+                   std::to_string(table.temperature.size())+" points");
+}
+BENCHMARK(interpolationCalculate)->DenseRange(0,FluidLibrary::quantityOfLiquids);
+
+void thermalPropertiesValueAt(benchmark::State &state){
+    const ThermalProperties &air=getFluids().air();
+    double temperature=280;
+    for(auto _ : state){
+        benchmark::DoNotOptimize(air.valueAt(temperature,PropertyType::viscosity));
+        temperature=temperature<400 ? temperature+1 : 280;
+    }
+}
+BENCHMARK(thermalPropertiesValueAt);
+
+void naturalConvectionSetValueOfAandC(benchmark::State &state){
+    NaturalConvection naturalTransfer;
+    double product=1e-4;
+    for(auto _ : state){
+        naturalTransfer.setValueOfAandC(product);
+        benchmark::DoNotOptimize(naturalTransfer.C);
+        product=product<1e9 ? product*10 : 1e-4;
+    }
+}
+BENCHMARK(naturalConvectionSetValueOfAandC);
+
+void naturalConvectionGetRegime(benchmark::State &state){
+    double product=1e-4;
+    for(auto _ : state){
+        benchmark::DoNotOptimize(NaturalConvection::getRegime(product));
+        product=product<1e9 ? product*10 : 1e-4;
+    }
+}
+BENCHMARK(naturalConvectionGetRegime);
+
+void getDifferenceOfHeatFlows(benchmark::State &state){
+    InputData data;
+    setTestData(data);
+    HeatTransferSolver solver{data,getFluids().liquid(0),getFluids().air()};
+    double temperatureOnIsolator=300;
+    for(auto _ : state){
+        benchmark::DoNotOptimize(solver.getDifferenceOfHeatFlows(temperatureOnIsolator));
+        temperatureOnIsolator=temperatureOnIsolator<400 ? temperatureOnIsolator+1 : 300;
+    }
+}
+BENCHMARK(getDifferenceOfHeatFlows);
+
+void runTheSolver(benchmark::State &state){
+    InputData data;
+    setTestData(data);
+    for(auto _ : state){
+        HeatTransferSolver solver{data,getFluids().liquid(0),getFluids().air()};
+        solver.runTheSolver();
+        benchmark::DoNotOptimize(solver.getResults()->heatFlow1);
+    }
+}
+BENCHMARK(runTheSolver);
+
+void thermalPropertiesConstruction(benchmark::State &state){
+    const std::string path=dataDirectory+getNameOfTable(static_cast<int>(state.range(0)));
+    for(auto _ : state){
+        ThermalProperties table{path};
+        benchmark::DoNotOptimize(table.temperature.data());
+    }
+    state.SetLabel(getNameOfTable(static_cast<int>(state.range(0))));
+}
+BENCHMARK(thermalPropertiesConstruction)->DenseRange(0,FluidLibrary::quantityOfLiquids);
+
+#ifdef QT_CORE_LIB
+/*!
+ * \brief XmlWriter export of table with the argument quantity of rows (3 cells in row as in the application)
+ */
+void xmlWriterExport(benchmark::State &state){
+    const QString fileName=QDir::temp().filePath("heat-benchmark.xml");
+    for(auto _ : state){
+        XmlWriter xmlTable;
+        for(int64_t i=0;i<state.range(0);++i){
+            xmlTable.addRow();
+            xmlTable.addCellData("temperatura na powierzchni zew. izolacji",XmlDataType::String);
+            xmlTable.addCellData("T3",XmlDataType::String);
+            xmlTable.addCellData(QString::number(313.15+i,'g',10).replace('.',','),XmlDataType::Number);
+        }
+        xmlTable.saveTableDataInFile(fileName);
+    }
+    QFile::remove(fileName);
+    state.SetItemsProcessed(state.iterations()*state.range(0));
+}
+BENCHMARK(xmlWriterExport)->RangeMultiplier(10)->Range(10,100000)->Unit(benchmark::kMicrosecond);
+#endif
+
+BENCHMARK_MAIN();
@@ -0,0 +1,54 @@
+#-------------------------------------------------
+#
+# Microbenchmarks of the solver hot functions (Google Benchmark),
+# run from the HeatTransfer folder so the properties of fluids are found
+#
+#-------------------------------------------------
+
+TARGET = heat-benchmark
+TEMPLATE = app
+
+# Qt is used only by the XmlWriter benchmarks
+QT += core
+greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
+
+CONFIG += console c++11 thread
+CONFIG -= app_bundle
+
+# The solver core reports problems on standard error stream instead of message boxes
+DEFINES += HEAT_NO_GUI
+
+INCLUDEPATH += ..
+
+LIBS += -lbenchmark
+
+SOURCES += \
+        benchmark.cpp \
+    ../FluidLibrary.cpp \
+    ../HeatTransferSolver.cpp \
+    ../NaturalConvection.cpp \
+    ../InputData.cpp \
+    ../LayerStack.cpp \
+    ../Interpolation.cpp \
+    ../OutputData.cpp \
+    ../SolverStatistics.cpp \
+    ../TraceRecorder.cpp \
+    ../ThermalProperties.cpp \
+    ../xmlwriter.cpp
+
+HEADERS += \
+    ../FluidLibrary.h \
+    ../HeatTransferSolver.h \
+    ../HeatTransferEquations.h \
+    ../Power.h \
+    ../Interpolation.h \
+    ../ThermalProperties.h \
+    ../NaturalConvection.h \
+    ../ConvectionCorrelation.h \
+    ../InputData.h \
+    ../LayerStack.h \
+    ../MathConstants.h \
+    ../OutputData.h \
+    ../SolverStatistics.h \
+    ../TraceRecorder.h \
+    ../xmlwriter.h
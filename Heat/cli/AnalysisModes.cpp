@@ -0,0 +1,579 @@
+#include "AnalysisModes.h"
+#include "AxialMarching.h"
+#include "InsulationOptimizer.h"
+#include "InverseSolver.h"
+#include "MonteCarlo.h"
+#include "PipeNetwork.h"
+#include "Sensitivity.h"
+#include "SurrogateModel.h"
+#include "TransientSimulation.h"
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+namespace {
+/*!
+ * \brief names of modes, solve is the batch run of cases
+ */
+const char *const namesOfModes[]={"solve","axial","network","transient","optimize","inverse","montecarlo",
+                                  "sensitivity","surrogate"};
+/*!
+ * \brief names of inputs changed by inverse mode in the order of InverseProblem::FreeInput
+ */
+const char *const namesOfFreeInputs[]={"thicknessOfIsolator","thermalConductivityOfIsolator","emissivityOfIsolator",
+                                      "meanTemperatureOfLiquid","meanVelocityOfLiquid"};
+/*!
+ * \brief reads two numbers separated by ':'
+ * \param text text of pair
+ * \param first the first number
+ * \param second the second number
+ * \throw std::invalid_argument if text is not a pair of numbers
+ */
+void readPair(const std::string &text, double &first, double &second){
+    size_t separator=text.find(':');
+    if(separator==std::string::npos){
+        throw std::invalid_argument("expected two values separated by ':' in "+text);
+    }
+    first=std::stod(text.substr(0,separator));
+    second=std::stod(text.substr(separator+1));
+}
+/*!
+ * \brief names of uncertain inputs of montecarlo mode in the order of MonteCarloSettings::UncertainInput
+ */
+const char *const namesOfUncertainInputs[MonteCarloSettings::quantityOfUncertainInputs]={"innerDiameterOfPipe",
+    "thicknessOfPipe","meanVelocityOfLiquid","meanTemperatureOfLiquid","thermalConductivityOfIsolator",
+    "thicknessOfIsolator","temperatureOfEnvironment","emissivityOfIsolator","lengthOfPipe"};
+/*!
+ * \brief reads the distribution of uncertain input
+ * \param text NAME:TYPE:FIRST:SECOND where TYPE is uniform, normal or triangular
+ * \param settings settings in which the distribution is set
+ * \throw std::invalid_argument if the text is wrong
+ */
+void readDistribution(const std::string &text, MonteCarloSettings &settings){
+    size_t nameEnd=text.find(':');
+    size_t typeEnd=nameEnd==std::string::npos ? nameEnd : text.find(':',nameEnd+1);
+    if(typeEnd==std::string::npos){
+        throw std::invalid_argument("expected NAME:TYPE:FIRST:SECOND in "+text);
+    }
+    std::string name=text.substr(0,nameEnd);
+    std::string type=text.substr(nameEnd+1,typeEnd-nameEnd-1);
+    Distribution distribution{};
+    if(type=="uniform"){
+        distribution.type=Distribution::uniform;
+    }
+    else if(type=="normal"){
+        distribution.type=Distribution::normal;
+    }
+    else if(type=="triangular"){
+        distribution.type=Distribution::triangular;
+    }
+    else{
+        throw std::invalid_argument("unknown distribution "+type);
+    }
+    readPair(text.substr(typeEnd+1),distribution.first,distribution.second);
+    for (int input = 0; input < MonteCarloSettings::quantityOfUncertainInputs; ++input) {
+        if(name==namesOfUncertainInputs[input]){
+            settings.distributions[input]=distribution;
+            return;
+        }
+    }
+    throw std::invalid_argument("unknown uncertain input "+name);
+}
+/*!
+ * \brief reads the axis of surrogate mode NAME:BOTTOM:UPPER:POINTS, NAME is one of BatchRunner::inputNames
+ * \param text text of axis
+ * \return axis
+ * \throw std::invalid_argument if the text is wrong
+ */
+SurrogateAxis readAxis(const std::string &text){
+    size_t nameEnd=text.find(':');
+    size_t intervalEnd=text.rfind(':');
+    if(nameEnd==std::string::npos || intervalEnd==nameEnd){
+        throw std::invalid_argument("expected NAME:BOTTOM:UPPER:POINTS in "+text);
+    }
+    std::string name=text.substr(0,nameEnd);
+    SurrogateAxis axis{};
+    readPair(text.substr(nameEnd+1,intervalEnd-nameEnd-1),axis.bottom,axis.upper);
+    axis.quantityOfPoints=std::stoi(text.substr(intervalEnd+1));
+    for (axis.input = 0; axis.input < BatchRunner::quantityOfInputValues; ++axis.input) {
+        if(name==BatchRunner::inputNames[axis.input]){
+            return axis;
+        }
+    }
+    throw std::invalid_argument("unknown input "+name);
+}
+}
+/*!
+ * \brief returns the value of option
+ * \param argc quantity of arguments
+ * \param argv arguments
+ * \param i index of option, it is moved to the value
+ * \throw std::invalid_argument if value is missing
+ * \return value of option
+ */
+std::string getValueOfOption(int argc, char *argv[], int &i){
+    if(i+1>=argc){
+        throw std::invalid_argument(std::string("missing value of option ")+argv[i]);
+    }
+    return argv[++i];
+}
+/*!
+ * \brief reads the option of analysis modes
+ * \param argc quantity of arguments
+ * \param argv arguments
+ * \param i index of option, it is moved to the last value of option
+ * \param options options of analysis modes
+ * \throw std::invalid_argument if value of option is wrong
+ * \return false if it is not the option of analysis modes
+ */
+bool parseAnalysisOption(int argc, char *argv[], int &i, AnalysisOptions &options){
+    std::string option=argv[i];
+    if(option=="-m" || option=="--mode"){
+        options.mode=getValueOfOption(argc,argv,i);
+        bool isKnown=false;
+        for (const char *name : namesOfModes) {
+            isKnown=isKnown || options.mode==name;
+        }
+        if(!isKnown){
+            throw std::invalid_argument("unknown mode "+options.mode);
+        }
+    }
+    else if(option=="--segments"){
+        long long quantityOfSegments=std::stoll(getValueOfOption(argc,argv,i));
+        if(quantityOfSegments<1){
+            throw std::invalid_argument("quantity of segments has to be positive");
+        }
+        options.quantityOfSegments=static_cast<size_t>(quantityOfSegments);
+    }
+    else if(option=="--time-step"){
+        options.transient.timeStep=std::stod(getValueOfOption(argc,argv,i));
+        if(!(options.transient.timeStep>0)){
+            throw std::invalid_argument("time step has to be positive");
+        }
+    }
+    else if(option=="--simulation-time"){
+        options.transient.simulationTime=std::stod(getValueOfOption(argc,argv,i));
+    }
+    else if(option=="--shutdown"){
+        options.transient.shutdownTime=std::stod(getValueOfOption(argc,argv,i));
+    }
+    else if(option=="--warm-up"){
+        options.transient.initialTemperature=std::stod(getValueOfOption(argc,argv,i));
+        options.transient.isStartedFromSteadyState=false;
+    }
+    else if(option=="--freezing"){
+        options.transient.freezingTemperature=std::stod(getValueOfOption(argc,argv,i));
+    }
+    else if(option=="--material"){
+        IsolatorMaterial material{};
+        readPair(getValueOfOption(argc,argv,i),material.thermalConductivity,material.costPerVolume);
+        options.materials.push_back(material);
+    }
+    else if(option=="--price-of-heat"){
+        options.costs.priceOfHeat=std::stod(getValueOfOption(argc,argv,i));
+    }
+    else if(option=="--hours"){
+        options.costs.operatingHoursPerYear=std::stod(getValueOfOption(argc,argv,i));
+    }
+    else if(option=="--years"){
+        options.costs.yearsOfOperation=std::stod(getValueOfOption(argc,argv,i));
+    }
+    else if(option=="--interest"){
+        options.costs.interestRate=std::stod(getValueOfOption(argc,argv,i));
+    }
+    else if(option=="--thickness-range"){
+        readPair(getValueOfOption(argc,argv,i),options.costs.minimumThickness,options.costs.maximumThickness);
+    }
+    else if(option=="--target-temperature" || option=="--target-heat-flow"){
+        options.inverse.target=option=="--target-temperature" ? InverseProblem::temperatureOnIsolator
+                                                              : InverseProblem::heatFlow1;
+        options.inverse.targetValue=std::stod(getValueOfOption(argc,argv,i));
+        options.isTargetSet=true;
+    }
+    else if(option=="--target-tolerance"){
+        options.inverse.toleranceOfTarget=std::stod(getValueOfOption(argc,argv,i));
+    }
+    else if(option=="--free"){
+        std::string name=getValueOfOption(argc,argv,i);
+        bool isKnown=false;
+        for (int input = 0; input <= InverseProblem::meanVelocityOfLiquid; ++input) {
+            if(name==namesOfFreeInputs[input]){
+                options.inverse.freeInput=static_cast<InverseProblem::FreeInput>(input);
+                isKnown=true;
+            }
+        }
+        if(!isKnown){
+            throw std::invalid_argument("unknown free input "+name);
+        }
+    }
+    else if(option=="--interval"){
+        readPair(getValueOfOption(argc,argv,i),options.inverse.bottomInterval,options.inverse.upperInterval);
+    }
+    else if(option=="--uncertain"){
+        readDistribution(getValueOfOption(argc,argv,i),options.monteCarlo);
+    }
+    else if(option=="--samples"){
+        long long quantityOfSamples=std::stoll(getValueOfOption(argc,argv,i));
+        if(quantityOfSamples<1){
+            throw std::invalid_argument("quantity of samples has to be positive");
+        }
+        options.monteCarlo.quantityOfSamples=static_cast<std::uint64_t>(quantityOfSamples);
+    }
+    else if(option=="--seed"){
+        options.monteCarlo.seed=std::stoull(getValueOfOption(argc,argv,i));
+    }
+    else if(option=="--axis"){
+        options.axes.push_back(readAxis(getValueOfOption(argc,argv,i)));
+    }
+    else if(option=="--surrogate"){
+        options.surrogateFile=getValueOfOption(argc,argv,i);
+    }
+    else if(option=="--error-budget"){
+        options.errorBudget=std::stod(getValueOfOption(argc,argv,i));
+    }
+    else{
+        return false;
+    }
+    return true;
+}
+/*!
+ * \brief displays the usage of analysis modes
+ * \param output stream for text
+ */
+void displayAnalysisUsage(std::ostream &output){
+    output<<"  -m, --mode MODE         solve (default) or analysis which uses every case of input as the pipe:\n"
+            "                          axial - outlet temperature and heat flow of long pipe (axial marching)\n"
+            "                          network - temperatures of branched network, the lines of input are\n"
+            "                          \"source TEMPERATURE\", \"junction\" or \"pipe FROM TO CASE\" where FROM, TO\n"
+            "                          are indexes of junctions in the order of lines and CASE are values of case\n"
+            "                          transient - outlet and minimum temperature of liquid and heat flow over time\n"
+            "                          optimize - thickness and material of isolator of the lowest cost per meter\n"
+            "                          inverse - value of --free input for which the target is reached\n"
+            "                          montecarlo - statistics of results of --uncertain inputs\n"
+            "                          sensitivity - derivatives of every field of results with respect to inputs\n"
+            "                          surrogate - results interpolated from table of --surrogate file or of\n"
+            "                          --axis values around the first case, as csv of solve\n"
+            "  --segments N            quantity of axial segments of pipe (default 100)\n"
+            "  --time-step S           time step of transient mode (default 60 s)\n"
+            "  --simulation-time S     simulated time of transient mode (default 86400 s)\n"
+            "  --shutdown S            time of pump shutdown in transient mode (default never)\n"
+            "  --warm-up T             transient mode starts from liquid and isolator of temperature T\n"
+            "                          instead of steady state\n"
+            "  --freezing T            temperature for which the time to freeze is displayed (default 273.15 K)\n"
+            "  --material K:COST       material of isolator chosen by optimize mode: thermal conductivity\n"
+            "                          and cost per cubic meter, the option can be repeated\n"
+            "  --price-of-heat X       price of lost heat per kWh (default 0.05)\n"
+            "  --hours X               operating hours per year (default 8760)\n"
+            "  --years X               years of operation (default 20)\n"
+            "  --interest X            interest rate of future costs of heat loss (default 0)\n"
+            "  --thickness-range A:B   range of optimized thickness of isolator (default 0:0.5 m)\n"
+            "  --target-temperature X  target temperature on isolator of inverse mode\n"
+            "  --target-heat-flow X    target heat flow of inverse mode\n"
+            "  --target-tolerance X    tolerance of target value (default 0.001)\n"
+            "  --free NAME             input changed by inverse mode: thicknessOfIsolator (default),\n"
+            "                          thermalConductivityOfIsolator, emissivityOfIsolator,\n"
+            "                          meanTemperatureOfLiquid or meanVelocityOfLiquid\n"
+            "  --interval A:B          interval of free input in which the target is searched\n"
+            "  --uncertain NAME:TYPE:A:B  distribution of input of montecarlo mode, NAME as in --free or\n"
+            "                          innerDiameterOfPipe, thicknessOfPipe, temperatureOfEnvironment, lengthOfPipe;\n"
+            "                          TYPE uniform (A:B bottom and upper value), normal (A:B mean and standard\n"
+            "                          deviation) or triangular (A:B bottom and upper value, mode from case),\n"
+            "                          the option can be repeated\n"
+            "  --samples N             quantity of samples of montecarlo mode (default 10000)\n"
+            "  --seed N                seed of random numbers of montecarlo mode (default 0)\n"
+            "  --axis NAME:A:B:N       axis of table of surrogate mode: input NAME as in --uncertain, its range\n"
+            "                          A:B and quantity of points N, the option can be repeated\n"
+            "  --surrogate FILE        file where the table built from --axis is saved, without --axis\n"
+            "                          the table is loaded from it\n"
+            "  --error-budget X        maximum estimated relative error of interpolation (default 0.01),\n"
+            "                          the cases with larger error or outside of table are solved\n";
+}
+namespace {
+/*!
+ * \brief solves every case as the long pipe split into segments (see AxialMarching),
+ * saves the case, outlet temperature of liquid and heat flow of whole pipe as csv
+ */
+void runAxialMode(const FluidLibrary &fluids, const BatchRunner &runner, const AnalysisOptions &options,
+                  const std::vector<BatchCase> &cases, std::ostream &output){
+    output<<"case,outletTemperatureOfLiquid,totalHeatFlow\n";
+    AxialProfile profile{};
+    for (size_t i = 0; i < cases.size(); ++i) {
+        AxialMarching pipe{cases[i].data,fluids.liquid(cases[i].typeOfLiquid),fluids.air()};
+        pipe.march(options.quantityOfSegments,profile,runner.getOptions().tolerance);
+        output<<i<<','<<profile.outletTemperatureOfLiquid<<','<<profile.totalHeatFlow<<'\n';
+    }
+}
+/*!
+ * \brief
+ * simulates every case over time (see TransientSimulation), saves the samples as csv
+ * and displays the time to freeze of cases which reach the freezing temperature
+ */
+void runTransientMode(const FluidLibrary &fluids, const AnalysisOptions &options,
+                      const std::vector<BatchCase> &cases, std::ostream &output){
+    TransientSettings settings=options.transient;
+    settings.quantityOfSegments=options.quantityOfSegments;
+    output<<"case,time,outletTemperatureOfLiquid,minimumTemperatureOfLiquid,heatFlow\n";
+    for (size_t i = 0; i < cases.size(); ++i) {
+        TransientSimulation simulation{cases[i].data,fluids.liquid(cases[i].typeOfLiquid),fluids.air()};
+        TransientResults results=simulation.run(settings);
+        for (const auto &sample : results.samples) {
+            output<<i<<','<<sample.time<<','<<sample.outletTemperatureOfLiquid<<','
+                 <<sample.minimumTemperatureOfLiquid<<','<<sample.heatFlow<<'\n';
+        }
+        if(results.timeToFreeze>=0){
+            std::cerr<<"heat-cli: case "<<i<<" freezes after "<<results.timeToFreeze<<" s\n";
+        }
+    }
+}
+/*!
+ * \brief finds the optimal isolator of every case (see InsulationOptimizer), saves it as csv
+ */
+void runOptimizeMode(const FluidLibrary &fluids, const BatchRunner &runner, const AnalysisOptions &options,
+                     const std::vector<BatchCase> &cases, std::ostream &output){
+    if(options.materials.empty()){
+        throw std::invalid_argument("optimize mode requires --material");
+    }
+    InsulationCosts costs=options.costs;
+    costs.tolerance=runner.getOptions().tolerance;
+    InsulationOptimizer optimizer{fluids,costs};
+    std::vector<InsulationOptimum> optimum=optimizer.optimize(cases,options.materials,
+                                                              runner.getOptions().quantityOfThreads);
+    output<<"case,thicknessOfIsolator,material,heatFlow,capitalCost,costOfHeatLoss,totalCost\n";
+    for (size_t i = 0; i < optimum.size(); ++i) {
+        output<<i<<','<<optimum[i].thicknessOfIsolator<<','<<optimum[i].material<<','<<optimum[i].heatFlow<<','
+             <<optimum[i].capitalCost<<','<<optimum[i].costOfHeatLoss<<','<<optimum[i].totalCost<<'\n';
+    }
+}
+/*!
+ * \brief
+ * finds the value of free input of every case for which the target is reached (see InverseSolver),
+ * saves it with the results as csv, the cases in which the target can not be reached are displayed
+ */
+void runInverseMode(const FluidLibrary &fluids, const BatchRunner &runner, const AnalysisOptions &options,
+                    const std::vector<BatchCase> &cases, std::ostream &output){
+    if(!options.isTargetSet){
+        throw std::invalid_argument("inverse mode requires --target-temperature or --target-heat-flow");
+    }
+    InverseProblem problem=options.inverse;
+    problem.tolerance=runner.getOptions().tolerance;
+    output<<"case,"<<namesOfFreeInputs[problem.freeInput]<<",temperatureOnIsolator,heatFlow1,iterations,status\n";
+    for (size_t i = 0; i < cases.size(); ++i) {
+        InverseSolver inverse{cases[i].data,fluids.liquid(cases[i].typeOfLiquid),fluids.air()};
+        try {
+            InverseResult result=inverse.solve(problem);
+            output<<i<<','<<result.valueOfInput<<','<<result.results.temperatureOnIsolator<<','
+                 <<result.results.heatFlow1<<','<<result.quantityOfIterations<<','<<result.results.status<<'\n';
+        } catch (std::runtime_error &error) {
+            std::cerr<<"heat-cli: case "<<i<<": "<<error.what()<<"\n";
+        }
+    }
+}
+/*!
+ * \brief
+ * propagates the uncertainty of inputs of every case (see MonteCarlo),
+ * saves the statistics of every field of results as csv, the skipped samples are reported on stderr
+ */
+void runMonteCarloMode(const FluidLibrary &fluids, const BatchRunner &runner, const AnalysisOptions &options,
+                       const std::vector<BatchCase> &cases, std::ostream &output){
+    MonteCarloSettings settings=options.monteCarlo;
+    settings.tolerance=runner.getOptions().tolerance;
+    settings.quantityOfThreads=runner.getOptions().quantityOfThreads;
+    output<<"case,field,mean,standardDeviation,minimum,maximum";
+    for (double percentile : settings.percentiles) {
+        output<<",percentile"<<percentile*100;
+    }
+    output<<'\n';
+    MonteCarlo monteCarlo{fluids,settings};
+    for (size_t i = 0; i < cases.size(); ++i) {
+        MonteCarloResults results=monteCarlo.run(cases[i]);
+        if(results.quantityOfSkippedSamples>0){
+            std::cerr<<"heat-cli: case "<<i<<": "<<results.quantityOfSkippedSamples<<" of "<<settings.quantityOfSamples
+                    <<" samples were skipped (no physical inputs drawn, or results not finite, divided by zero or not converged)\n";
+        }
+        for (int field = 0; field < OutputData::quantityOfFields; ++field) {
+            const FieldStatistics &statistics=results.fields[field];
+            output<<i<<','<<OutputData::fieldNames[field]<<','<<statistics.mean<<','<<std::sqrt(statistics.variance)
+                 <<','<<statistics.minimum<<','<<statistics.maximum;
+            for (double percentile : statistics.percentiles) {
+                output<<','<<percentile;
+            }
+            output<<'\n';
+        }
+    }
+}
+/*!
+ * \brief
+ * calculates the derivatives of results of every case (see Sensitivity),
+ * saves the value and the derivatives with respect to every input of every field of results as csv
+ */
+void runSensitivityMode(const FluidLibrary &fluids, const BatchRunner &runner, const std::vector<BatchCase> &cases,
+                        std::ostream &output){
+    output<<"case,field,value";
+    for (const char *name : Sensitivity::inputNames) {
+        output<<','<<name;
+    }
+    output<<'\n';
+    for (size_t i = 0; i < cases.size(); ++i) {
+        Sensitivity sensitivity{fluids.liquid(cases[i].typeOfLiquid),fluids.air(),runner.getOptions().tolerance};
+        SensitivityResults results=sensitivity.calculate(cases[i].data);
+        double value[OutputData::quantityOfFields];
+        results.results.copyValuesTo(value);
+        for (int field = 0; field < OutputData::quantityOfFields; ++field) {
+            output<<i<<','<<OutputData::fieldNames[field]<<','<<value[field];
+            for (double derivative : results.jacobian[field]) {
+                output<<','<<derivative;
+            }
+            output<<'\n';
+        }
+    }
+}
+/*!
+ * \brief
+ * builds the table of surrogate model around the first case or loads it (see SurrogateModel)
+ * and calculates the results of every case from it, saves them as csv of solve
+ */
+void runSurrogateMode(const FluidLibrary &fluids, const BatchRunner &runner, const AnalysisOptions &options,
+                      const std::vector<BatchCase> &cases, std::ostream &output){
+    SurrogateModel surrogate{fluids};
+    if(!options.axes.empty()){
+        if(cases.empty()){
+            throw std::invalid_argument("surrogate mode requires the base case in the first line of input");
+        }
+        surrogate.build(cases[0],options.axes,runner.getOptions().tolerance,runner.getOptions().quantityOfThreads);
+        if(!options.surrogateFile.empty()){
+            std::ofstream file(options.surrogateFile,std::ios::binary);
+            surrogate.save(file);
+            if(!file){
+                throw std::runtime_error("can not write "+options.surrogateFile);
+            }
+        }
+    }
+    else if(!options.surrogateFile.empty()){
+        std::ifstream file(options.surrogateFile,std::ios::binary);
+        if(!file){
+            throw std::runtime_error("can not open "+options.surrogateFile);
+        }
+        surrogate.load(file);
+    }
+    else{
+        throw std::invalid_argument("surrogate mode requires --axis or --surrogate");
+    }
+    std::vector<OutputData> results(cases.size());
+    size_t quantityOfSolvedCases=0;
+    for (size_t i = 0; i < cases.size(); ++i) {
+        bool isSolved=false;
+        results[i]=surrogate.evaluate(cases[i],options.errorBudget,&isSolved);
+        quantityOfSolvedCases+=isSolved ? 1 : 0;
+    }
+    BatchRunner::writeCsvHeader(output);
+    BatchRunner::writeCsvRows(output,results.data(),results.size(),0);
+    std::cerr<<"heat-cli: "<<cases.size()-quantityOfSolvedCases<<" of "<<cases.size()
+            <<" cases interpolated, estimated error "<<surrogate.getErrorEstimate()<<"\n";
+}
+/*!
+ * \brief
+ * solves the network described by input (see displayAnalysisUsage), the pipes are marched in --segments segments,
+ * saves the temperatures and heat flow of every pipe as csv and displays the total heat flow
+ */
+void runNetworkMode(const FluidLibrary &fluids, const BatchRunner &runner, const AnalysisOptions &options,
+                    std::istream &input, std::ostream &output){
+    PipeNetwork network{fluids};
+    std::string lineText;
+    size_t numberOfLine=0;
+    while (std::getline(input,lineText)) {
+        ++numberOfLine;
+        if(!BatchRunner::isCaseInLine(lineText)){
+            continue;
+        }
+        try {
+            std::istringstream line(lineText);
+            std::string type;
+            line>>type;
+            if(type=="source"){
+                double temperature=0;
+                if(!(line>>temperature)){
+                    throw std::invalid_argument("missing temperature of source");
+                }
+                network.addSourceJunction(temperature);
+            }
+            else if(type=="junction"){
+                network.addJunction();
+            }
+            else if(type=="pipe"){
+                long long fromJunction=-1, toJunction=-1;
+                if(!(line>>fromJunction>>toJunction) || fromJunction<0 || toJunction<0){
+                    throw std::invalid_argument("missing junctions of pipe");
+                }
+                std::string caseText;
+                std::getline(line,caseText);
+                BatchCase batchCase=runner.parseCase(caseText);
+                NetworkPipe pipe{batchCase.data,static_cast<size_t>(fromJunction),static_cast<size_t>(toJunction)};
+                pipe.typeOfLiquid=batchCase.typeOfLiquid;
+                pipe.quantityOfSegments=options.quantityOfSegments;
+                network.addPipe(pipe);
+            }
+            else{
+                throw std::invalid_argument("unknown element of network "+type);
+            }
+        } catch (std::invalid_argument &error) {
+            throw std::invalid_argument("line "+std::to_string(numberOfLine)+": "+error.what());
+        }
+    }
+    NetworkResults results=network.solve(runner.getOptions().tolerance,runner.getOptions().quantityOfThreads);
+    output<<"pipe,inletTemperature,outletTemperature,heatFlow\n";
+    for (size_t i = 0; i < results.pipes.size(); ++i) {
+        output<<i<<','<<results.pipes[i].inletTemperature<<','<<results.pipes[i].outletTemperature
+             <<','<<results.pipes[i].heatFlow<<'\n';
+    }
+    std::cerr<<"heat-cli: total heat flow "<<results.totalHeatFlow<<" W, "
+            <<results.quantityOfIterations<<" iterations\n";
+}
+}
+/*!
+ * \brief runs the analysis chosen by mode and saves its results as csv
+ * \param fluids properties of all liquids and air
+ * \param runner runner which reads the cases (the options of batch are used by analysis)
+ * \param options options of analysis modes
+ * \param input stream with cases, one case in line
+ * \param output stream for results
+ * \throw std::invalid_argument if input or options are wrong
+ * \throw std::runtime_error if the analysis failed
+ */
+void runAnalysis(const FluidLibrary &fluids, const BatchRunner &runner, const AnalysisOptions &options,
+                 std::istream &input, std::ostream &output){
+    output.precision(std::numeric_limits<double>::max_digits10);
+    if(options.mode=="network"){
+        runNetworkMode(fluids,runner,options,input,output);
+        output.flush();
+        return;
+    }
+    std::vector<BatchCase> cases=runner.loadCases(input);
+    if(options.mode=="axial"){
+        runAxialMode(fluids,runner,options,cases,output);
+    }
+    else if(options.mode=="transient"){
+        runTransientMode(fluids,options,cases,output);
+    }
+    else if(options.mode=="optimize"){
+        runOptimizeMode(fluids,runner,options,cases,output);
+    }
+    else if(options.mode=="inverse"){
+        runInverseMode(fluids,runner,options,cases,output);
+    }
+    else if(options.mode=="montecarlo"){
+        runMonteCarloMode(fluids,runner,options,cases,output);
+    }
+    else if(options.mode=="sensitivity"){
+        runSensitivityMode(fluids,runner,cases,output);
+    }
+    else if(options.mode=="surrogate"){
+        runSurrogateMode(fluids,runner,options,cases,output);
+    }
+    else{
+        throw std::invalid_argument("unknown mode "+options.mode);
+    }
+    output.flush();
+}
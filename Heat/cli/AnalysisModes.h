@@ -0,0 +1,70 @@
+#pragma once
+#include "BatchRunner.h"
+#include "FluidLibrary.h"
+#include "InsulationOptimizer.h"
+#include "InverseSolver.h"
+#include "MonteCarlo.h"
+#include "SurrogateModel.h"
+#include "TransientSimulation.h"
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+/*!
+ * \brief The AnalysisOptions class
+ * stores the command line options of analysis modes, in which the cases of input
+ * are not only solved but used as the pipes of other analysis (see runAnalysis)
+ */
+class AnalysisOptions
+{
+public:
+    /*!
+     * \brief name of mode, "solve" means the batch run of cases
+     */
+    std::string mode{"solve"};
+    /*!
+     * \brief quantity of axial segments of pipe
+     */
+    size_t quantityOfSegments{100};
+    /*!
+     * \brief settings of transient mode, the quantity of segments is taken from quantityOfSegments
+     */
+    TransientSettings transient;
+    /*!
+     * \brief economic data of optimize mode, the tolerance is taken from the options of batch
+     */
+    InsulationCosts costs;
+    /*!
+     * \brief materials of isolator chosen by optimize mode
+     */
+    std::vector<IsolatorMaterial> materials;
+    /*!
+     * \brief problem of inverse mode, the tolerance is taken from the options of batch
+     */
+    InverseProblem inverse;
+    /*!
+     * \brief true if the target value of inverse mode is set
+     */
+    bool isTargetSet{false};
+    /*!
+     * \brief settings of montecarlo mode, the tolerance and threads are taken from the options of batch
+     */
+    MonteCarloSettings monteCarlo;
+    /*!
+     * \brief axes of table built by surrogate mode, if it is empty the table is loaded from surrogateFile
+     */
+    std::vector<SurrogateAxis> axes;
+    /*!
+     * \brief file in which the table of surrogate mode is saved or from which it is loaded
+     */
+    std::string surrogateFile;
+    /*!
+     * \brief maximum relative error of surrogate mode for which the results are interpolated
+     */
+    double errorBudget{0.01};
+};
+std::string getValueOfOption(int argc, char *argv[], int &i);
+bool parseAnalysisOption(int argc, char *argv[], int &i, AnalysisOptions &options);
+void displayAnalysisUsage(std::ostream &output);
+void runAnalysis(const FluidLibrary &fluids, const BatchRunner &runner, const AnalysisOptions &options,
+                 std::istream &input, std::ostream &output);
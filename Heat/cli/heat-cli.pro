@@ -0,0 +1,97 @@
+#-------------------------------------------------
+#
+# Command line version of the heat transfer solver,
+# it uses the solver core without Qt
+#
+#-------------------------------------------------
+
+TARGET = heat-cli
+TEMPLATE = app
+
+CONFIG += console c++11 thread
+CONFIG -= app_bundle qt
+
+# The solver core reports problems on standard error stream instead of message boxes
+DEFINES += HEAT_NO_GUI
+# Counters and timers of solver (--statistics option), uncomment to enable
+#DEFINES += HEAT_INSTRUMENTATION
+
+INCLUDEPATH += ..
+
+SOURCES += \
+        main.cpp \
+        AnalysisModes.cpp \
+    ../AxialMarching.cpp \
+    ../PipeNetwork.cpp \
+    ../TransientSimulation.cpp \
+    ../InsulationOptimizer.cpp \
+    ../InverseSolver.cpp \
+    ../MonteCarlo.cpp \
+    ../Sensitivity.cpp \
+    ../SurrogateModel.cpp \
+    ../BatchRunner.cpp \
+    ../BatchPipeline.cpp \
+    ../MixedPrecisionSolver.cpp \
+    ../ScratchArena.cpp \
+    ../FluidLibrary.cpp \
+    ../HeatTransferSolver.cpp \
+    ../NaturalConvection.cpp \
+    ../InputData.cpp \
+    ../LayerStack.cpp \
+    ../Interpolation.cpp \
+    ../OutputData.cpp \
+    ../SolverStatistics.cpp \
+    ../TraceRecorder.cpp \
+    ../ThermalProperties.cpp
+
+HEADERS += \
+        AnalysisModes.h \
+    ../AxialMarching.h \
+    ../PipeNetwork.h \
+    ../TransientSimulation.h \
+    ../InsulationOptimizer.h \
+    ../InverseSolver.h \
+    ../MonteCarlo.h \
+    ../Sensitivity.h \
+    ../SurrogateModel.h \
+    ../BatchRunner.h \
+    ../BatchPipeline.h \
+    ../MixedPrecisionSolver.h \
+    ../ScratchArena.h \
+    ../HeatTransferModel.h \
+    ../Dual.h \
+    ../FluidLibrary.h \
+    ../HeatTransferSolver.h \
+    ../HeatTransferEquations.h \
+    ../Power.h \
+    ../Interpolation.h \
+    ../ThermalProperties.h \
+    ../NaturalConvection.h \
+    ../ConvectionCorrelation.h \
+    ../InputData.h \
+    ../LayerStack.h \
+    ../MathConstants.h \
+    ../OutputData.h \
+    ../SolverStatistics.h \
+    ../TraceRecorder.h
+
+# Daemon mode uses POSIX sockets, checkpoints, worker processes and stream of results
+# use POSIX memory-mapped files, fork and shared memory
+unix {
+    DEFINES += HEAT_DAEMON HEAT_CHECKPOINT
+    SOURCES += ../SolverDaemon.cpp \
+        ../ResultCache.cpp \
+        ../Checkpoint.cpp \
+        ../ResultRing.cpp \
+        ../ShardedRunner.cpp
+    HEADERS += ../SolverDaemon.h \
+        ../ResultCache.h \
+        ../Checkpoint.h \
+        ../ResultRing.h \
+        ../ShardedRunner.h
+    linux: LIBS += -lrt
+}
+
+# Default rules for deployment.
+unix:!android: target.path = /opt/Heat/bin
+!isEmpty(target.path): INSTALLS += target
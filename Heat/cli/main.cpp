@@ -0,0 +1,621 @@
+#include "BatchRunner.h"
+#include "BatchPipeline.h"
+#include "AnalysisModes.h"
+#include "FluidLibrary.h"
+#include "TraceRecorder.h"
+#include "MixedPrecisionSolver.h"
+#ifdef HEAT_DAEMON
+#include "SolverDaemon.h"
+#endif
+#ifdef HEAT_CHECKPOINT
+#include "Checkpoint.h"
+#include "ResultRing.h"
+#include "ShardedRunner.h"
+#endif
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <chrono>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+/*!
+ * \brief The CommandLineOptions class
+ * stores the options given in command line
+ */
+class CommandLineOptions
+{
+public:
+    /*!
+     * \brief path of file with cases, "-" means standard input
+     */
+    std::string inputPath{"-"};
+    /*!
+     * \brief path of file for results, "-" means standard output
+     */
+    std::string outputPath{"-"};
+    /*!
+     * \brief directory which stores the properties of fluids
+     */
+    std::string dataDirectory{"fluids_properties/"};
+    /*!
+     * \brief address on which the daemon listens, empty if cases are read from input
+     */
+    std::string daemonAddress{};
+    /*!
+     * \brief path of file for statistics of solver as JSON, empty if not saved
+     */
+    std::string statisticsPath{};
+    /*!
+     * \brief path of Chrome trace file, empty if events are not recorded
+     */
+    std::string tracePath{};
+    /*!
+     * \brief path of checkpoint file, empty if the run is not checkpointed
+     */
+    std::string checkpointPath{};
+    /*!
+     * \brief true if the run is continued from the checkpoint file
+     */
+    bool isResumed{false};
+    /*!
+     * \brief quantity of worker processes, 1 if the cases are solved by threads of this process
+     */
+    int quantityOfProcesses{1};
+    /*!
+     * \brief name of shared memory into which the results are published while solving, empty if not published
+     */
+    std::string streamName{};
+    /*!
+     * \brief quantity of records in shared memory of stream
+     */
+    std::uint64_t streamCapacity{65536};
+    /*!
+     * \brief policy of stream when the slowest consumer did not read the oldest record
+     */
+    std::string streamPolicy{"overwrite"};
+    /*!
+     * \brief name of shared memory which records are displayed as csv, empty if the cases are solved
+     */
+    std::string subscribedStream{};
+    /*!
+     * \brief true if the results of mixed precision are compared with double precision
+     */
+    bool isPrecisionValidated{false};
+    /*!
+     * \brief true if results are saved in binary format otherwise as csv
+     */
+    bool isBinaryFormat{false};
+    /*!
+     * \brief options of the batch run
+     */
+    BatchOptions batch;
+    /*!
+     * \brief options of analysis modes
+     */
+    AnalysisOptions analysis;
+};
+/*!
+ * \brief displays the usage of program
+ * \param output stream for text
+ */
+void displayUsage(std::ostream &output){
+    output<<"Usage: heat-cli [options] [input file]\n"
+#ifdef HEAT_DAEMON
+            "       heat-cli [options] --daemon ADDRESS\n"
+#endif
+            "Solves the heat transfer cases, one case in line of input file (standard input if not given or \"-\").\n"
+            "Values in line: inner diameter of pipe, thickness of pipe, mean velocity of liquid,\n"
+            "mean temperature of liquid, type of liquid, type of forced convection, thermal conductivity\n"
+            "of isolator, thickness of isolator, temperature of environment, type of emissivity, length of pipe,\n"
+            "optionally followed by pairs of thickness and thermal conductivity of layers (pipe wall first).\n"
+            "\n"
+            "Options:\n"
+            "  -o, --output FILE       file for results (default standard output)\n"
+            "  -f, --format FORMAT     csv or binary (default csv)\n"
+            "  --fluid N               type of liquid for all cases: 0-water, 1-engine oil, 2-glycerin,\n"
+            "                          3-isobutane, 4-methanol\n"
+            "  --correlation N         forced convection for all cases: 0-low viscosity, 1-high viscosity,\n"
+            "                          2-perpendicular flow, 3-cooled liquid of low viscosity\n"
+            "  --natural N             natural convection for all cases: 0-simplified (default), 1-Churchill-Chu\n"
+            "  --tolerance X           tolerance of solver (default 0.001)\n"
+            "  --precision P           double or mixed: single precision properties and heat flows,\n"
+            "                          for screening studies (default double)\n"
+            "  --validate-precision    solves the cases also in double precision and displays\n"
+            "                          the maximum deviation of mixed precision\n"
+            "  -j, --threads N         quantity of threads (default 1)\n"
+            "  --data-dir DIR          directory with properties of fluids (default fluids_properties/)\n"
+            "  --trace FILE            records the timeline of run as Chrome/Perfetto trace JSON\n"
+#ifdef HEAT_CHECKPOINT
+            "  --checkpoint FILE       writes the results into memory-mapped FILE and commits the progress\n"
+            "                          periodically, so the stopped run can be resumed\n"
+            "  --resume                continues the run from --checkpoint FILE, the cases and options\n"
+            "                          have to be the same, the committed cases are not solved again\n"
+            "  -p, --processes N       quantity of worker processes (default 1), the workers write the results\n"
+            "                          into shared memory (or --checkpoint FILE), the chunk of crashed worker\n"
+            "                          is solved again\n"
+            "  --stream NAME           publishes the results into POSIX shared memory NAME while solving,\n"
+            "                          the consumers read them with --subscribe NAME\n"
+            "  --stream-capacity N     quantity of results kept in shared memory (default 65536)\n"
+            "  --stream-policy P       when the slowest consumer did not read the oldest result:\n"
+            "                          block (wait for consumers), drop (skip the new result)\n"
+            "                          or overwrite (default, the consumer loses the oldest result)\n"
+            "  --subscribe NAME        displays the results published into NAME as csv until the run ends\n"
+            "                          (it waits up to 60 s for the run to create NAME)\n"
+#endif
+#ifdef HEAT_INSTRUMENTATION
+            "  --statistics FILE       saves the counters and timers of solver as JSON\n"
+#endif
+#ifdef HEAT_DAEMON
+            "  --daemon ADDRESS        keeps the properties loaded and solves the cases sent to Unix domain\n"
+            "                          socket ADDRESS or to localhost TCP port (ADDRESS tcp:PORT) as\n"
+            "                          line-delimited JSON or length-prefixed binary messages\n"
+            "  --cache-size MB         memory for results of repeated cases in daemon mode (default 0, no cache)\n"
+#endif
+            ;
+    displayAnalysisUsage(output);
+    output<<"  -h, --help              displays this text\n";
+}
+/*!
+ * \brief reads the command line options
+ * \param argc quantity of arguments
+ * \param argv arguments
+ * \throw std::invalid_argument if option is unknown or its value is wrong
+ * \return command line options
+ */
+CommandLineOptions parseCommandLine(int argc, char *argv[]){
+    CommandLineOptions options{};
+    bool isInputSet=false;
+    for (int i = 1; i < argc; ++i) {
+        std::string option=argv[i];
+        if(parseAnalysisOption(argc,argv,i,options.analysis)){
+            continue;
+        }
+        if(option=="-o" || option=="--output"){
+            options.outputPath=getValueOfOption(argc,argv,i);
+        }
+        else if(option=="-f" || option=="--format"){
+            std::string format=getValueOfOption(argc,argv,i);
+            if(format=="csv"){
+                options.isBinaryFormat=false;
+            }
+            else if(format=="binary"){
+                options.isBinaryFormat=true;
+            }
+            else{
+                throw std::invalid_argument("unknown format "+format);
+            }
+        }
+        else if(option=="--fluid"){
+            options.batch.typeOfLiquid=std::stoi(getValueOfOption(argc,argv,i));
+        }
+        else if(option=="--correlation"){
+            options.batch.typeOfForcedConvection=std::stoi(getValueOfOption(argc,argv,i));
+        }
+        else if(option=="--precision"){
+            std::string precision=getValueOfOption(argc,argv,i);
+            if(precision=="double"){
+                options.batch.isMixedPrecision=false;
+            }
+            else if(precision=="mixed"){
+                options.batch.isMixedPrecision=true;
+            }
+            else{
+                throw std::invalid_argument("unknown precision "+precision);
+            }
+        }
+        else if(option=="--validate-precision"){
+            options.isPrecisionValidated=true;
+        }
+        else if(option=="--natural"){
+            options.batch.typeOfNaturalConvection=std::stoi(getValueOfOption(argc,argv,i));
+        }
+        else if(option=="--tolerance"){
+            options.batch.tolerance=std::stod(getValueOfOption(argc,argv,i));
+        }
+        else if(option=="-j" || option=="--threads"){
+            int quantityOfThreads=std::stoi(getValueOfOption(argc,argv,i));
+            if(quantityOfThreads<1){
+                throw std::invalid_argument("quantity of threads has to be positive");
+            }
+            options.batch.quantityOfThreads=static_cast<unsigned int>(quantityOfThreads);
+        }
+        else if(option=="--data-dir"){
+            options.dataDirectory=getValueOfOption(argc,argv,i);
+            if(!options.dataDirectory.empty() && options.dataDirectory.back()!='/'){
+                options.dataDirectory+='/';
+            }
+        }
+        else if(option=="--trace"){
+            options.tracePath=getValueOfOption(argc,argv,i);
+        }
+#ifdef HEAT_CHECKPOINT
+        else if(option=="--checkpoint"){
+            options.checkpointPath=getValueOfOption(argc,argv,i);
+        }
+        else if(option=="--resume"){
+            options.isResumed=true;
+        }
+        else if(option=="--stream"){
+            options.streamName=getValueOfOption(argc,argv,i);
+        }
+        else if(option=="--stream-capacity"){
+            long long capacity=std::stoll(getValueOfOption(argc,argv,i));
+            if(capacity<1){
+                throw std::invalid_argument("capacity of stream has to be positive");
+            }
+            options.streamCapacity=static_cast<std::uint64_t>(capacity);
+        }
+        else if(option=="--stream-policy"){
+            options.streamPolicy=getValueOfOption(argc,argv,i);
+            ResultRing::getPolicy(options.streamPolicy);
+        }
+        else if(option=="--subscribe"){
+            options.subscribedStream=getValueOfOption(argc,argv,i);
+        }
+        else if(option=="-p" || option=="--processes"){
+            options.quantityOfProcesses=std::stoi(getValueOfOption(argc,argv,i));
+            if(options.quantityOfProcesses<1){
+                throw std::invalid_argument("quantity of processes has to be positive");
+            }
+        }
+#endif
+#ifdef HEAT_INSTRUMENTATION
+        else if(option=="--statistics"){
+            options.statisticsPath=getValueOfOption(argc,argv,i);
+        }
+#endif
+#ifdef HEAT_DAEMON
+        else if(option=="--daemon"){
+            options.daemonAddress=getValueOfOption(argc,argv,i);
+        }
+        else if(option=="--cache-size"){
+            double size=std::stod(getValueOfOption(argc,argv,i));
+            if(size<0){
+                throw std::invalid_argument("cache size can not be negative");
+            }
+            options.batch.cacheMemoryLimit=static_cast<size_t>(size*1024*1024);
+        }
+#endif
+        else if(option.size()>1 && option[0]=='-' && option!="-"){
+            throw std::invalid_argument("unknown option "+option);
+        }
+        else if(!isInputSet){
+            options.inputPath=option;
+            isInputSet=true;
+        }
+        else{
+            throw std::invalid_argument("too many input files");
+        }
+    }
+    if(options.isResumed && options.checkpointPath.empty()){
+        throw std::invalid_argument("--resume requires --checkpoint");
+    }
+    if(options.isPrecisionValidated && !options.batch.isMixedPrecision){
+        throw std::invalid_argument("--validate-precision requires --precision mixed");
+    }
+    if(options.analysis.mode!="solve"){
+        if(options.isBinaryFormat){
+            throw std::invalid_argument("mode "+options.analysis.mode+" saves the results only as csv");
+        }
+        if(!options.checkpointPath.empty() || options.quantityOfProcesses>1 || !options.streamName.empty()
+                || !options.daemonAddress.empty()){
+            throw std::invalid_argument("--checkpoint, --processes, --stream and --daemon are used only in solve mode");
+        }
+    }
+    if(options.batch.typeOfLiquid>=FluidLibrary::quantityOfLiquids){
+        throw std::invalid_argument("unknown type of liquid");
+    }
+    if(options.batch.typeOfForcedConvection>=InputData::quantityOfForcedConvectionTypes){
+        throw std::invalid_argument("unknown type of forced convection");
+    }
+    if(options.batch.typeOfNaturalConvection<0
+            || options.batch.typeOfNaturalConvection>=InputData::quantityOfNaturalConvectionTypes){
+        throw std::invalid_argument("unknown type of natural convection");
+    }
+    return options;
+}
+#ifdef HEAT_CHECKPOINT
+/*!
+ * \brief
+ * displays the results published into stream as csv (case, values, status) until the producer closes it,
+ * the subscriber may be started before the producer
+ * \param name name of stream
+ * \throw std::runtime_error if the stream is not created in 60 s or it can not be opened
+ */
+void displayStream(const std::string &name){
+    ResultRingReader reader{name,std::chrono::seconds(60)};
+    std::cout<<"case";
+    for (int i = 0; i < OutputData::quantityOfFields; ++i) {
+        std::cout<<','<<OutputData::fieldNames[i];
+    }
+    std::cout<<",status\n";
+    std::cout.precision(std::numeric_limits<double>::max_digits10);
+    StreamRecord record{};
+    while (!reader.isFinished()) {
+        if(!reader.read(record)){
+            std::cout.flush();
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            continue;
+        }
+        std::cout<<record.caseId;
+        for (int i = 0; i < OutputData::quantityOfFields; ++i) {
+            std::cout<<','<<record.result.value[i];
+        }
+        std::cout<<','<<record.result.status<<'\n';
+    }
+    std::cout.flush();
+    if(reader.getQuantityOfLostRecords()>0){
+        std::cerr<<"heat-cli: "<<reader.getQuantityOfLostRecords()<<" results were overwritten before they were read\n";
+    }
+}
+#endif
+/*!
+ * \brief displays the quantity of suspect cases and the note about extrapolated cases if there are any
+ * \param summary summary of status of results
+ */
+void displayStatusSummary(const BatchStatusSummary &summary){
+    if(summary.quantityOfSuspectCases>0){
+        std::cerr<<"heat-cli: "<<summary.toText()<<"\n";
+    }
+    if(summary.getQuantityOfExtrapolatedCases()>0){
+        std::cerr<<"heat-cli: note: "<<summary.toNoteText()<<"\n";
+    }
+}
+/*!
+ * \brief saves the counters and timers of solver as JSON if the path is set
+ * \param options command line options
+ * \param statistics statistics of solver
+ */
+void saveStatistics(const CommandLineOptions &options, const SolverStatistics &statistics){
+    if(options.statisticsPath.empty()){
+        return;
+    }
+    std::ofstream statisticsFile(options.statisticsPath);
+    statisticsFile<<statistics.toJson()<<"\n";
+    if(!statisticsFile){
+        std::cerr<<"heat-cli: couldn't save statistics in "<<options.statisticsPath<<"\n";
+    }
+}
+/*!
+ * \brief
+ * reads, solves and saves the cases concurrently in chunks (see BatchPipeline),
+ * used when the results do not have to be kept in memory
+ * \param runner runner of cases
+ * \param options command line options
+ * \return exit code of program
+ */
+int runPipeline(const BatchRunner &runner, const CommandLineOptions &options){
+    std::ifstream inputFile;
+    if(options.inputPath!="-"){
+        inputFile.open(options.inputPath);
+        if(!inputFile.is_open()){
+            std::cerr<<"heat-cli: couldn't open file "<<options.inputPath<<"\n";
+            return EXIT_FAILURE;
+        }
+    }
+    std::ofstream outputFile;
+    if(options.outputPath!="-"){
+        outputFile.open(options.outputPath,std::ios::out | std::ios::binary);
+        if(!outputFile.is_open()){
+            std::cerr<<"heat-cli: couldn't open file "<<options.outputPath<<"\n";
+            return EXIT_FAILURE;
+        }
+    }
+    std::istream &input=options.inputPath=="-" ? std::cin : inputFile;
+    std::ostream &output=options.outputPath=="-" ? std::cout : outputFile;
+    SolverStatistics statistics{};
+    BatchPipeline pipeline{runner};
+    BatchStatusSummary summary{};
+    try {
+        summary=pipeline.run(input,output,options.isBinaryFormat,&statistics);
+    } catch (std::invalid_argument &error) {
+        std::cerr<<"heat-cli: "<<options.inputPath<<": "<<error.what()<<"\n";
+        return EXIT_FAILURE;
+    }
+    displayStatusSummary(summary);
+    saveStatistics(options,statistics);
+    if(options.outputPath!="-"){
+        outputFile.close();
+    }
+    return output ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+/*!
+ * \brief runs the analysis mode (see runAnalysis) on the cases of input
+ * \param fluids properties of all liquids and air
+ * \param runner runner of cases
+ * \param options command line options
+ * \return exit code of program
+ */
+int runAnalysisMode(const FluidLibrary &fluids, const BatchRunner &runner, const CommandLineOptions &options){
+    std::ifstream inputFile;
+    if(options.inputPath!="-"){
+        inputFile.open(options.inputPath);
+        if(!inputFile.is_open()){
+            std::cerr<<"heat-cli: couldn't open file "<<options.inputPath<<"\n";
+            return EXIT_FAILURE;
+        }
+    }
+    std::ofstream outputFile;
+    if(options.outputPath!="-"){
+        outputFile.open(options.outputPath);
+        if(!outputFile.is_open()){
+            std::cerr<<"heat-cli: couldn't open file "<<options.outputPath<<"\n";
+            return EXIT_FAILURE;
+        }
+    }
+    std::istream &input=options.inputPath=="-" ? std::cin : inputFile;
+    std::ostream &output=options.outputPath=="-" ? std::cout : outputFile;
+    try {
+        runAnalysis(fluids,runner,options.analysis,input,output);
+    } catch (std::invalid_argument &error) {
+        std::cerr<<"heat-cli: "<<options.inputPath<<": "<<error.what()<<"\n";
+        return EXIT_FAILURE;
+    } catch (std::runtime_error &error) {
+        std::cerr<<"heat-cli: "<<error.what()<<"\n";
+        return EXIT_FAILURE;
+    }
+    if(options.outputPath!="-"){
+        outputFile.close();
+    }
+    return output ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+/*!
+ * \brief saves results in chosen format
+ * \param output stream for results
+ * \param options command line options
+ * \param results results of cases
+ */
+void saveResults(std::ostream &output, const CommandLineOptions &options, const std::vector<OutputData> &results){
+    if(options.isBinaryFormat){
+        BatchRunner::saveResultsAsBinary(output,results);
+    }
+    else{
+        BatchRunner::saveResultsAsCsv(output,results);
+    }
+}
+int main(int argc, char *argv[])
+{
+    for (int i = 1; i < argc; ++i) {
+        if(std::strcmp(argv[i],"-h")==0 || std::strcmp(argv[i],"--help")==0){
+            displayUsage(std::cout);
+            return EXIT_SUCCESS;
+        }
+    }
+    CommandLineOptions options{};
+    try {
+        options=parseCommandLine(argc,argv);
+    } catch (std::exception &error) {
+        std::cerr<<"heat-cli: "<<error.what()<<"\n";
+        displayUsage(std::cerr);
+        return EXIT_FAILURE;
+    }
+#ifdef HEAT_CHECKPOINT
+    if(!options.subscribedStream.empty()){
+        try {
+            displayStream(options.subscribedStream);
+        } catch (std::runtime_error &error) {
+            std::cerr<<"heat-cli: "<<error.what()<<"\n";
+            return EXIT_FAILURE;
+        }
+        return std::cout ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+#endif
+    if(!options.tracePath.empty()){
+        TraceRecorder::start(options.tracePath);
+    }
+    FluidLibrary fluids{options.dataDirectory};
+#ifdef HEAT_DAEMON
+    if(!options.daemonAddress.empty()){
+        try {
+            SolverDaemon daemon{fluids,options.batch};
+            daemon.run(options.daemonAddress);
+            CacheStatistics statistics=daemon.getCacheStatistics();
+            if(statistics.hits+statistics.misses>0){
+                std::cerr<<"heat-cli: cache hits "<<statistics.hits<<", misses "<<statistics.misses
+                        <<", evictions "<<statistics.evictions<<"\n";
+            }
+        } catch (std::runtime_error &error) {
+            std::cerr<<"heat-cli: "<<error.what()<<"\n";
+            return EXIT_FAILURE;
+        }
+        return EXIT_SUCCESS;
+    }
+#endif
+    BatchRunner runner{fluids,options.batch};
+    if(options.analysis.mode!="solve"){
+        return runAnalysisMode(fluids,runner,options);
+    }
+    bool isPipelined=!options.isPrecisionValidated
+            && !(options.isBinaryFormat && options.outputPath=="-");
+#ifdef HEAT_CHECKPOINT
+    isPipelined=isPipelined && options.checkpointPath.empty() && options.quantityOfProcesses==1
+            && options.streamName.empty();
+#endif
+    if(isPipelined){
+        return runPipeline(runner,options);
+    }
+    std::vector<BatchCase> cases;
+    try {
+        if(options.inputPath=="-"){
+            cases=runner.loadCases(std::cin);
+        }
+        else{
+            std::ifstream input(options.inputPath);
+            if(!input.is_open()){
+                std::cerr<<"heat-cli: couldn't open file "<<options.inputPath<<"\n";
+                return EXIT_FAILURE;
+            }
+            cases=runner.loadCases(input);
+        }
+    } catch (std::invalid_argument &error) {
+        std::cerr<<"heat-cli: "<<options.inputPath<<": "<<error.what()<<"\n";
+        return EXIT_FAILURE;
+    }
+    SolverStatistics statistics{};
+    std::vector<OutputData> results;
+#ifdef HEAT_CHECKPOINT
+    if(!options.checkpointPath.empty() || options.quantityOfProcesses>1 || !options.streamName.empty()){
+        try {
+            CheckpointFile checkpoint{options.checkpointPath,cases.size(),
+                        CheckpointFile::getFingerprint(cases,options.batch),options.isResumed};
+            std::unique_ptr<ResultRing> stream{};
+            if(!options.streamName.empty()){
+                stream.reset(new ResultRing{options.streamName,options.streamCapacity,
+                                            ResultRing::getPolicy(options.streamPolicy)});
+                checkpoint.stream=stream.get();
+            }
+            if(options.isResumed){
+                std::cerr<<"heat-cli: resumed after "<<checkpoint.getQuantityOfCommittedCases()<<" of "
+                        <<cases.size()<<" cases\n";
+            }
+            if(options.quantityOfProcesses>1){
+                ShardedRunner sharded{runner,checkpoint,options.quantityOfProcesses};
+                results=sharded.solve(cases);
+                if(sharded.getQuantityOfRepeatedChunks()>0){
+                    std::cerr<<"heat-cli: "<<sharded.getQuantityOfRepeatedChunks()
+                            <<" chunks solved again after failure of worker\n";
+                }
+            }
+            else{
+                results=checkpoint.solve(runner,cases,&statistics);
+            }
+            if(stream && stream->getQuantityOfDroppedRecords()>0){
+                std::cerr<<"heat-cli: "<<stream->getQuantityOfDroppedRecords()<<" results were not published, stream was full\n";
+            }
+        } catch (std::runtime_error &error) {
+            std::cerr<<"heat-cli: "<<error.what()<<"\n";
+            return EXIT_FAILURE;
+        }
+    }
+    else{
+        results=runner.solve(cases,&statistics);
+    }
+#else
+    results=runner.solve(cases,&statistics);
+#endif
+    BatchStatusSummary summary=BatchRunner::getStatusSummary(results);
+    displayStatusSummary(summary);
+    if(options.isPrecisionValidated){
+        BatchOptions referenceOptions=options.batch;
+        referenceOptions.isMixedPrecision=false;
+        BatchRunner reference{fluids,referenceOptions};
+        std::cerr<<"heat-cli: "<<PrecisionDeviation::compare(reference.solve(cases),results).toText();
+    }
+    saveStatistics(options,statistics);
+    if(options.outputPath=="-"){
+        saveResults(std::cout,options,results);
+        std::cout.flush();
+        return std::cout ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+    std::ofstream output(options.outputPath,std::ios::out | std::ios::binary);
+    if(!output.is_open()){
+        std::cerr<<"heat-cli: couldn't open file "<<options.outputPath<<"\n";
+        return EXIT_FAILURE;
+    }
+    saveResults(output,options,results);
+    output.close();
+    return output ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -4,8 +4,15 @@
 #include <QDesktopWidget>
 #include <QScreen>
 #include <QWindow>
+#include <cstdlib>
+#include "TraceRecorder.h"
 int main(int argc, char *argv[])
 {
+    //trace file of the run is written at exit if HEAT_TRACE is set to its path
+    const char *tracePath=std::getenv("HEAT_TRACE");
+    if(tracePath!=nullptr && *tracePath!='\0'){
+        TraceRecorder::start(tracePath);
+    }
     QApplication a(argc, argv);
     MainWindow w;
     QScreen *screen = QGuiApplication::screens().first();
@@ -35,20 +35,35 @@ void MainWindow::setPictureOfTask(){
 }
 /*!
  * \brief
- * loads the data inputted by user and starts the solver of heat transfer;
+ * loads the data inputted by user and starts the solver of heat transfer,
+ * the warning dialog box is shown if the results may be incorrect (not a number, infinity,
+ * division by zero or not converged), the extrapolation of properties is shown in status bar;
  * function triggered when user click the "solve task" button
  */
 void MainWindow::on_pushButtonSolveTask_clicked()
 {
+    HEAT_TRACE_SCOPE("solve task", "gui");
     setInputData();
     setEmissivityOfIsolator();
     setForcedConvectionsConstValues();
     //liquid=new ThermalProperties{filePathLiquids[boxTypeOfLiquid->currentIndex()]};
     int indexOfLiquid=boxTypeOfLiquid->currentIndex();
-    solveTask=new HeatTransferSolver{dataFromUser,liquid[indexOfLiquid]};
-    solveTask->runTheSolver();
-    setResultsInLabels(solveTask->getResults());
-    delete solveTask;
+    HeatTransferSolver solveTask{dataFromUser,liquid[indexOfLiquid],*air};
+    solveTask.runTheSolver();
+    setResultsInLabels(solveTask.getResults());
+    unsigned int status=solveTask.getResults()->status;
+    //extrapolation is frequent and usually harmless, so it is only noted in status bar
+    unsigned int statusOfErrors=status & ~static_cast<unsigned int>(OutputData::statusExtrapolation);
+    if(statusOfErrors!=0){
+        QMessageBox::warning(this,"Warning from solver.","Results may be incorrect: "+
+                             QString::fromStdString(OutputData::getStatusDescription(statusOfErrors))+".");
+    }
+    if(status & OutputData::statusExtrapolation){
+        statusBar()->showMessage("Note: properties of fluids were extrapolated outside of their tables.");
+    }
+    else{
+        statusBar()->clearMessage();
+    }
 }
 /*!
  * \brief displays the results from solver on application window
@@ -68,41 +83,13 @@ void MainWindow::setResultsInLabels(const OutputData *results){
  * \brief sets the values of forced convection parameters based on user choice
  */
 void MainWindow::setForcedConvectionsConstValues(){
-    int choice=boxForcedConvection->currentIndex();
-    switch(choice){
-    case 0://low viscosity
-        dataFromUser.forcedConvectionConstValueC=0.023;
-        dataFromUser.forcedConvectionConstValueA=0.8;
-        dataFromUser.forcedConvectionConstValueB=0.4;
-        break;
-    case 1://high viscosity
-        dataFromUser.forcedConvectionConstValueC=0.027;
-        dataFromUser.forcedConvectionConstValueA=0.8;
-        dataFromUser.forcedConvectionConstValueB=0.33;
-        break;
-    case 2://perpendicular flow
-        dataFromUser.forcedConvectionConstValueC=0.283;
-        dataFromUser.forcedConvectionConstValueA=0.6;
-        dataFromUser.forcedConvectionConstValueB=0.31;
-        break;
-    }
+    dataFromUser.setForcedConvectionConstValues(boxForcedConvection->currentIndex());
 }
 /*!
  * \brief sets the value of emissivity of isolator based on user choice
  */
 void MainWindow::setEmissivityOfIsolator(){
-    int choice=boxEmissivityOfIsolator->currentIndex();
-    switch(choice){
-    case 0://low
-        dataFromUser.emissivityOfIsolator=0.3;
-        break;
-    case 1://medium
-        dataFromUser.emissivityOfIsolator=0.6;
-        break;
-    case 2://high
-        dataFromUser.emissivityOfIsolator=0.9;
-        break;
-    }
+    dataFromUser.setEmissivityOfIsolator(boxEmissivityOfIsolator->currentIndex());
 }
 /*!
  * \brief sets the values of properties of fluids in table that is display on application window
@@ -173,9 +160,10 @@ void MainWindow::loadLineEditUserData(){
 };
 }
 /*!
- * \brief loads all of the liquids properties
+ * \brief loads all of the liquids properties and the properties of air
  */
 void MainWindow::loadLiquidsProperties(){
+    air=new ThermalProperties{"fluids_properties/air.txt"};
     liquid=new ThermalProperties[quantityOfLiquids]{
         ThermalProperties(filePathLiquids[0]),
         ThermalProperties(filePathLiquids[1]),
@@ -199,6 +187,7 @@ MainWindow::~MainWindow()
 {
     delete[] lineEditUserData;
     delete[] liquid;
+    delete air;
     delete ui;
 }
 /*!
@@ -288,6 +277,7 @@ void MainWindow::saveOutputData(QTextStream *output){
  * \param file file to which the data will be saved
  */
 void MainWindow::saveResultsToFile(QFile *file){
+    HEAT_TRACE_SCOPE("export results", "io");
     QTextStream out(file);
     out.setCodec("UTF-8");
     out<<frontHtmlText;
@@ -498,14 +488,14 @@ void MainWindow::saveResultsToXmlFile(const QString &fileName){
  * \param xmlTable xml table
  */
 void MainWindow::saveInputAndOutputDataToXml(XmlWriter *xmlTable){
-    QString *symbol=new QString[19]{
+    const QString symbol[19]{
         "dw", "g1", "w", "T1",
             "lam2", "g2", "T2","l",
             "rodzaj cieczy","konwekcja wymuszona","emisyjność izolacji",
             "T3","a1k","a2k","a2r","q2r",
             "q2k","q1","q2"
     };
-    QString *variableName=new QString[19]{
+    const QString variableName[19]{
         "średnica wew. przewodu", "grubość ścianki przewodu",
         "średnia prekość cieczy", "średnia temperatura cieczy",
         "wspólcz. przewodzenia ciepla izolacji","grubość ścianki izolacji",
@@ -517,7 +507,7 @@ void MainWindow::saveInputAndOutputDataToXml(XmlWriter *xmlTable){
         "strumień ciepła traconego przez promieniowanie","strumień ciepła traconego przez konwekcję",
         "strumień ciepła dopływający do pow. izolacji","strumień ciepła odpływający z pow. izolacji"
     };
-    QString *value= new QString[19]{
+    const QString value[19]{
             ui->lineEditInnerDiameterOfPipe->text(),
             ui->lineEditThicknessOfPipe->text(),
             ui->lineEditMeanVelocityOfLiquid->text(),
@@ -536,7 +526,7 @@ void MainWindow::saveInputAndOutputDataToXml(XmlWriter *xmlTable){
             ui->labelHeatFlow1->text(),
             ui->labelHeatFlow2->text()
 };
-    QString *convectionText=new QString[3]{
+    const QString convectionText[3]{
             "mała lepkość płynu",
             "duża lepkość płynu",
             "przepływ prostopadły"
@@ -568,10 +558,6 @@ void MainWindow::saveInputAndOutputDataToXml(XmlWriter *xmlTable){
         }
 
     }
-    delete[] convectionText;
-    delete[] value;
-    delete[] variableName;
-    delete[] symbol;
 }
 
 
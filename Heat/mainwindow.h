@@ -16,6 +16,7 @@
 #include <QFileDialog>
 #include <QFile>
 #include <QMessageBox>
+#include <QStatusBar>
 #include <QDataStream>
 #include <QTextStream>
 #include <iostream>
@@ -139,9 +140,9 @@ private:
                               "fluids_properties/isobutane.txt",
                               "fluids_properties/methanol.txt"};
     /*!
-     * \brief stores the address of object that is used for solving the heat transfer problem
+     * \brief stores the address of air properties, loaded once with the liquids properties
      */
-    HeatTransferSolver *solveTask;
+    ThermalProperties *air;
     /*!
      * \brief stores the front html text that is used for saving files
      */
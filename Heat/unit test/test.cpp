@@ -3,9 +3,81 @@
 #include "../Project1/NaturalConvection.cpp"
 #include "../Project1/ThermalProperties.cpp"
 #include "../Project1/InputData.cpp" 
+#include "../Project1/LayerStack.cpp"
 #include "../Project1/OutputData.cpp"
+#include "../Project1/SolverStatistics.cpp"
+#include "../Project1/TraceRecorder.cpp"
 #include "../Project1/HeatTransferSolver.cpp"
+#include "../Project1/MixedPrecisionSolver.cpp"
+#include "../Project1/FluidLibrary.cpp"
+#include "../Project1/ScratchArena.cpp"
+#include "../Project1/BatchRunner.cpp"
+#include "../Project1/BatchPipeline.cpp"
+#include "../Project1/AxialMarching.cpp"
+#include "../Project1/PipeNetwork.cpp"
+#include "../Project1/TransientSimulation.cpp"
+#include "../Project1/InsulationOptimizer.cpp"
+#include "../Project1/InverseSolver.cpp"
+#include "../Project1/MonteCarlo.cpp"
+#include "../Project1/Sensitivity.cpp"
+#include "../Project1/SurrogateModel.cpp"
+#include "../Project1/ResultCache.cpp"
+#ifndef _WIN32
+#include "../Project1/Checkpoint.cpp"
+#include "../Project1/ResultRing.cpp"
+#include "../Project1/ShardedRunner.cpp"
+#endif
 #include <array>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+/*!
+ * \file
+ * the global operator new and operator delete are replaced for the whole test program (all tests use them),
+ * the allocations are counted only while isCountingAllocations is set,
+ * see BatchRunner.parsesAndSolvesWithoutHeapAfterWarmUp
+ */
+namespace {
+/*!
+ * \brief quantity of calls of global operator new while isCountingAllocations is set
+ */
+std::atomic<std::uint64_t> quantityOfAllocations{ 0 };
+/*!
+ * \brief switches on the counting of allocations inside the test which checks them
+ */
+std::atomic<bool> isCountingAllocations{ false };
+}
+void* operator new(std::size_t size)
+{
+	if (isCountingAllocations) {
+		++quantityOfAllocations;
+	}
+	if (void *memory = std::malloc(size == 0 ? 1 : size)) {
+		return memory;
+	}
+	throw std::bad_alloc{};
+}
+void* operator new[](std::size_t size)
+{
+	return operator new(size);
+}
+void operator delete(void *memory) noexcept
+{
+	std::free(memory);
+}
+void operator delete[](void *memory) noexcept
+{
+	std::free(memory);
+}
+void operator delete(void *memory, std::size_t) noexcept
+{
+	std::free(memory);
+}
+void operator delete[](void *memory, std::size_t) noexcept
+{
+	std::free(memory);
+}
 
 
 TEST(Interpolation, LagrangeAlgorithm) {
@@ -57,6 +129,34 @@ TEST(NaturalConvection, turbulentFlow) {
 	}
 }
 
+TEST(NaturalConvection, regimeTheSameAsSetValueOfAandC) {
+	static_assert(NaturalConvection::getIndexOfRegime(4.9e2) == 1, "regime is not a constant expression");
+	static_assert(NaturalConvection::getRegime(2e7).C == 0.135, "regime is not a constant expression");
+	NaturalConvection naturalTransfer;
+	for (double product : {-1.0, 0.0, 1e-3, 1.0, 5e2, 1e5, 2e7, 1e12, double(NAN)}) {
+		naturalTransfer.setValueOfAandC(product);
+		NaturalConvectionRegime regime = NaturalConvection::getRegime(product);
+		EXPECT_EQ(naturalTransfer.A, regime.A);
+		EXPECT_EQ(naturalTransfer.C, regime.C);
+	}
+	EXPECT_EQ(0.45, NaturalConvection::getRegime(NAN).C);
+}
+
+TEST(Power, exponentKernelsTheSameAsPow) {
+	static_assert(isDegreeOfRootKernel(16) && isDegreeOfRootKernel(27) && !isDegreeOfRootKernel(5),
+		"degree of root is not a constant expression");
+	for (double base : {1e-3, 0.559, 1.0, 7.0, 2.5e4, 1e9}) {
+		EXPECT_NEAR(pow(base, 0.125), (Exponent<1, 8>::getPowerOf(base)), 1e-14*pow(base, 0.125));
+		EXPECT_NEAR(pow(base, 1.0 / 3), (Exponent<1, 3>::getPowerOf(base)), 1e-14*pow(base, 1.0 / 3));
+		EXPECT_NEAR(pow(base, 9.0 / 16), (Exponent<9, 16>::getPowerOf(base)), 1e-14*pow(base, 9.0 / 16));
+		EXPECT_NEAR(pow(base, 8.0 / 27), (Exponent<8, 27>::getPowerOf(base)), 1e-14*pow(base, 8.0 / 27));
+		EXPECT_EQ(pow(base, 0.8), (Exponent<4, 5>::getPowerOf(base)));
+		Dual<1> dual = Dual<1>::variable(base, 0);
+		Dual<1> power = Exponent<9, 16>::getPowerOf(dual);
+		EXPECT_NEAR(9.0 / 16 * pow(base, 9.0 / 16 - 1), power.derivative[0], 1e-13*pow(base, 9.0 / 16 - 1));
+	}
+}
+
 TEST(ThermalProperties, fileLoadedAir) {
 	ThermalProperties air{ "fluids_properties/air.txt" };
 	EXPECT_EQ(0.0265, air.valueAt(300, PropertyType::conductivity));
@@ -134,10 +234,8 @@ InputData* getTestInputData() {
 	//Isolator Properties
 	data->emissivityOfIsolator = 0.92;
 	data->thermalConductivityOfIsolator = 0.093;
-	//Forced convection values 
-	data->forcedConvectionConstValueA = 0.8;
-	data->forcedConvectionConstValueB = 0.4;
-	data->forcedConvectionConstValueC = 0.023;
+	//Forced convection: Dittus-Boelter equation for heated liquid (C 0.023, A 0.8, B 0.4)
+	data->typeOfForcedConvection = 0;
 	//Environment Properties
 	data->temperatureOfEnvironment = 286;
 	data->calculateTheRemainingData();
@@ -426,3 +524,916 @@ TEST(HeatTransferSolver, getIntervalValues_methanol) {
 	}
 }
 
+
+TEST(BatchRunner, parseCase) {
+	FluidLibrary fluids;
+	BatchOptions options;
+	BatchRunner runner{ fluids, options };
+	BatchCase batchCase = runner.parseCase("0,08 0.004 1 413 2 1 0.093 0.03 286 2 1,0");
+	EXPECT_EQ(0.08, batchCase.data.innerDiameterOfPipe);
+	EXPECT_EQ(413, batchCase.data.meanTemperatureOfLiquid);
+	EXPECT_EQ(2, batchCase.typeOfLiquid);
+	EXPECT_EQ(1, batchCase.data.typeOfForcedConvection);//Sieder-Tate
+	EXPECT_EQ(0.9, batchCase.data.emissivityOfIsolator);
+	EXPECT_EQ(1, batchCase.data.lengthOfPipe);
+	EXPECT_THROW(runner.parseCase("0.08 0.004 1 413"), std::invalid_argument);
+	EXPECT_THROW(runner.parseCase("0.08 0.004 1 413 7 1 0.093 0.03 286 2 1"), std::invalid_argument);
+	EXPECT_THROW(runner.parseCase("0.08 0.004 1 abc 2 1 0.093 0.03 286 2 1"), std::invalid_argument);
+	EXPECT_THROW(runner.parseCase("0.08 0.004 1 413x 2 1 0.093 0.03 286 2 1"), std::invalid_argument);
+	EXPECT_THROW(runner.parseCase("0.08 0.004 1 1e999 2 1 0.093 0.03 286 2 1"), std::invalid_argument);
+	EXPECT_EQ(286, runner.parseCase("\t0.08 0.004 1 413 2 1 0.093 0.03 286 2 1 \r").data.temperatureOfEnvironment);
+}
+
+TEST(BatchRunner, rejectsTypesOutOfRangeAndRethrowsErrorsOfThreads) {
+	FluidLibrary fluids;
+	BatchOptions options;
+	options.quantityOfThreads = 3;
+	BatchRunner runner{ fluids, options };
+	double value[BatchRunner::quantityOfInputValues] = { 0.08, 0.004, 1, 413, 2, 1, 0.093, 0.03, 286, 2, 1 };
+	for (double type : { std::nan(""), std::numeric_limits<double>::infinity(), 1e300, -1e300 }) {
+		for (int index : { 4, 5, 9 }) {
+			double wrongValue[BatchRunner::quantityOfInputValues];
+			std::copy(value, value + BatchRunner::quantityOfInputValues, wrongValue);
+			wrongValue[index] = type;
+			EXPECT_THROW(runner.makeCase(wrongValue), std::invalid_argument);
+		}
+	}
+	std::vector<BatchCase> cases(7, runner.makeCase(value));
+	cases[5].typeOfLiquid = FluidLibrary::quantityOfLiquids;
+	EXPECT_THROW(runner.solve(cases), std::out_of_range);
+}
+
+TEST(BatchRunner, solveTheSameAsSolver) {
+	FluidLibrary fluids;
+	BatchOptions options;
+	options.quantityOfThreads = 3;
+	BatchRunner runner{ fluids, options };
+	std::istringstream input("# comment\n0.08 0.004 1 413 0 0 0.093 0.03 286 2 1\n\n"
+		"0.08 0.004 1 413 0 0 0.093 0.03 286 2 1\n0.08 0.004 1 413 0 0 0.093 0.03 286 2 1\n");
+	std::vector<BatchCase> cases = runner.loadCases(input);
+	ASSERT_EQ(3, cases.size());
+	std::vector<OutputData> results = runner.solve(cases);
+	InputData *data = getTestInputData();
+	data->emissivityOfIsolator = 0.9;
+	ThermalProperties liquid{ "fluids_properties/water.txt" };
+	HeatTransferSolver example{ *data,liquid };
+	example.runTheSolver();
+	for (const auto &result : results) {
+		EXPECT_DOUBLE_EQ(example.getResults()->temperatureOnIsolator, result.temperatureOnIsolator);
+		EXPECT_DOUBLE_EQ(example.getResults()->heatFlow1, result.heatFlow1);
+	}
+	delete data;
+}
+
+TEST(BatchRunner, parsesAndSolvesWithoutHeapAfterWarmUp) {
+	FluidLibrary fluids;
+	BatchRunner runner{ fluids, BatchOptions{} };
+	const std::string lineText{ "0.08 0.004 1 413 0 0 0.093 0.03 286 2 1 0.004 50 0.03 0.093" };
+	BatchCase batchCase = runner.parseCase(lineText);
+	OutputData result{};
+	runner.solveCase(batchCase, result);//warm-up: scratch arena and buffers of thread
+	quantityOfAllocations = 0;
+	isCountingAllocations = true;
+	for (int i = 0; i < 100; ++i) {
+		BatchCase parsedCase = runner.parseCase(lineText);
+		runner.solveCase(parsedCase, result);
+	}
+	isCountingAllocations = false;
+	EXPECT_EQ(0u, quantityOfAllocations.load());
+	EXPECT_EQ(0u, result.status & OutputData::statusNotANumber);
+}
+
+TEST(BatchPipeline, theSameAsSolve) {
+	FluidLibrary fluids;
+	BatchOptions options;
+	options.quantityOfThreads = 3;
+	BatchRunner runner{ fluids, options };
+	std::string text = "# comment\n";
+	for (int i = 0; i < 11; ++i) {
+		text += "0.08 0.004 1 " + std::to_string(353 + 5 * i) + " " + std::to_string(i % 5) + " 1 0.093 0.03 286 2 1\n";
+	}
+	std::istringstream input(text);
+	std::vector<BatchCase> cases = runner.loadCases(input);
+	std::ostringstream expected;
+	BatchRunner::saveResultsAsCsv(expected, runner.solve(cases));
+	BatchPipeline pipeline{ runner };
+	pipeline.quantityOfCasesInChunk = 2;
+	pipeline.maximumQuantityOfChunks = 3;
+	std::istringstream csvInput(text);
+	std::ostringstream csvOutput;
+	EXPECT_EQ(11, pipeline.run(csvInput, csvOutput, false).quantityOfCases);
+	EXPECT_EQ(expected.str(), csvOutput.str());
+	std::istringstream binaryInput(text);
+	std::stringstream binaryOutput;
+	pipeline.run(binaryInput, binaryOutput, true);
+	std::ostringstream expectedBinary;
+	BatchRunner::saveResultsAsBinary(expectedBinary, runner.solve(cases));
+	EXPECT_EQ(expectedBinary.str(), binaryOutput.str());
+	std::istringstream corruptedInput(text + "0.08 0.004 x 413 0 0 0.093 0.03 286 2 1\n");
+	std::ostringstream output;
+	EXPECT_THROW(pipeline.run(corruptedInput, output, false), std::invalid_argument);
+}
+
+namespace {
+/*!
+ * \brief buffer of stream which fails after capacity characters
+ */
+class LimitedBuffer : public std::streambuf
+{
+public:
+	explicit LimitedBuffer(const size_t &capacity) : capacity{ capacity } {}
+protected:
+	int_type overflow(int_type character) override
+	{
+		return capacity-- > 0 ? character : traits_type::eof();
+	}
+private:
+	size_t capacity;
+};
+}
+
+TEST(BatchPipeline, rethrowsErrorOfWriting) {
+	FluidLibrary fluids;
+	BatchOptions options;
+	options.quantityOfThreads = 2;
+	BatchRunner runner{ fluids, options };
+	std::string text{};
+	for (int i = 0; i < 200; ++i) {
+		text += "0.08 0.004 1 413 0 0 0.093 0.03 286 2 1\n";
+	}
+	BatchPipeline pipeline{ runner };
+	pipeline.quantityOfCasesInChunk = 2;
+	pipeline.maximumQuantityOfChunks = 3;
+	std::istringstream input(text);
+	std::ostringstream header;
+	BatchRunner::writeCsvHeader(header);
+	LimitedBuffer buffer{ header.str().size() + 500 };
+	std::ostream output(&buffer);
+	output.exceptions(std::ios::badbit);
+	EXPECT_THROW(pipeline.run(input, output, false), std::ios_base::failure);
+}
+
+TEST(HeatTransferSolver, warmStartTheSameAsBisection) {
+	InputData *data = getTestInputData();
+	ThermalProperties liquid{ "fluids_properties/water.txt" };
+	HeatTransferSolver example{ *data,liquid };
+	example.runTheSolver(0.0001);
+	double expected = example.getResults()->temperatureOnIsolator;
+	for (double initial : {286.0, 300.0, 350.0, 413.0, 1000.0}) {
+		EXPECT_NEAR(expected, example.findTemperatureOnIsolator(initial, 0.0001), 0.01);
+	}
+	delete data;
+}
+
+TEST(HeatTransferSolver, statusOfResults) {
+	InputData *data = getTestInputData();
+	data->temperatureOfEnvironment = 310;
+	ThermalProperties liquid{ "fluids_properties/water.txt" };
+	HeatTransferSolver example{ *data,liquid };
+	example.runTheSolver();
+	EXPECT_EQ(0u, example.getResults()->status);
+	example.getQuotient(1, 0);
+	EXPECT_EQ(OutputData::statusDivisionByZero, example.getResults()->status);
+	example.runTheSolverFrom(300);
+	EXPECT_EQ(0u, example.getResults()->status);
+	data->temperatureOfEnvironment = 286;//air properties below the table
+	HeatTransferSolver extrapolated{ *data,liquid };
+	extrapolated.runTheSolver();
+	EXPECT_EQ(OutputData::statusExtrapolation, extrapolated.getResults()->status);
+	ThermalProperties air{ "fluids_properties/air.txt" };
+	air.kinematicViscosity[0] = 0;//air at 300 K, the Grashof number of the first evaluation from 314 K divides by zero
+	HeatTransferSolver dividedByZero{ *data,liquid,air };
+	dividedByZero.runTheSolverFrom(314);
+	EXPECT_NE(300, 0.5*(dividedByZero.getResults()->temperatureOnIsolator + data->temperatureOfEnvironment));
+	EXPECT_EQ(OutputData::statusExtrapolation | OutputData::statusDivisionByZero, dividedByZero.getResults()->status);
+	delete data;
+
+	FluidLibrary fluids;
+	BatchRunner runner{ fluids, BatchOptions{} };
+	std::istringstream input("0.08 0.004 1 413 0 0 0.093 0.03 310 2 1\n"
+		"0.05 0.005 1.13 325 1 0 0.048 0.167 280 1 10\n");
+	std::vector<BatchCase> cases = runner.loadCases(input);
+	BatchStatusSummary summary = BatchRunner::getStatusSummary(runner.solve(cases));
+	EXPECT_EQ(2u, summary.quantityOfCases);
+	EXPECT_EQ(1u, summary.quantityOfSuspectCases);
+	EXPECT_EQ(1u, summary.quantityOfCasesWithFlag[0]);//not a number
+	summary.add(OutputData::statusExtrapolation);
+	EXPECT_EQ(1u, summary.quantityOfSuspectCases);
+	EXPECT_EQ(2u, summary.getQuantityOfExtrapolatedCases());
+	EXPECT_EQ(std::string::npos, summary.toText().find("extrapolation"));
+	EXPECT_EQ("properties of fluids were extrapolated outside of their tables in 2 of 3 cases", summary.toNoteText());
+	EXPECT_EQ("not converged", OutputData::getStatusDescription(OutputData::statusNotConverged));
+}
+
+TEST(ConvectionCorrelation, policiesInSolverAndModel) {
+	InputData *data = getTestInputData();
+	data->setForcedConvectionConstValues(3);
+	EXPECT_EQ(3, data->typeOfForcedConvection);
+	data->setForcedConvectionConstValues(0);
+	data->temperatureOfEnvironment = 310;
+	ThermalProperties liquid{ "fluids_properties/water.txt" };
+	ThermalProperties air{ "fluids_properties/air.txt" };
+	HeatTransferSolver simplified{ *data,liquid,air };
+	simplified.runTheSolver(0.0001);
+	data->typeOfNaturalConvection = 1;
+	HeatTransferSolver churchillChu{ *data,liquid,air };
+	churchillChu.runTheSolver(0.0001);
+	const OutputData *results = churchillChu.getResults();
+	EXPECT_EQ(0u, results->status);
+	EXPECT_NEAR(results->heatFlow1, results->heatFlow2, 0.01);
+	EXPECT_NEAR(simplified.getResults()->convectionCoefficient2, results->convectionCoefficient2,
+		0.2*results->convectionCoefficient2);
+	EXPECT_NEAR(results->temperatureOnIsolator, churchillChu.findTemperatureOnIsolator(400, 0.0001), 0.01);
+	HeatTransferModel<double> model{ *data,liquid,air };
+	model.calculateTheRemainingData();
+	for (double temperature : {300.0, 320.0, 400.0}) {
+		EXPECT_NEAR(churchillChu.getConvectionCeofficient2(temperature), model.getConvectionCoefficient2(temperature), 1e-12);
+	}
+	delete data;
+}
+
+TEST(MixedPrecisionSolver, closeToDoublePrecision) {
+	FluidLibrary fluids;
+	BatchOptions options;
+	std::istringstream input("0.08 0.004 1 413 0 0 0.093 0.03 286 2 1\n"
+		"0.05 0.005 2 350 0 3 0.05 0.1 300 1 10\n"
+		"0.2 0.005 0.5 400 2 1 0.04 0.05 280 0 5\n"
+		"0.1 0.005 1.5 320 4 2 0.09 0.02 290 2 1\n");
+	std::vector<BatchCase> cases = BatchRunner{ fluids, options }.loadCases(input);
+	std::vector<OutputData> reference = BatchRunner{ fluids, options }.solve(cases);
+	options.isMixedPrecision = true;
+	std::vector<OutputData> results = BatchRunner{ fluids, options }.solve(cases);
+	PrecisionDeviation deviation = PrecisionDeviation::compare(reference, results);
+	EXPECT_EQ(4u, deviation.quantityOfCases);
+	EXPECT_EQ(0u, deviation.quantityOfSkippedCases);
+	EXPECT_EQ(0u, deviation.quantityOfDifferentStatus);
+	for (int i = 0; i < OutputData::quantityOfFields; ++i) {
+		EXPECT_LT(deviation.maximumDeviation[i], 1e-3) << OutputData::fieldNames[i];
+	}
+	EXPECT_LT(deviation.maximumDeviation[0], 1e-5);
+}
+
+TEST(MixedPrecisionSolver, flagsDivisionByZeroAsSolver) {
+	InputData *data = getTestInputData();
+	ThermalProperties liquid{ "fluids_properties/water.txt" };
+	ThermalProperties air{ "fluids_properties/air.txt" };
+	std::fill(air.kinematicViscosity.begin(), air.kinematicViscosity.end(), 0.0);//the Grashof number divides by zero
+	HeatTransferSolver reference{ *data, liquid, air };
+	reference.runTheSolver();
+	MixedPrecisionSolver mixed{ *data, liquid, air };
+	mixed.runTheSolver();
+	EXPECT_NE(0u, reference.getResults()->status & OutputData::statusDivisionByZero);
+	EXPECT_EQ(reference.getResults()->status, mixed.getResults()->status);
+	delete data;
+}
+
+TEST(AxialMarching, shortPipeTheSameAsSolver) {
+	InputData *data = getTestInputData();
+	ThermalProperties liquid{ "fluids_properties/water.txt" };
+	ThermalProperties air{ "fluids_properties/air.txt" };
+	HeatTransferSolver example{ *data, liquid, air };
+	example.runTheSolver();
+	AxialMarching pipe{ *data, liquid, air };
+	AxialProfile profile = pipe.march(10);
+	EXPECT_NEAR(example.getResults()->heatFlow1, profile.totalHeatFlow, 0.5);
+	EXPECT_LT(profile.outletTemperatureOfLiquid, data->meanTemperatureOfLiquid);
+	delete data;
+}
+
+TEST(AxialMarching, longPipeCoolsDown) {
+	InputData *data = getTestInputData();
+	data->lengthOfPipe = 50000;
+	data->meanVelocityOfLiquid = 0.1;
+	ThermalProperties liquid{ "fluids_properties/water.txt" };
+	ThermalProperties air{ "fluids_properties/air.txt" };
+	AxialMarching pipe{ *data, liquid, air };
+	AxialProfile coarse = pipe.march(100);
+	AxialProfile fine = pipe.march(100000);
+	EXPECT_NEAR(coarse.outletTemperatureOfLiquid, fine.outletTemperatureOfLiquid, 0.5);
+	EXPECT_NEAR(fine.outletTemperatureOfLiquid, pipe.getOutletTemperature(413, 100000), 1e-9);
+	for (size_t i = 1; i < fine.temperatureOfLiquid.size(); ++i) {
+		ASSERT_LE(fine.temperatureOfLiquid[i], fine.temperatureOfLiquid[i - 1]);
+		ASSERT_GT(fine.temperatureOfLiquid[i], data->temperatureOfEnvironment);
+	}
+	delete data;
+}
+
+NetworkPipe getTestNetworkPipe(size_t fromJunction, size_t toJunction, double lengthOfPipe) {
+	InputData *data = getTestInputData();
+	NetworkPipe pipe{ *data, fromJunction, toJunction };
+	pipe.data.lengthOfPipe = lengthOfPipe;
+	pipe.data.meanVelocityOfLiquid = 0.1;
+	pipe.quantityOfSegments = 10;
+	delete data;
+	return pipe;
+}
+
+TEST(PipeNetwork, chainTheSameAsOnePipe) {
+	FluidLibrary fluids;
+	PipeNetwork network{ fluids };
+	size_t source = network.addSourceJunction(413);
+	size_t middle = network.addJunction();
+	size_t end = network.addJunction();
+	network.addPipe(getTestNetworkPipe(source, middle, 1000));
+	network.addPipe(getTestNetworkPipe(middle, end, 1000));
+	NetworkResults results = network.solve();
+	NetworkPipe longPipe = getTestNetworkPipe(0, 0, 2000);
+	longPipe.data.meanTemperatureOfLiquid = 413;
+	AxialMarching marching{ longPipe.data, fluids.liquid(0), fluids.air() };
+	EXPECT_NEAR(marching.getOutletTemperature(413, 20), results.temperatureOfJunction[end], 0.01);
+	EXPECT_DOUBLE_EQ(results.pipes[0].heatFlow + results.pipes[1].heatFlow, results.totalHeatFlow);
+	EXPECT_EQ(1, results.quantityOfIterations);
+}
+
+TEST(PipeNetwork, branchesAreMixed) {
+	FluidLibrary fluids;
+	PipeNetwork network{ fluids };
+	size_t hot = network.addSourceJunction(413);
+	size_t cold = network.addSourceJunction(350);
+	size_t mixing = network.addJunction();
+	network.addPipe(getTestNetworkPipe(hot, mixing, 100));
+	network.addPipe(getTestNetworkPipe(cold, mixing, 100));
+	NetworkResults results = network.solve(0.001, 4);
+	EXPECT_LT(results.temperatureOfJunction[mixing], results.pipes[0].outletTemperature);
+	EXPECT_GT(results.temperatureOfJunction[mixing], results.pipes[1].outletTemperature);
+	EXPECT_THROW(network.addPipe(getTestNetworkPipe(mixing, 7, 100)), std::invalid_argument);
+}
+
+TEST(PipeNetwork, loopConverges) {
+	FluidLibrary fluids;
+	PipeNetwork network{ fluids };
+	size_t source = network.addSourceJunction(413);
+	size_t first = network.addJunction();
+	size_t second = network.addJunction();
+	network.addPipe(getTestNetworkPipe(source, first, 100));
+	network.addPipe(getTestNetworkPipe(first, second, 100));
+	network.addPipe(getTestNetworkPipe(second, first, 100));
+	NetworkResults results = network.solve();
+	EXPECT_LT(1, results.quantityOfIterations);
+	EXPECT_LT(results.temperatureOfJunction[second], results.temperatureOfJunction[first]);
+	EXPECT_LT(results.temperatureOfJunction[first], 413);
+}
+
+TEST(TransientSimulation, steadyStateStaysSteady) {
+	InputData *data = getTestInputData();
+	data->lengthOfPipe = 1000;
+	data->meanVelocityOfLiquid = 0.1;
+	ThermalProperties liquid{ "fluids_properties/water.txt" };
+	ThermalProperties air{ "fluids_properties/air.txt" };
+	TransientSimulation simulation{ *data, liquid, air };
+	TransientSettings settings;
+	settings.quantityOfSegments = 50;
+	settings.simulationTime = 6 * 3600;
+	TransientResults results = simulation.run(settings);
+	EXPECT_NEAR(results.samples.front().outletTemperatureOfLiquid, results.samples.back().outletTemperatureOfLiquid, 0.5);
+	EXPECT_GT(settings.simulationTime / settings.timeStep / 10, results.quantityOfFactorizations);
+	EXPECT_LT(results.timeToFreeze, 0);
+	delete data;
+}
+
+TEST(TransientSimulation, shutdownCoolsDownToFreezing) {
+	InputData *data = getTestInputData();
+	data->lengthOfPipe = 100;
+	data->meanTemperatureOfLiquid = 300;
+	data->temperatureOfEnvironment = 250;
+	ThermalProperties liquid{ "fluids_properties/water.txt" };
+	ThermalProperties air{ "fluids_properties/air.txt" };
+	TransientSimulation simulation{ *data, liquid, air };
+	TransientSettings settings;
+	settings.quantityOfSegments = 20;
+	settings.shutdownTime = 3600;
+	settings.simulationTime = 10 * 86400;
+	TransientResults results = simulation.run(settings);
+	EXPECT_GT(results.timeToFreeze, settings.shutdownTime);
+	for (size_t i = 1; i < results.samples.size(); ++i) {
+		if (results.samples[i].time > settings.shutdownTime + settings.timeStep) {
+			EXPECT_LE(results.samples[i].minimumTemperatureOfLiquid, results.samples[i - 1].minimumTemperatureOfLiquid + 1e-9);
+		}
+	}
+	TransientResults again = simulation.run(settings);
+	ASSERT_EQ(results.samples.size(), again.samples.size());
+	for (size_t i = 0; i < results.samples.size(); ++i) {
+		EXPECT_EQ(results.samples[i].outletTemperatureOfLiquid, again.samples[i].outletTemperatureOfLiquid);
+		EXPECT_EQ(results.samples[i].heatFlow, again.samples[i].heatFlow);
+	}
+	EXPECT_EQ(results.timeToFreeze, again.timeToFreeze);
+	delete data;
+}
+
+TEST(LayerStack, resistanceOfLayers) {
+	LayerStack layers;
+	EXPECT_EQ(0, layers.getResistance(0.08, 1));
+	layers.addLayer(0.004, 50);
+	layers.addLayer(0.03, 0.093);
+	double expected = (log(0.088 / 0.08) / 50 + log(0.148 / 0.088) / 0.093) / (2 * 3.141592653589793238);
+	EXPECT_NEAR(expected, layers.getResistance(0.08, 1), 1e-12);
+	EXPECT_NEAR(0.034, layers.getThickness(), 1e-12);
+	for (int i = 2; i < LayerStack::maximumQuantityOfLayers; ++i) {
+		layers.addLayer(0.001, 1);
+	}
+	EXPECT_THROW(layers.addLayer(0.001, 1), std::length_error);
+	EXPECT_THROW(LayerStack().addLayer(0, 1), std::invalid_argument);
+}
+
+TEST(HeatTransferSolver, layersWithWallAndJacket) {
+	InputData *data = getTestInputData();
+	ThermalProperties liquid{ "fluids_properties/water.txt" };
+	HeatTransferSolver singleLayer{ *data,liquid };
+	singleLayer.runTheSolver();
+	double heatFlow = singleLayer.getResults()->heatFlow1;
+	data->layers.addLayer(0.004, 50);
+	data->layers.addLayer(0.02, 0.093);
+	data->layers.addLayer(0.01, 0.093);
+	HeatTransferSolver stack{ *data,liquid };
+	stack.runTheSolver();
+	EXPECT_NEAR(0.03, data->thicknessOfIsolator, 1e-12);
+	EXPECT_NEAR(heatFlow, stack.getResults()->heatFlow1, 0.5);
+	EXPECT_GT(stack.getResults()->resistanceOfThermalConduction, singleLayer.getResults()->resistanceOfThermalConduction);
+	delete data;
+}
+
+TEST(InsulationOptimizer, theSameAsScan) {
+	FluidLibrary fluids;
+	InsulationCosts costs;
+	costs.priceOfHeat = 0.1;
+	InsulationOptimizer optimizer{ fluids, costs };
+	BatchRunner runner{ fluids, BatchOptions{} };
+	BatchCase pipeClass = runner.parseCase("0.08 0.004 1 413 0 0 0.093 0.03 286 2 1");
+	std::vector<IsolatorMaterial> materials{ { 0.093, 400 }, { 0.04, 10000 } };
+	InsulationOptimum optimum = optimizer.optimize(pipeClass, materials);
+	double scanCost = 1e100;
+	for (int material = 0; material < 2; ++material) {
+		for (double thickness = 0.001; thickness < 0.5; thickness += 0.001) {
+			InputData data{ pipeClass.data };
+			data.thicknessOfIsolator = thickness;
+			data.thermalConductivityOfIsolator = materials[material].thermalConductivity;
+			HeatTransferSolver solver{ data, fluids.liquid(0), fluids.air() };
+			solver.runTheSolver();
+			double volume = 0.25*data.PI*(data.overallDiameterOfPipe*data.overallDiameterOfPipe -
+				data.outerDiameterOfPipe*data.outerDiameterOfPipe);
+			double cost = materials[material].costPerVolume*volume +
+				solver.getResults()->heatFlow1 / 1000 * 8760 * 0.1 * 20;
+			scanCost = std::min(scanCost, cost);
+		}
+	}
+	EXPECT_LE(optimum.totalCost, scanCost + 0.5);
+	EXPECT_GT(optimum.thicknessOfIsolator, 0);
+	EXPECT_LT(optimum.quantityOfSolves, 100);
+	std::vector<InsulationOptimum> parallel = optimizer.optimize(std::vector<BatchCase>(3, pipeClass), materials, 2);
+	for (const auto &result : parallel) {
+		EXPECT_DOUBLE_EQ(optimum.thicknessOfIsolator, result.thicknessOfIsolator);
+	}
+	std::vector<BatchCase> wrongClasses(3, pipeClass);
+	wrongClasses[2].typeOfLiquid = FluidLibrary::quantityOfLiquids;
+	EXPECT_THROW(optimizer.optimize(wrongClasses, materials, 2), std::invalid_argument);
+}
+
+TEST(InverseSolver, thicknessForTemperatureOnIsolator) {
+	FluidLibrary fluids;
+	BatchRunner runner{ fluids, BatchOptions{} };
+	BatchCase pipeClass = runner.parseCase("0.08 0.004 1 413 0 0 0.093 0.03 286 2 1");
+	InverseSolver inverse{ pipeClass.data, fluids.liquid(0), fluids.air() };
+	InverseProblem problem;
+	problem.targetValue = 313.15;
+	problem.bottomInterval = 0.005;
+	problem.upperInterval = 0.3;
+	InverseResult result = inverse.solve(problem);
+	EXPECT_NEAR(313.15, result.results.temperatureOnIsolator, 0.01);
+	InputData data{ pipeClass.data };
+	data.thicknessOfIsolator = result.valueOfInput;
+	HeatTransferSolver solver{ data, fluids.liquid(0), fluids.air() };
+	solver.runTheSolver(1e-6);
+	EXPECT_NEAR(result.results.heatFlow1, solver.getResults()->heatFlow1, 0.01);
+	problem.target = InverseProblem::heatFlow1;
+	problem.freeInput = InverseProblem::meanTemperatureOfLiquid;
+	problem.targetValue = 50;
+	problem.bottomInterval = 300;
+	problem.upperInterval = 450;
+	result = inverse.solve(problem);
+	EXPECT_NEAR(50, result.results.heatFlow1, 0.01);
+	EXPECT_TRUE(result.isConverged);
+	EXPECT_EQ(0u, result.results.status & OutputData::statusNotConverged);
+	problem.maximumIterations = 3;
+	result = inverse.solve(problem);
+	EXPECT_FALSE(result.isConverged);
+	EXPECT_NE(0u, result.results.status & OutputData::statusNotConverged);
+	problem.maximumIterations = 100;
+	problem.targetValue = 1e6;
+	EXPECT_THROW(inverse.solve(problem), std::runtime_error);
+	BatchCase layeredClass = runner.parseCase("0.08 0.004 1 413 0 0 0.093 0.03 286 2 1 0.004 50 0.03 0.093");
+	InverseSolver layered{ layeredClass.data, fluids.liquid(0), fluids.air() };
+	problem.freeInput = InverseProblem::thicknessOfIsolator;
+	EXPECT_THROW(layered.solve(problem), std::invalid_argument);
+}
+
+TEST(MonteCarlo, statisticsDoNotDependOnThreads) {
+	FluidLibrary fluids;
+	BatchRunner runner{ fluids, BatchOptions{} };
+	BatchCase pipeClass = runner.parseCase("0.08 0.004 1 413 0 0 0.093 0.03 286 2 1");
+	MonteCarloSettings settings;
+	settings.quantityOfSamples = 2000;
+	settings.distributions[MonteCarloSettings::thermalConductivityOfIsolator] = { Distribution::normal, 0.093, 0.005 };
+	settings.distributions[MonteCarloSettings::temperatureOfEnvironment] = { Distribution::uniform, 276, 296 };
+	settings.distributions[MonteCarloSettings::emissivityOfIsolator] = { Distribution::triangular, 0.8, 0.95 };
+	MonteCarloResults single = MonteCarlo{ fluids, settings }.run(pipeClass);
+	settings.quantityOfThreads = 3;
+	MonteCarloResults parallel = MonteCarlo{ fluids, settings }.run(pipeClass);
+	ASSERT_EQ(2000u, parallel.quantityOfSamples);
+	for (int i = 0; i < OutputData::quantityOfFields; ++i) {
+		EXPECT_NEAR(single.fields[i].mean, parallel.fields[i].mean, 1e-5*std::abs(single.fields[i].mean));
+		EXPECT_NEAR(single.fields[i].variance, parallel.fields[i].variance, 1e-3*single.fields[i].variance + 1e-12);
+		EXPECT_NEAR(single.fields[i].percentiles[1], parallel.fields[i].percentiles[1], 1e-5*std::abs(single.fields[i].mean));
+	}
+	InputData data{ pipeClass.data };
+	HeatTransferSolver solver{ data, fluids.liquid(0), fluids.air() };
+	solver.runTheSolver();
+	const FieldStatistics &heatFlow = parallel.fields[6];
+	EXPECT_LT(heatFlow.minimum, solver.getResults()->heatFlow1);
+	EXPECT_GT(heatFlow.maximum, solver.getResults()->heatFlow1);
+	EXPECT_LE(heatFlow.percentiles[0], heatFlow.percentiles[1]);
+	EXPECT_LE(heatFlow.percentiles[1], heatFlow.percentiles[2]);
+	settings.distributions[MonteCarloSettings::emissivityOfIsolator] = { Distribution::triangular, 0.5, 0.8 };
+	EXPECT_THROW(MonteCarlo(fluids, settings).run(pipeClass), std::invalid_argument);
+}
+
+TEST(MonteCarlo, drawsOnlyPhysicalInputs) {
+	FluidLibrary fluids;
+	BatchRunner runner{ fluids, BatchOptions{} };
+	BatchCase pipeClass = runner.parseCase("0.08 0.004 1 413 0 0 0.093 0.03 286 2 1");
+	MonteCarloSettings settings;
+	settings.quantityOfSamples = 2000;
+	settings.distributions[MonteCarloSettings::thermalConductivityOfIsolator] = { Distribution::normal, 0.093, 0.06 };
+	settings.distributions[MonteCarloSettings::emissivityOfIsolator] = { Distribution::normal, 0.9, 0.2 };
+	MonteCarlo monteCarlo{ fluids, settings };
+	InputData data{ pipeClass.data };
+	for (std::uint64_t sample = 0; sample < settings.quantityOfSamples; ++sample) {
+		ASSERT_TRUE(monteCarlo.drawSample(sample, data, pipeClass.data));
+		EXPECT_GT(data.thermalConductivityOfIsolator, 0);
+		EXPECT_GE(data.emissivityOfIsolator, 0);
+		EXPECT_LE(data.emissivityOfIsolator, 1);
+	}
+	MonteCarloResults results = monteCarlo.run(pipeClass);
+	EXPECT_EQ(settings.quantityOfSamples, results.quantityOfSamples + results.quantityOfSkippedSamples);
+	EXPECT_GT(results.fields[8].minimum, 0);//resistance of thermal conduction
+	EXPECT_GT(results.fields[6].percentiles[0], 0);//heat flow 1
+	for (const auto &field : results.fields) {
+		EXPECT_TRUE(std::isfinite(field.mean) && std::isfinite(field.minimum) && std::isfinite(field.maximum));
+	}
+	settings.distributions[MonteCarloSettings::thermalConductivityOfIsolator] = { Distribution::uniform, -0.01, 0.1 };
+	EXPECT_THROW(MonteCarlo(fluids, settings).run(pipeClass), std::invalid_argument);
+}
+
+TEST(MonteCarlo, skipsSuspectResults) {
+	MonteCarloAccumulator accumulator;
+	const double values[OutputData::quantityOfFields] = {};
+	OutputData result{};
+	result.setValuesFrom(values);
+	result.heatFlow1 = 10;
+	accumulator.add(result);
+	result.status = OutputData::statusExtrapolation;
+	accumulator.add(result);
+	result.heatFlow1 = std::nan("");
+	result.status = OutputData::statusNotANumber;
+	accumulator.add(result);
+	result.heatFlow1 = 1e300;
+	result.status = OutputData::statusNotConverged;
+	accumulator.add(result);
+	accumulator.skip();
+	MonteCarloResults results = accumulator.getResults({ 0.5 });
+	EXPECT_EQ(2u, results.quantityOfSamples);
+	EXPECT_EQ(3u, results.quantityOfSkippedSamples);
+	EXPECT_EQ(10, results.fields[6].maximum);
+}
+
+TEST(Sensitivity, theSameAsFiniteDifferences) {
+	FluidLibrary fluids;
+	BatchRunner runner{ fluids, BatchOptions{} };
+	InputData data{ runner.parseCase("0.08 0.004 1 413 0 0 0.093 0.03 286 2 1").data };
+	Sensitivity sensitivity{ fluids.liquid(0), fluids.air() };
+	SensitivityResults derivatives = sensitivity.calculate(data);
+	auto solve = [&](InputData changed, double *values) {
+		changed.calculateTheRemainingData();
+		HeatTransferSolver solver{ changed, fluids.liquid(0), fluids.air() };
+		solver.runTheSolverFrom(derivatives.results.temperatureOnIsolator, 1e-11);
+		solver.getResults()->copyValuesTo(values);
+	};
+	double *input[Sensitivity::quantityOfInputs] = { &data.innerDiameterOfPipe, &data.thicknessOfPipe,
+		&data.meanVelocityOfLiquid, &data.meanTemperatureOfLiquid, &data.thermalConductivityOfIsolator,
+		&data.thicknessOfIsolator, &data.temperatureOfEnvironment, &data.emissivityOfIsolator, &data.lengthOfPipe };
+	for (int i = 0; i < Sensitivity::quantityOfInputs; ++i) {
+		double value = *input[i];
+		double step = 1e-5*value;
+		double upper[OutputData::quantityOfFields], bottom[OutputData::quantityOfFields];
+		*input[i] = value + step;
+		solve(data, upper);
+		*input[i] = value - step;
+		solve(data, bottom);
+		*input[i] = value;
+		for (int field = 0; field < OutputData::quantityOfFields; ++field) {
+			double finiteDifference = (upper[field] - bottom[field]) / (2 * step);
+			EXPECT_NEAR(finiteDifference, derivatives.jacobian[field][i], 1e-3*std::abs(finiteDifference) + 1e-6)
+				<< OutputData::fieldNames[field] << " / " << Sensitivity::inputNames[i];
+		}
+	}
+}
+
+TEST(SurrogateModel, interpolatesSavesAndFallsBack) {
+	FluidLibrary fluids;
+	BatchRunner runner{ fluids, BatchOptions{} };
+	BatchCase baseCase = runner.parseCase("0.08 0.004 1 413 0 0 0.093 0.03 286 2 1");
+	SurrogateModel surrogate{ fluids };
+	surrogate.build(baseCase, { { 7, 0.01, 0.1, 31 }, { 3, 300, 420, 25 } }, 1e-6, 2, 200);
+	BatchCase wrongBase = baseCase;
+	wrongBase.typeOfLiquid = FluidLibrary::quantityOfLiquids;
+	SurrogateModel wrong{ fluids };
+	EXPECT_THROW(wrong.build(wrongBase, { { 7, 0.01, 0.1, 3 } }, 1e-6, 2, 10), std::invalid_argument);
+	EXPECT_LT(surrogate.getErrorEstimate(), 0.01);
+	BatchCase query = runner.parseCase("0.08 0.004 1 390.5 0 0 0.093 0.047 286 2 1");
+	bool isSolved = true;
+	OutputData approximation = surrogate.evaluate(query, 0.01, &isSolved);
+	EXPECT_FALSE(isSolved);
+	HeatTransferSolver solver{ query.data, fluids.liquid(0), fluids.air() };
+	solver.runTheSolverFrom(350, 1e-6);
+	EXPECT_NEAR(solver.getResults()->heatFlow1, approximation.heatFlow1,
+		surrogate.getErrorsOfFields()[6] * solver.getResults()->heatFlow1 * 1.5);
+	std::stringstream file;
+	surrogate.save(file);
+	SurrogateModel loaded{ fluids };
+	loaded.load(file);
+	OutputData loadedApproximation = loaded.evaluate(query, 0.01, &isSolved);
+	EXPECT_FALSE(isSolved);
+	EXPECT_DOUBLE_EQ(approximation.heatFlow1, loadedApproximation.heatFlow1);
+	BatchCase outside = runner.parseCase("0.08 0.004 1 390.5 0 0 0.093 0.2 286 2 1");
+	OutputData solved = loaded.evaluate(outside, 0.01, &isSolved);
+	EXPECT_TRUE(isSolved);
+	HeatTransferSolver outsideSolver{ outside.data, fluids.liquid(0), fluids.air() };
+	outsideSolver.runTheSolver(1e-6);
+	EXPECT_DOUBLE_EQ(outsideSolver.getResults()->heatFlow1, solved.heatFlow1);
+	loaded.evaluate(runner.parseCase("0.08 0.004 1 390.5 0 0 0.093 0.047 280 2 1"), 0.01, &isSolved);
+	EXPECT_TRUE(isSolved);
+	loaded.evaluate(query, 1e-9, &isSolved);
+	EXPECT_TRUE(isSolved);
+}
+
+TEST(ResultCache, findsAndEvictsLeastRecentlyUsed) {
+	FluidLibrary fluids;
+	BatchRunner runner{ fluids, BatchOptions{} };
+	BatchCase first = runner.parseCase("0.08 0.004 1 413 0 0 0.093 0.03 286 2 1");
+	BatchCase second = runner.parseCase("0.08 0.004 1 413 0 0 0.093 0.04 286 2 1");
+	BatchCase third = runner.parseCase("0.08 0.004 1 413 1 0 0.093 0.03 286 2 1");
+	ResultCache cache{ 2 * ResultCache::memoryOfEntry, 1 };
+	OutputData result{};
+	runner.solveCase(first, result);
+	EXPECT_FALSE(cache.find(ResultCache::makeKey(first), result));
+	cache.insert(ResultCache::makeKey(first), result);
+	cache.insert(ResultCache::makeKey(second), result);
+	OutputData found{};
+	ASSERT_TRUE(cache.find(ResultCache::makeKey(first), found));
+	EXPECT_DOUBLE_EQ(result.heatFlow1, found.heatFlow1);
+	cache.insert(ResultCache::makeKey(third), result);
+	EXPECT_FALSE(cache.find(ResultCache::makeKey(second), found));
+	EXPECT_TRUE(cache.find(ResultCache::makeKey(first), found));
+	EXPECT_TRUE(cache.find(ResultCache::makeKey(third), found));
+	CacheStatistics statistics = cache.getStatistics();
+	EXPECT_EQ(3u, statistics.hits);
+	EXPECT_EQ(2u, statistics.misses);
+	EXPECT_EQ(1u, statistics.evictions);
+	EXPECT_EQ(2u, statistics.quantityOfEntries);
+	BatchCase churchillChu = first;
+	churchillChu.data.typeOfNaturalConvection = 1;
+	EXPECT_FALSE(ResultCache::makeKey(churchillChu) == ResultCache::makeKey(first));
+	EXPECT_FALSE(ResultCache{ 0 }.isEnabled());
+}
+
+TEST(SolverStatistics, countedOnlyWithInstrumentation) {
+	FluidLibrary fluids;
+	BatchOptions options;
+	options.quantityOfThreads = 2;
+	BatchRunner runner{ fluids, options };
+	std::vector<BatchCase> cases(5, runner.parseCase("0.08 0.004 1 413 0 0 0.093 0.03 286 2 1"));
+	SolverStatistics statistics;
+	runner.solve(cases, &statistics);
+#ifdef HEAT_INSTRUMENTATION
+	EXPECT_EQ(5u, statistics.quantityOfSolves);
+	EXPECT_GT(statistics.rootIterations, 0u);
+	EXPECT_GE(statistics.maximumRootIterations * 5, statistics.rootIterations);
+	EXPECT_EQ(5u * 4, statistics.liquidPropertyLookups);
+	EXPECT_GT(statistics.regimeSelections[2], 0u);
+	EXPECT_NE(std::string::npos, statistics.toJson().find("\"quantityOfSolves\":5"));
+#else
+	EXPECT_EQ(0u, statistics.quantityOfSolves);
+	EXPECT_EQ(0u, statistics.residualEvaluations);
+#endif
+}
+
+TEST(TraceRecorder, writesEventsOfAllThreads) {
+	FluidLibrary fluids;
+	BatchOptions options;
+	options.quantityOfThreads = 2;
+	BatchRunner runner{ fluids, options };
+	std::vector<BatchCase> cases(4, runner.parseCase("0.08 0.004 1 413 0 0 0.093 0.03 286 2 1"));
+	runner.solve(cases);
+	EXPECT_FALSE(TraceRecorder::stop());
+	TraceRecorder::start("trace_test.json");
+	EXPECT_TRUE(TraceRecorder::isEnabled());
+	runner.solve(cases);
+	ASSERT_TRUE(TraceRecorder::stop());
+	EXPECT_FALSE(TraceRecorder::isEnabled());
+	std::ifstream file("trace_test.json");
+	std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	EXPECT_NE(std::string::npos, text.find("\"name\":\"solve batch\""));
+	EXPECT_NE(std::string::npos, text.find("\"name\":\"root finding\""));
+	EXPECT_NE(std::string::npos, text.find("\"tid\":2"));
+	EXPECT_EQ(std::string::npos, text.find("\"tid\":4"));
+	file.close();
+	std::remove("trace_test.json");
+}
+
+TEST(ScratchArena, reusesBufferAfterReset) {
+	ScratchArena arena{ 64 };
+	double *first = arena.allocateArray<double>(4);
+	EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(first) % alignof(double));
+	{
+		ScratchArena::Scope scope{ arena };
+		arena.allocateArray<double>(100);//the buffer is full, extra block is taken
+		EXPECT_LE(832u, arena.getUsedMemory());
+	}
+	EXPECT_EQ(32u, arena.getUsedMemory());
+	EXPECT_EQ(64u, arena.getCapacity());
+	arena.reset();
+	EXPECT_EQ(0u, arena.getUsedMemory());
+	EXPECT_LE(832u, arena.getCapacity());
+	size_t capacity = arena.getCapacity();
+	arena.allocateArray<double>(4);
+	arena.allocateArray<double>(100);
+	EXPECT_EQ(capacity, arena.getCapacity());
+	EXPECT_GE(capacity, arena.getUsedMemory());
+}
+
+#ifndef _WIN32
+TEST(CheckpointFile, resumesFromCommittedCases) {
+	FluidLibrary fluids;
+	BatchOptions options;
+	options.quantityOfThreads = 2;
+	BatchRunner runner{ fluids, options };
+	std::vector<BatchCase> cases;
+	for (int i = 0; i < 10; ++i) {
+		cases.push_back(runner.parseCase("0.08 0.004 1 " + std::to_string(380 + 5 * i) + " 0 0 0.093 0.03 286 2 1"));
+	}
+	std::vector<OutputData> expected = runner.solve(cases);
+	std::uint64_t fingerprint = CheckpointFile::getFingerprint(cases, options);
+	const std::string path = "checkpoint_test.bin";
+	{
+		CheckpointFile checkpoint{ path, cases.size(), fingerprint, false };
+		EXPECT_EQ(0u, checkpoint.getQuantityOfCommittedCases());
+		OutputData marked = expected[0];
+		marked.heatFlow1 = -1;//committed cases are not solved again
+		for (int i = 0; i < 4; ++i) {
+			checkpoint.setResult(i, i == 0 ? marked : expected[i]);
+		}
+		checkpoint.commit(4);
+		checkpoint.setResult(4, expected[4]);//not committed, the run is stopped
+	}
+	EXPECT_THROW(CheckpointFile(path, cases.size(), fingerprint + 1, true), std::runtime_error);
+	EXPECT_THROW(CheckpointFile(path, cases.size() + 1, fingerprint, true), std::runtime_error);
+	CheckpointFile checkpoint{ path, cases.size(), fingerprint, true };
+	EXPECT_EQ(4u, checkpoint.getQuantityOfCommittedCases());
+	checkpoint.quantityOfCasesInChunk = 2;
+	std::vector<OutputData> results = checkpoint.solve(runner, cases);
+	EXPECT_EQ(cases.size(), checkpoint.getQuantityOfCommittedCases());
+	EXPECT_EQ(-1, results[0].heatFlow1);
+	for (size_t i = 1; i < cases.size(); ++i) {
+		EXPECT_EQ(expected[i].heatFlow1, results[i].heatFlow1);
+		EXPECT_EQ(expected[i].temperatureOnIsolator, results[i].temperatureOnIsolator);
+		EXPECT_EQ(expected[i].status, results[i].status);
+	}
+	std::remove(path.c_str());
+}
+
+TEST(ShardedRunner, theSameAsThreads) {
+	FluidLibrary fluids;
+	BatchOptions options;
+	BatchRunner runner{ fluids, options };
+	std::vector<BatchCase> cases;
+	for (int i = 0; i < 10; ++i) {
+		cases.push_back(runner.parseCase("0.08 0.004 1 " + std::to_string(380 + 5 * i) + " " + std::to_string(i % 5)
+			+ " 0 0.093 0.03 286 2 1"));
+	}
+	std::vector<OutputData> expected = runner.solve(cases);
+	CheckpointFile results{ "", cases.size(), CheckpointFile::getFingerprint(cases, options), false };
+	results.quantityOfCasesInChunk = 3;
+	ShardedRunner sharded{ runner, results, 3 };
+	std::vector<OutputData> resultsOfProcesses = sharded.solve(cases);
+	EXPECT_EQ(cases.size(), results.getQuantityOfCommittedCases());
+	EXPECT_EQ(0u, sharded.getQuantityOfRepeatedChunks());
+	ASSERT_EQ(expected.size(), resultsOfProcesses.size());
+	for (size_t i = 0; i < cases.size(); ++i) {
+		EXPECT_EQ(expected[i].heatFlow2, resultsOfProcesses[i].heatFlow2);
+		EXPECT_EQ(expected[i].status, resultsOfProcesses[i].status);
+	}
+}
+
+TEST(ShardedRunner, stopsAfterAttemptsOfFailedChunk) {
+	FluidLibrary fluids;
+	BatchOptions options;
+	BatchRunner runner{ fluids, options };
+	std::vector<BatchCase> cases(10, runner.parseCase("0.08 0.004 1 413 0 0 0.093 0.03 286 2 1"));
+	cases[4].typeOfLiquid = FluidLibrary::quantityOfLiquids;//the worker throws std::out_of_range
+	CheckpointFile results{ "", cases.size(), CheckpointFile::getFingerprint(cases, options), false };
+	results.quantityOfCasesInChunk = 3;
+	ShardedRunner sharded{ runner, results, 2 };
+	EXPECT_THROW(sharded.solve(cases), std::runtime_error);
+	EXPECT_EQ(2u, sharded.getQuantityOfRepeatedChunks());
+	EXPECT_EQ(-1, waitpid(-1, nullptr, WNOHANG));//all workers were reaped
+	EXPECT_EQ(ECHILD, errno);
+}
+
+TEST(ResultRing, policiesOfFullRing) {
+	const std::string name = "/heat_test_ring_" + std::to_string(getpid());
+	OutputData result{};
+	result.heatFlow1 = 10;
+	StreamRecord record{};
+	{
+		ResultRing ring{ name, 3, RingPolicy::dropNewest };//rounded to 4
+		ResultRingReader reader{ name };
+		for (std::uint64_t i = 0; i < 6; ++i) {
+			EXPECT_EQ(i < 4, ring.publish(i, result));
+		}
+		EXPECT_EQ(2u, ring.getQuantityOfDroppedRecords());
+		for (std::uint64_t i = 0; i < 4; ++i) {
+			ASSERT_TRUE(reader.read(record));
+			EXPECT_EQ(i, record.caseId);
+			EXPECT_EQ(10, record.result.value[6]);//heat flow 1
+		}
+		EXPECT_FALSE(reader.read(record));
+		EXPECT_FALSE(reader.isFinished());
+		ring.close();
+		EXPECT_TRUE(reader.isFinished());
+	}
+	{
+		ResultRing ring{ name, 4, RingPolicy::overwriteOldest };
+		ResultRingReader reader{ name };
+		for (std::uint64_t i = 0; i < 6; ++i) {
+			EXPECT_TRUE(ring.publish(i, result));
+		}
+		ASSERT_TRUE(reader.read(record));
+		EXPECT_EQ(2u, record.caseId);
+		EXPECT_EQ(2u, reader.getQuantityOfLostRecords());
+	}
+	{
+		ResultRing ring{ name, 4, RingPolicy::block };
+		ResultRingReader reader{ name };
+		std::uint64_t sum = 0;
+		std::thread consumer{ [&reader, &record, &sum]() {
+			while (!reader.isFinished()) {
+				if (reader.read(record)) {
+					sum += record.caseId;
+				}
+				else {
+					std::this_thread::yield();
+				}
+			}
+		} };
+		for (std::uint64_t i = 0; i < 1000; ++i) {
+			ring.publish(i, result);
+		}
+		ring.close();
+		consumer.join();
+		EXPECT_EQ(999u * 1000 / 2, sum);
+		EXPECT_EQ(0u, reader.getQuantityOfLostRecords());
+	}
+	EXPECT_THROW(ResultRingReader{ name }, std::runtime_error);
+}
+
+TEST(ResultRing, readerWaitsForProducer) {
+	const std::string name = "/heat_test_ring_wait_" + std::to_string(getpid());
+	OutputData result{};
+	std::atomic<std::uint64_t> quantityOfRecords{ 0 };
+	std::thread consumer{ [&name, &quantityOfRecords]() {
+		ResultRingReader reader{ name, std::chrono::seconds(10) };
+		StreamRecord record{};
+		while (!reader.isFinished()) {
+			if (reader.read(record)) {
+				++quantityOfRecords;
+			}
+			else {
+				std::this_thread::yield();
+			}
+		}
+	} };
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+	{
+		ResultRing ring{ name, 4, RingPolicy::block };
+		while (ring.publish(0, result) && quantityOfRecords == 0) {//the consumer may register after the first records
+			std::this_thread::yield();
+		}
+		for (std::uint64_t i = 0; i < 100; ++i) {
+			ring.publish(i, result);
+		}
+		ring.close();
+		consumer.join();
+	}
+	EXPECT_GE(quantityOfRecords, 100u);
+	EXPECT_THROW(ResultRingReader(name, std::chrono::milliseconds(20)), std::runtime_error);
+}
+#endif
@@ -45,6 +45,7 @@ void XmlWriter::addCellData(const QString &text,const XmlDataType type){
  * \param fileName name of file
  */
 void XmlWriter::saveTableDataInFile(const QString &fileName){
+   HEAT_TRACE_SCOPE("export xml", "io");
    QFile file(fileName);
    if(!file.open(QIODevice::WriteOnly | QIODevice::Text)){
        QMessageBox::warning(nullptr, "Problem while saving", file.errorString());
@@ -6,6 +6,7 @@
 #include <QMessageBox>
 #include <QIODevice>
 #include <QTextStream>
+#include "TraceRecorder.h"
 /*!
  * \brief The XmlDataType enum
  * class stores types of xml data